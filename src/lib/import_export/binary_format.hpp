@@ -0,0 +1,42 @@
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <limits>
+
+namespace opossum {
+
+// The binary table format stores a table chunk by chunk in its in-memory representation, so that it can be read
+// without parsing or encoding. Integers are written in the byte order of the machine.
+//
+//   file:          magic, version (uint32), target chunk size (uint32), column count (uint16), chunk count (uint32),
+//                  column name and type (string each) per column, chunk, zone maps and invalid rows per chunk
+//   string:        length (uint32), characters
+//   chunk:         row count (uint32), segment per column
+//   zone maps:     1 (uint8), followed by the minimum and the maximum (value each) and the distinct count (uint64,
+//                  UNKNOWN_DISTINCT_COUNT if unknown) per column, or 0 if the chunk has no zone maps
+//   value:         the value itself, or a string for strings
+//   invalid rows:  offsets of the rows that are invalid in the chunk's validity bitmap (array of uint32)
+//   segment:       EncodingType (uint8), followed by
+//                    Unencoded:        values (value vector)
+//                    Dictionary:       dictionary (value vector, front-coded for strings), attribute vector
+//                    RunLength:        values (value vector), end positions (array)
+//                    FrameOfReference: block minima (array), offsets (bit-packed vector)
+//   value vector:  array of values, or for strings: characters (array), offsets (array of uint64)
+//   front-coded:   entries (value vector of strings), prefix lengths (array of uint8)
+//   attribute vector: width in bytes (uint8), followed by the value ids (array), or 0 for bit-packed vectors, followed
+//                     by the bit width (uint8), the number of value ids (uint64), and the words (array of uint64)
+//   array:         element count (uint64), padding to a multiple of ARRAY_ALIGNMENT, elements
+//
+// Arrays are aligned within the file, so that BinaryParser can use them in place from the mapped file.
+constexpr auto BINARY_FORMAT_MAGIC = std::array<char, 8>{'O', 'P', 'O', 'S', 'S', 'U', 'M', 'T'};
+constexpr auto BINARY_FORMAT_VERSION = uint32_t{3};
+constexpr auto ARRAY_ALIGNMENT = size_t{8};
+
+// Width that identifies bit-packed attribute vectors.
+constexpr auto BIT_PACKED_ATTRIBUTE_VECTOR = uint8_t{0};
+
+// Distinct count of zone maps that do not know the number of distinct values.
+constexpr auto UNKNOWN_DISTINCT_COUNT = std::numeric_limits<uint64_t>::max();
+
+}  // namespace opossum
@@ -0,0 +1,251 @@
+#include "binary_parser.hpp"
+
+#include <array>
+#include <cstring>
+#include <memory>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "binary_format.hpp"
+#include "resolve_type.hpp"
+#include "storage/bit_packed_integer_vector.hpp"
+#include "storage/chunk.hpp"
+#include "storage/dictionary_segment.hpp"
+#include "storage/fixed_width_integer_vector.hpp"
+#include "storage/frame_of_reference_segment.hpp"
+#include "storage/mappable_vector.hpp"
+#include "storage/run_length_segment.hpp"
+#include "storage/table.hpp"
+#include "storage/value_segment.hpp"
+#include "storage/zone_map.hpp"
+#include "utils/assert.hpp"
+#include "utils/mapped_file.hpp"
+
+namespace opossum {
+
+namespace {
+
+// Reads values from a memory-mapped file. Arrays are either copied or referenced in place as MappableVectors, which
+// keep the mapping alive.
+class BinaryInput {
+ public:
+  explicit BinaryInput(const std::string& file_name)
+      : _file_name{file_name}, _file{std::make_shared<MappedFile>(file_name)}, _contents{_file->contents()} {}
+
+  template <typename T>
+  T read_value() {
+    static_assert(std::is_trivially_copyable_v<T>, "Only trivially copyable values can be read.");
+    auto value = T{};
+    std::memcpy(&value, _read_bytes(sizeof(T)), sizeof(T));
+    return value;
+  }
+
+  std::string read_string() {
+    const auto size = read_value<uint32_t>();
+    return std::string{_read_bytes(size), size};
+  }
+
+  // Returns an array that references the mapped file.
+  template <typename T>
+  MappableVector<T> map_array() {
+    static_assert(std::is_trivially_copyable_v<T>, "Only trivially copyable values can be read.");
+    const auto size = read_value<uint64_t>();
+    _read_bytes((ARRAY_ALIGNMENT - _offset % ARRAY_ALIGNMENT) % ARRAY_ALIGNMENT);
+    Assert(size <= (_contents.size() - _offset) / sizeof(T), "Unexpected end of the binary table file " + _file_name);
+    const auto* data = reinterpret_cast<const T*>(_read_bytes(size * sizeof(T)));
+    return MappableVector<T>{data, size, _file};
+  }
+
+  // Returns a copy of an array.
+  template <typename T>
+  std::vector<T> read_array() {
+    const auto values = map_array<T>();
+    return std::vector<T>(values.cbegin(), values.cend());
+  }
+
+  StringHeap map_string_heap() {
+    auto characters = map_array<char>();
+    return StringHeap{std::move(characters), map_array<size_t>()};
+  }
+
+  StringHeap read_string_heap() {
+    auto characters = read_array<char>();
+    return StringHeap{std::move(characters), read_array<size_t>()};
+  }
+
+ protected:
+  const char* _read_bytes(const size_t size) {
+    Assert(size <= _contents.size() - _offset, "Unexpected end of the binary table file " + _file_name);
+    const auto* data = _contents.data() + _offset;
+    _offset += size;
+    return data;
+  }
+
+  const std::string _file_name;
+  const std::shared_ptr<const MappedFile> _file;
+  const std::string_view _contents;
+  size_t _offset{0};
+};
+
+template <typename T>
+ValueVector<T> read_value_vector(BinaryInput& input) {
+  if constexpr (std::is_same_v<T, std::string>) {
+    return input.read_string_heap();
+  } else {
+    return input.read_array<T>();
+  }
+}
+
+std::shared_ptr<BitPackedIntegerVector> read_bit_packed_vector(BinaryInput& input) {
+  const auto bit_width = input.read_value<uint8_t>();
+  const auto size = input.read_value<uint64_t>();
+  return std::make_shared<BitPackedIntegerVector>(bit_width, input.map_array<uint64_t>(), size);
+}
+
+std::shared_ptr<AbstractAttributeVector> read_attribute_vector(BinaryInput& input) {
+  const auto width = input.read_value<uint8_t>();
+  switch (width) {
+    case BIT_PACKED_ATTRIBUTE_VECTOR:
+      return read_bit_packed_vector(input);
+    case 1:
+      return std::make_shared<FixedWidthIntegerVector<uint8_t>>(input.map_array<uint8_t>());
+    case 2:
+      return std::make_shared<FixedWidthIntegerVector<uint16_t>>(input.map_array<uint16_t>());
+    case 4:
+      return std::make_shared<FixedWidthIntegerVector<uint32_t>>(input.map_array<uint32_t>());
+    default:
+      Fail("Unknown attribute vector width.");
+  }
+}
+
+template <typename T>
+std::shared_ptr<AbstractSegment> read_segment(BinaryInput& input) {
+  const auto encoding_type = static_cast<EncodingType>(input.read_value<uint8_t>());
+  switch (encoding_type) {
+    case EncodingType::Unencoded:
+      return std::make_shared<ValueSegment<T>>(read_value_vector<T>(input));
+    case EncodingType::Dictionary: {
+      auto dictionary = DictionaryVector<T>{};
+      if constexpr (std::is_same_v<T, std::string>) {
+        auto entries = input.map_string_heap();
+        dictionary = FrontCodedDictionary{std::move(entries), input.map_array<uint8_t>()};
+      } else {
+        dictionary = input.map_array<T>();
+      }
+      return std::make_shared<DictionarySegment<T>>(std::move(dictionary), read_attribute_vector(input));
+    }
+    case EncodingType::RunLength: {
+      auto values = std::vector<T>{};
+      if constexpr (std::is_same_v<T, std::string>) {
+        const auto heap = input.read_string_heap();
+        values.assign(heap.cbegin(), heap.cend());
+      } else {
+        values = input.read_array<T>();
+      }
+      return std::make_shared<RunLengthSegment<T>>(std::move(values), input.read_array<ChunkOffset>());
+    }
+    case EncodingType::FrameOfReference:
+      if constexpr (std::is_integral_v<T>) {
+        auto block_minima = input.read_array<T>();
+        return std::make_shared<FrameOfReferenceSegment<T>>(std::move(block_minima), read_bit_packed_vector(input));
+      }
+      Fail("Frame-of-reference segments are only supported for integer columns.");
+    default:
+      Fail("Unknown segment encoding.");
+  }
+}
+
+std::vector<std::shared_ptr<AbstractSegment>> read_chunk_segments(BinaryInput& input,
+                                                                  const std::vector<std::string>& column_types,
+                                                                  const std::string& file_name) {
+  const auto row_count = input.read_value<uint32_t>();
+  auto segments = std::vector<std::shared_ptr<AbstractSegment>>{};
+  segments.reserve(column_types.size());
+  for (const auto& column_type : column_types) {
+    resolve_data_type(column_type, [&](const auto data_type_t) {
+      using ColumnDataType = typename decltype(data_type_t)::type;
+      segments.push_back(read_segment<ColumnDataType>(input));
+      Assert(segments.back()->size() == row_count, "The segments of a chunk in " + file_name + " differ in size.");
+    });
+  }
+  return segments;
+}
+
+template <typename T>
+T read_typed_value(BinaryInput& input) {
+  if constexpr (std::is_same_v<T, std::string>) {
+    return input.read_string();
+  } else {
+    return input.read_value<T>();
+  }
+}
+
+// Restores the zone maps of a chunk, if they were written.
+void read_zone_maps(BinaryInput& input, Chunk& chunk, const std::vector<std::string>& column_types) {
+  if (input.read_value<uint8_t>() == 0) {
+    return;
+  }
+
+  auto zone_maps = std::vector<std::shared_ptr<BaseZoneMap>>{};
+  zone_maps.reserve(column_types.size());
+  for (const auto& column_type : column_types) {
+    resolve_data_type(column_type, [&](const auto data_type_t) {
+      using ColumnDataType = typename decltype(data_type_t)::type;
+      auto min = read_typed_value<ColumnDataType>(input);
+      auto max = read_typed_value<ColumnDataType>(input);
+      const auto distinct_count = input.read_value<uint64_t>();
+      zone_maps.push_back(std::make_shared<ZoneMap<ColumnDataType>>(
+          std::move(min), std::move(max),
+          distinct_count == UNKNOWN_DISTINCT_COUNT ? std::nullopt : std::optional<size_t>{distinct_count}));
+    });
+  }
+  chunk.set_zone_maps(std::move(zone_maps));
+}
+
+}  // namespace
+
+std::shared_ptr<Table> BinaryParser::parse(const std::string& file_name) {
+  auto input = BinaryInput{file_name};
+  const auto magic = input.read_value<std::remove_const_t<decltype(BINARY_FORMAT_MAGIC)>>();
+  Assert(magic == BINARY_FORMAT_MAGIC, file_name + " is not a binary table file.");
+  Assert(input.read_value<uint32_t>() == BINARY_FORMAT_VERSION, file_name + " has an unsupported format version.");
+
+  const auto target_chunk_size = input.read_value<uint32_t>();
+  const auto column_count = input.read_value<uint16_t>();
+  const auto chunk_count = input.read_value<uint32_t>();
+
+  auto table = std::make_shared<Table>(target_chunk_size);
+  auto column_types = std::vector<std::string>{};
+  for (auto column_id = ColumnID{0}; column_id < column_count; ++column_id) {
+    auto name = input.read_string();
+    column_types.push_back(input.read_string());
+    table->add_column(name, column_types.back());
+  }
+
+  for (auto chunk_id = ChunkID{0}; chunk_id < chunk_count; ++chunk_id) {
+    auto chunk = std::make_shared<Chunk>();
+    for (auto& segment : read_chunk_segments(input, column_types, file_name)) {
+      chunk->add_segment(std::move(segment));
+    }
+    read_zone_maps(input, *chunk, column_types);
+    const auto invalid_offsets = input.read_array<ChunkOffset>();
+    if (!invalid_offsets.empty()) {
+      chunk->invalidate_rows(invalid_offsets);
+    }
+    table->append_chunk(chunk, true);
+  }
+
+  return table;
+}
+
+std::vector<std::shared_ptr<AbstractSegment>> BinaryParser::parse_chunk(const std::string& file_name,
+                                                                         const std::vector<std::string>& column_types) {
+  auto input = BinaryInput{file_name};
+  return read_chunk_segments(input, column_types, file_name);
+}
+
+}  // namespace opossum
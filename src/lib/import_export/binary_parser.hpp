@@ -0,0 +1,30 @@
+#pragma once
+
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace opossum {
+
+class AbstractSegment;
+class Table;
+
+// Reads a table that was written by BinaryWriter. Segments are restored in the encoding they were written with, and
+// dictionaries and attribute vectors are read as they are, so no values are parsed or encoded.
+//
+// The file is memory-mapped. Dictionaries and attribute vectors (including the offsets of frame-of-reference segments)
+// are not copied but reference the mapping, which stays alive as long as any of them does. Their pages are read on
+// first access and can be evicted by the operating system. Other segments are copied, as they are small (run-length)
+// or not yet compressed.
+class BinaryParser {
+ public:
+  // Opens a table file without reading the values of its segments: zone maps are restored from the file, and the
+  // statistics of the table are created on the first call of Table::table_statistics() (see Table::append_chunk).
+  static std::shared_ptr<Table> parse(const std::string& file_name);
+
+  // Reads the segments of a chunk that was written by BinaryWriter::write_chunk.
+  static std::vector<std::shared_ptr<AbstractSegment>> parse_chunk(const std::string& file_name,
+                                                                   const std::vector<std::string>& column_types);
+};
+
+}  // namespace opossum
@@ -0,0 +1,285 @@
+#include "binary_writer.hpp"
+
+#include <fcntl.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <array>
+#include <filesystem>
+#include <fstream>
+#include <memory>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+#include "binary_format.hpp"
+#include "resolve_type.hpp"
+#include "storage/bit_packed_integer_vector.hpp"
+#include "storage/chunk.hpp"
+#include "storage/dictionary_segment.hpp"
+#include "storage/fixed_width_integer_vector.hpp"
+#include "storage/frame_of_reference_segment.hpp"
+#include "storage/resolve_attribute_vector.hpp"
+#include "storage/resolve_segment.hpp"
+#include "storage/run_length_segment.hpp"
+#include "storage/table.hpp"
+#include "storage/validity_bitmap.hpp"
+#include "storage/value_segment.hpp"
+#include "storage/zone_map.hpp"
+#include "utils/assert.hpp"
+
+namespace opossum {
+
+namespace {
+
+// Writes values to a file and keeps track of the offset, so that arrays can be aligned.
+class BinaryOutput {
+ public:
+  explicit BinaryOutput(const std::string& file_name) : _stream{file_name, std::ios::binary | std::ios::trunc} {
+    Assert(_stream.is_open(), "Could not open " + file_name + " for writing.");
+  }
+
+  template <typename T>
+  void write_value(const T value) {
+    static_assert(std::is_trivially_copyable_v<T>, "Only trivially copyable values can be written.");
+    _write_bytes(&value, sizeof(T));
+  }
+
+  void write_string(const std::string& value) {
+    write_value(static_cast<uint32_t>(value.size()));
+    _write_bytes(value.data(), value.size());
+  }
+
+  // Writes a std::vector or a MappableVector.
+  template <typename Values>
+  void write_array(const Values& values) {
+    write_array(values, values.size());
+  }
+
+  // Writes the first count values of a std::vector or a MappableVector.
+  template <typename Values>
+  void write_array(const Values& values, const size_t count) {
+    using T = typename Values::value_type;
+    static_assert(std::is_trivially_copyable_v<T>, "Only trivially copyable values can be written.");
+    write_value(static_cast<uint64_t>(count));
+    static constexpr auto padding = std::array<char, ARRAY_ALIGNMENT>{};
+    _write_bytes(padding.data(), (ARRAY_ALIGNMENT - _offset % ARRAY_ALIGNMENT) % ARRAY_ALIGNMENT);
+    _write_bytes(values.data(), count * sizeof(T));
+  }
+
+  void write_string_heap(const StringHeap& values) {
+    write_string_heap(values, values.size());
+  }
+
+  // Writes the first count strings of a heap.
+  void write_string_heap(const StringHeap& values, const size_t count) {
+    write_array(values.characters(), values.offsets()[count]);
+    write_array(values.offsets(), count + 1);
+  }
+
+  void close() {
+    _stream.close();
+    Assert(!_stream.fail(), "Could not write the binary table file.");
+  }
+
+ protected:
+  void _write_bytes(const void* data, const size_t size) {
+    _stream.write(static_cast<const char*>(data), static_cast<std::streamsize>(size));
+    _offset += size;
+  }
+
+  std::ofstream _stream;
+  size_t _offset{0};
+};
+
+static_assert(sizeof(size_t) == sizeof(uint64_t), "String heap offsets are written as uint64_t.");
+
+// Writes the first count values. Further values may be appended concurrently to the last chunk of a table.
+template <typename T>
+void write_value_vector(BinaryOutput& output, const ValueVector<T>& values, const size_t count) {
+  if constexpr (std::is_same_v<T, std::string>) {
+    output.write_string_heap(values, count);
+  } else {
+    output.write_array(values, count);
+  }
+}
+
+void write_attribute_vector(BinaryOutput& output, const AbstractAttributeVector& attribute_vector) {
+  resolve_attribute_vector(attribute_vector, [&](const auto& typed_attribute_vector) {
+    using AttributeVectorType = std::decay_t<decltype(typed_attribute_vector)>;
+    if constexpr (std::is_same_v<AttributeVectorType, BitPackedIntegerVector>) {
+      output.write_value(BIT_PACKED_ATTRIBUTE_VECTOR);
+      output.write_value(typed_attribute_vector.bit_width());
+      output.write_value(static_cast<uint64_t>(typed_attribute_vector.size()));
+      output.write_array(typed_attribute_vector.words());
+    } else {
+      output.write_value(static_cast<uint8_t>(typed_attribute_vector.width()));
+      output.write_array(typed_attribute_vector.values());
+    }
+  });
+}
+
+template <typename T>
+void write_segment(BinaryOutput& output, const AbstractSegment& segment, const ChunkOffset row_count) {
+  resolve_segment<T>(segment, [&](const auto& typed_segment) {
+    using SegmentType = std::decay_t<decltype(typed_segment)>;
+    if constexpr (std::is_same_v<SegmentType, ValueSegment<T>>) {
+      output.write_value(static_cast<uint8_t>(EncodingType::Unencoded));
+      write_value_vector<T>(output, typed_segment.values(), row_count);
+    } else if constexpr (std::is_same_v<SegmentType, DictionarySegment<T>>) {
+      output.write_value(static_cast<uint8_t>(EncodingType::Dictionary));
+      if constexpr (std::is_same_v<T, std::string>) {
+        output.write_string_heap(typed_segment.dictionary().entries());
+        output.write_array(typed_segment.dictionary().prefix_lengths());
+      } else {
+        output.write_array(typed_segment.dictionary());
+      }
+      write_attribute_vector(output, *typed_segment.attribute_vector());
+    } else if constexpr (std::is_same_v<SegmentType, RunLengthSegment<T>>) {
+      output.write_value(static_cast<uint8_t>(EncodingType::RunLength));
+      if constexpr (std::is_same_v<T, std::string>) {
+        auto values = StringHeap{};
+        for (const auto& value : typed_segment.values()) {
+          values.push_back(value);
+        }
+        output.write_string_heap(values);
+      } else {
+        output.write_array(typed_segment.values());
+      }
+      output.write_array(typed_segment.end_positions());
+    } else {
+      output.write_value(static_cast<uint8_t>(EncodingType::FrameOfReference));
+      output.write_array(typed_segment.block_minima());
+      const auto& offsets = *typed_segment.offsets();
+      output.write_value(offsets.bit_width());
+      output.write_value(static_cast<uint64_t>(offsets.size()));
+      output.write_array(offsets.words());
+    }
+  });
+}
+
+// Returns the number of written rows.
+ChunkOffset write_chunk_segments(BinaryOutput& output, const Chunk& chunk,
+                                 const std::vector<std::string>& column_types) {
+  // The size is read once, so that rows appended while the chunk is written are left out of all segments.
+  const auto row_count = chunk.size();
+  output.write_value(row_count);
+  for (auto column_id = ColumnID{0}; column_id < column_types.size(); ++column_id) {
+    resolve_data_type(column_types[column_id], [&](const auto data_type_t) {
+      using ColumnDataType = typename decltype(data_type_t)::type;
+      write_segment<ColumnDataType>(output, *chunk.get_segment(column_id), row_count);
+    });
+  }
+  return row_count;
+}
+
+template <typename T>
+void write_typed_value(BinaryOutput& output, const T& value) {
+  if constexpr (std::is_same_v<T, std::string>) {
+    output.write_string(value);
+  } else {
+    output.write_value(value);
+  }
+}
+
+// Writes the zone maps of a chunk, so that BinaryParser does not need to read all values to restore them.
+void write_zone_maps(BinaryOutput& output, const Chunk& chunk, const std::vector<std::string>& column_types) {
+  auto zone_maps = std::vector<std::shared_ptr<const BaseZoneMap>>{};
+  for (auto column_id = ColumnID{0}; column_id < column_types.size(); ++column_id) {
+    zone_maps.push_back(chunk.zone_map(column_id));
+  }
+  const auto has_zone_maps =
+      !zone_maps.empty() && std::all_of(zone_maps.cbegin(), zone_maps.cend(), [](const auto& zone_map) {
+        return static_cast<bool>(zone_map);
+      });
+  output.write_value(static_cast<uint8_t>(has_zone_maps));
+  if (!has_zone_maps) {
+    return;
+  }
+
+  for (auto column_id = ColumnID{0}; column_id < column_types.size(); ++column_id) {
+    resolve_data_type(column_types[column_id], [&](const auto data_type_t) {
+      using ColumnDataType = typename decltype(data_type_t)::type;
+      const auto& zone_map = static_cast<const ZoneMap<ColumnDataType>&>(*zone_maps[column_id]);
+      write_typed_value(output, zone_map.typed_min());
+      write_typed_value(output, zone_map.typed_max());
+      output.write_value(static_cast<uint64_t>(zone_map.distinct_count().value_or(UNKNOWN_DISTINCT_COUNT)));
+    });
+  }
+}
+
+// Writes the offsets of the invalid rows among the first row_count rows of a chunk, e.g., of deleted rows, so that
+// they stay deleted.
+void write_invalid_rows(BinaryOutput& output, const Chunk& chunk, const ChunkOffset row_count) {
+  auto invalid_offsets = std::vector<ChunkOffset>{};
+  if (const auto validity = chunk.validity()) {
+    for (auto chunk_offset = ChunkOffset{0}; chunk_offset < std::min(row_count, validity->size()); ++chunk_offset) {
+      if (!validity->is_valid(chunk_offset)) {
+        invalid_offsets.push_back(chunk_offset);
+      }
+    }
+  }
+  output.write_array(invalid_offsets);
+}
+
+// Flushes a file or directory to the disk.
+void sync_file(const std::string& file_name) {
+  const auto file_descriptor = open(file_name.c_str(), O_RDONLY);
+  Assert(file_descriptor >= 0, "Could not open " + file_name + " for syncing.");
+  const auto is_synced = fsync(file_descriptor) == 0;
+  close(file_descriptor);
+  Assert(is_synced, "Could not sync " + file_name);
+}
+
+}  // namespace
+
+void BinaryWriter::write(const Table& table, const std::string& file_name) {
+  const auto temporary_file_name = file_name + ".tmp";
+  auto output = BinaryOutput{temporary_file_name};
+
+  // Empty chunks, e.g., the last chunk of a table that was filled with Table::append_chunk, are skipped.
+  const auto chunks = table.chunks();
+  auto non_empty_chunks = std::vector<std::shared_ptr<const Chunk>>{};
+  for (const auto& chunk : *chunks) {
+    if (chunk->size() > 0) {
+      non_empty_chunks.push_back(chunk);
+    }
+  }
+
+  output.write_value(BINARY_FORMAT_MAGIC);
+  output.write_value(BINARY_FORMAT_VERSION);
+  output.write_value(table.target_chunk_size());
+  output.write_value(static_cast<uint16_t>(table.column_count()));
+  output.write_value(static_cast<uint32_t>(non_empty_chunks.size()));
+  auto column_types = std::vector<std::string>{};
+  for (auto column_id = ColumnID{0}; column_id < table.column_count(); ++column_id) {
+    output.write_string(table.column_name(column_id));
+    output.write_string(table.column_type(column_id));
+    column_types.push_back(table.column_type(column_id));
+  }
+
+  for (const auto& chunk : non_empty_chunks) {
+    const auto row_count = write_chunk_segments(output, *chunk, column_types);
+    write_zone_maps(output, *chunk, column_types);
+    write_invalid_rows(output, *chunk, row_count);
+  }
+
+  // The file is synced before it replaces a previous one, and the directory after, so that the rename cannot reach the
+  // disk before the contents, and the file is durable once this returns.
+  output.close();
+  sync_file(temporary_file_name);
+  std::filesystem::rename(temporary_file_name, file_name);
+  const auto directory = std::filesystem::path{file_name}.parent_path();
+  sync_file(directory.empty() ? "." : directory.string());
+}
+
+void BinaryWriter::write_chunk(const Chunk& chunk, const std::vector<std::string>& column_types,
+                               const std::string& file_name) {
+  const auto temporary_file_name = file_name + ".tmp";
+  auto output = BinaryOutput{temporary_file_name};
+  write_chunk_segments(output, chunk, column_types);
+  output.close();
+  std::filesystem::rename(temporary_file_name, file_name);
+}
+
+}  // namespace opossum
@@ -0,0 +1,26 @@
+#pragma once
+
+#include <string>
+#include <vector>
+
+namespace opossum {
+
+class Chunk;
+class Table;
+
+// Writes a table in the binary table format (see binary_format.hpp). Segments are written in their current encoding,
+// so that BinaryParser can restore them without encoding them again.
+class BinaryWriter {
+ public:
+  // Writes the table to the given file. The file is written under a temporary name, synced, and renamed once it is
+  // complete, after which its directory is synced. Thus, a crash never leaves a partially written file behind, and
+  // the file is durable once this returns, e.g., before Table::checkpoint truncates the write-ahead log.
+  static void write(const Table& table, const std::string& file_name);
+
+  // Writes only the segments of a chunk, whose columns have the given types, e.g., to evict it from memory. Like
+  // write(), the file is renamed once it is complete. It is not synced, as spill files do not outlive the process.
+  static void write_chunk(const Chunk& chunk, const std::vector<std::string>& column_types,
+                          const std::string& file_name);
+};
+
+}  // namespace opossum
@@ -0,0 +1,318 @@
+#include "table_scan.hpp"
+
+#include <algorithm>
+#include <future>
+#include <memory>
+#include <optional>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+#include "resolve_type.hpp"
+#include "storage/chunk.hpp"
+#include "storage/reference_segment.hpp"
+#include "storage/resolve_attribute_vector.hpp"
+#include "storage/resolve_segment.hpp"
+#include "storage/table.hpp"
+#include "storage/validity_bitmap.hpp"
+#include "type_cast.hpp"
+#include "utils/assert.hpp"
+#include "utils/thread_pool.hpp"
+#include "utils/with_comparator.hpp"
+
+namespace opossum {
+
+namespace {
+
+// Bit-packed attribute vectors are decoded in blocks of this many value ids, which stay in the L1 cache.
+constexpr auto DECODE_BLOCK_SIZE = size_t{1024};
+
+// The value ids that satisfy a predicate on a dictionary-encoded segment. As the dictionary is sorted, these form the
+// range [begin, end), or, for OpNotEquals, all value ids outside of it.
+struct ValueIDRange {
+  ValueID::base_type begin;
+  ValueID::base_type end;
+  bool is_negated;
+  ValueID::base_type dictionary_size;
+
+  bool matches_none() const { return is_negated ? begin == 0 && end == dictionary_size : begin >= end; }
+
+  bool matches_all() const { return is_negated ? begin >= end : begin == 0 && end == dictionary_size; }
+
+  // A single unsigned comparison tells whether the value id lies in the range, as value ids below begin wrap around.
+  bool contains(const ValueID value_id) const {
+    return (static_cast<ValueID::base_type>(value_id) - begin < end - begin) != is_negated;
+  }
+};
+
+template <typename T>
+ValueIDRange value_id_range(const DictionarySegment<T>& segment, const ScanType scan_type, const T& search_value) {
+  const auto dictionary_size = static_cast<ValueID::base_type>(segment.unique_values_count());
+  // INVALID_VALUE_ID stands for a search value beyond the largest value of the dictionary.
+  const auto bound = [&](const ValueID value_id) {
+    return value_id == INVALID_VALUE_ID ? dictionary_size : static_cast<ValueID::base_type>(value_id);
+  };
+  const auto lower_bound = bound(segment.lower_bound(search_value));
+  const auto upper_bound = bound(segment.upper_bound(search_value));
+
+  switch (scan_type) {
+    case ScanType::OpEquals:
+      return {lower_bound, upper_bound, false, dictionary_size};
+    case ScanType::OpNotEquals:
+      return {lower_bound, upper_bound, true, dictionary_size};
+    case ScanType::OpLessThan:
+      return {0, lower_bound, false, dictionary_size};
+    case ScanType::OpLessThanEquals:
+      return {0, upper_bound, false, dictionary_size};
+    case ScanType::OpGreaterThan:
+      return {upper_bound, dictionary_size, false, dictionary_size};
+    case ScanType::OpGreaterThanEquals:
+      return {lower_bound, dictionary_size, false, dictionary_size};
+  }
+  Fail("Unsupported scan type.");
+}
+
+// Appends the positions of all rows whose value id lies in the range, which neither matches all nor no value ids.
+void scan_attribute_vector(const AbstractAttributeVector& attribute_vector, const ValueIDRange& range,
+                           const ChunkID chunk_id, PosList& matches) {
+  const auto size = attribute_vector.size();
+  resolve_attribute_vector(attribute_vector, [&](const auto& typed_attribute_vector) {
+    using AttributeVectorType = std::decay_t<decltype(typed_attribute_vector)>;
+    if constexpr (std::is_same_v<AttributeVectorType, BitPackedIntegerVector>) {
+      auto value_ids = std::vector<ValueID>(DECODE_BLOCK_SIZE);
+      for (auto block_begin = size_t{0}; block_begin < size; block_begin += DECODE_BLOCK_SIZE) {
+        const auto block_end = std::min(block_begin + DECODE_BLOCK_SIZE, size);
+        typed_attribute_vector.decode(block_begin, block_end, value_ids.data());
+        for (auto index = block_begin; index < block_end; ++index) {
+          if (range.contains(value_ids[index - block_begin])) {
+            matches.push_back(RowID{chunk_id, static_cast<ChunkOffset>(index)});
+          }
+        }
+      }
+    } else {
+      // The range is not empty and does not cover all value ids, so its bounds are representable in the width of the
+      // vector, and the value ids are compared without widening them.
+      const auto& value_ids = typed_attribute_vector.values();
+      using StoredValueID = std::decay_t<decltype(value_ids[0])>;
+      const auto begin = static_cast<StoredValueID>(range.begin);
+      const auto width = static_cast<StoredValueID>(range.end - range.begin);
+      for (auto index = size_t{0}; index < size; ++index) {
+        if ((static_cast<StoredValueID>(value_ids[index] - begin) < width) != range.is_negated) {
+          matches.push_back(RowID{chunk_id, static_cast<ChunkOffset>(index)});
+        }
+      }
+    }
+  });
+}
+
+// Appends the positions of all valid rows of a chunk.
+void add_valid_positions(const ChunkID chunk_id, const ChunkOffset chunk_size, const ValidityBitmap* validity,
+                         PosList& matches) {
+  const auto add_match = [&](const ChunkOffset chunk_offset) { matches.push_back(RowID{chunk_id, chunk_offset}); };
+  if (validity) {
+    validity->for_each_valid(0, chunk_size, add_match);
+    return;
+  }
+  matches.reserve(matches.size() + chunk_size);
+  for (auto chunk_offset = ChunkOffset{0}; chunk_offset < chunk_size; ++chunk_offset) {
+    add_match(chunk_offset);
+  }
+}
+
+}  // namespace
+
+TableScan::TableScan(const std::shared_ptr<const AbstractOperator>& in, const ColumnID column_id,
+                     const ScanType scan_type, const AllTypeVariant search_value)
+    : AbstractOperator(in), _column_id{column_id}, _scan_type{scan_type}, _search_value{search_value} {}
+
+ColumnID TableScan::column_id() const { return _column_id; }
+
+ScanType TableScan::scan_type() const { return _scan_type; }
+
+const AllTypeVariant& TableScan::search_value() const { return _search_value; }
+
+std::shared_ptr<const Table> TableScan::_on_execute() {
+  const auto input_table = _left_input_table();
+  // The positions refer to this snapshot, as the table may be reorganized while the output is in use (see
+  // ReferenceSegment). The version is read first, so that it is outdated rather than too new.
+  const auto layout_version = input_table->layout_version();
+  const auto chunks = input_table->chunks();
+  const auto& column_type = input_table->column_type(_column_id);
+
+  // Each chunk is scanned as a task of its own.
+  auto& thread_pool = ThreadPool::get();
+  auto tasks = std::vector<std::future<std::shared_ptr<const PosList>>>{};
+  for (auto chunk_id = ChunkID{0}; chunk_id < chunks->size(); ++chunk_id) {
+    tasks.push_back(thread_pool.submit([&, chunk_id]() -> std::shared_ptr<const PosList> {
+      const auto& chunk = *(*chunks)[chunk_id];
+      if (chunk.size() == 0) {
+        return std::make_shared<PosList>();
+      }
+      if (const auto reference_segment = std::dynamic_pointer_cast<const ReferenceSegment>(
+              chunk.get_segment(_column_id))) {
+        return _scan_reference_segment(*reference_segment, column_type);
+      }
+      return _scan_chunk(chunk_id, chunk, column_type);
+    }));
+  }
+  for (const auto& task : tasks) {
+    thread_pool.wait(task);
+  }
+
+  auto output_table = std::make_shared<Table>(input_table->target_chunk_size());
+  for (auto column_id = ColumnID{0}; column_id < input_table->column_count(); ++column_id) {
+    output_table->add_column_definition(input_table->column_name(column_id), input_table->column_type(column_id));
+  }
+
+  // The output references the rows that hold the data. Thus, segments that already reference another table pass on
+  // their referenced table and column.
+  const auto add_output_chunk = [&](const ChunkID chunk_id, const std::shared_ptr<const PosList>& positions) {
+    auto output_chunk = std::make_shared<Chunk>();
+    for (auto column_id = ColumnID{0}; column_id < input_table->column_count(); ++column_id) {
+      const auto reference_segment =
+          std::dynamic_pointer_cast<const ReferenceSegment>((*chunks)[chunk_id]->get_segment(column_id));
+      if (reference_segment) {
+        output_chunk->add_segment(std::make_shared<ReferenceSegment>(
+            reference_segment->referenced_table(), reference_segment->referenced_column_id(), positions,
+            reference_segment->referenced_chunks(), reference_segment->layout_version()));
+      } else {
+        output_chunk->add_segment(
+            std::make_shared<ReferenceSegment>(input_table, column_id, positions, chunks, layout_version));
+      }
+    }
+    output_table->emplace_chunk(output_chunk);
+  };
+
+  auto empty_result_chunk_id = std::optional<ChunkID>{};
+  for (auto chunk_id = ChunkID{0}; chunk_id < chunks->size(); ++chunk_id) {
+    const auto positions = tasks[chunk_id].get();
+    if (!positions->empty()) {
+      add_output_chunk(chunk_id, positions);
+    } else if ((*chunks)[chunk_id]->column_count() == input_table->column_count()) {
+      empty_result_chunk_id = chunk_id;
+    }
+  }
+
+  // An empty result still has a chunk with one segment per column.
+  if (output_table->row_count() == 0 && empty_result_chunk_id) {
+    add_output_chunk(*empty_result_chunk_id, std::make_shared<PosList>());
+  }
+  return output_table;
+}
+
+std::shared_ptr<const PosList> TableScan::_scan_chunk(const ChunkID chunk_id, const Chunk& chunk,
+                                                      const std::string& column_type) const {
+  auto matches = std::make_shared<PosList>();
+  if (chunk.can_prune(_column_id, _scan_type, _search_value)) {
+    return matches;
+  }
+
+  const auto validity = chunk.validity();
+  resolve_data_type(column_type, [&](const auto data_type_t) {
+    using ColumnDataType = typename decltype(data_type_t)::type;
+    const auto search_value = type_cast<ColumnDataType>(_search_value);
+
+    resolve_segment<ColumnDataType>(*chunk.get_segment(_column_id), [&](const auto& typed_segment) {
+      using SegmentType = std::decay_t<decltype(typed_segment)>;
+      if constexpr (std::is_same_v<SegmentType, ValueSegment<ColumnDataType>>) {
+        const auto& values = typed_segment.values();
+        const auto size = typed_segment.size();
+        with_comparator(_scan_type, [&](auto comparator) {
+          for (auto chunk_offset = ChunkOffset{0}; chunk_offset < size; ++chunk_offset) {
+            if (comparator(values[chunk_offset], search_value)) {
+              matches->push_back(RowID{chunk_id, chunk_offset});
+            }
+          }
+        });
+        if (validity) {
+          validity->remove_invalid(*matches);
+        }
+      } else if constexpr (std::is_same_v<SegmentType, DictionarySegment<ColumnDataType>>) {
+        // The search value is looked up once, and whole segments are accepted or rejected without a scan if possible.
+        const auto range = value_id_range(typed_segment, _scan_type, search_value);
+        if (range.matches_none()) {
+          return;
+        }
+        if (range.matches_all()) {
+          add_valid_positions(chunk_id, typed_segment.size(), validity.get(), *matches);
+          return;
+        }
+        scan_attribute_vector(*typed_segment.attribute_vector(), range, chunk_id, *matches);
+        if (validity) {
+          validity->remove_invalid(*matches);
+        }
+      } else {
+        typed_segment.scan(_scan_type, search_value, chunk_id, *matches, validity.get());
+      }
+    });
+  });
+  return matches;
+}
+
+std::shared_ptr<const PosList> TableScan::_scan_reference_segment(const ReferenceSegment& segment,
+                                                                  const std::string& column_type) const {
+  auto matches = std::make_shared<PosList>();
+  const auto& referenced_chunks = *segment.referenced_chunks();
+  const auto& positions = *segment.pos_list();
+  const auto position_count = positions.size();
+
+  resolve_data_type(column_type, [&](const auto data_type_t) {
+    using ColumnDataType = typename decltype(data_type_t)::type;
+    const auto search_value = type_cast<ColumnDataType>(_search_value);
+
+    // Positions are processed in runs that reference the same chunk, so that each referenced segment is resolved and
+    // each search value is looked up in a dictionary only once per run.
+    auto run_end = size_t{0};
+    for (auto run_begin = size_t{0}; run_begin < position_count; run_begin = run_end) {
+      const auto chunk_id = positions[run_begin].chunk_id;
+      run_end = run_begin + 1;
+      while (run_end < position_count && positions[run_end].chunk_id == chunk_id) {
+        ++run_end;
+      }
+
+      const auto& referenced_chunk = referenced_chunks.at(chunk_id);
+      if (referenced_chunk->can_prune(segment.referenced_column_id(), _scan_type, _search_value)) {
+        continue;
+      }
+
+      // Rows that were deleted since the positions were determined are skipped.
+      const auto validity = referenced_chunk->validity();
+      const auto add_matches = [&](const auto& predicate) {
+        for (auto index = run_begin; index < run_end; ++index) {
+          const auto& row_id = positions[index];
+          if ((!validity || validity->is_valid(row_id.chunk_offset)) && predicate(row_id.chunk_offset)) {
+            matches->push_back(row_id);
+          }
+        }
+      };
+
+      const auto referenced_segment = referenced_chunk->get_segment(segment.referenced_column_id());
+      resolve_segment<ColumnDataType>(*referenced_segment, [&](const auto& typed_segment) {
+        using SegmentType = std::decay_t<decltype(typed_segment)>;
+        if constexpr (std::is_same_v<SegmentType, DictionarySegment<ColumnDataType>>) {
+          const auto range = value_id_range(typed_segment, _scan_type, search_value);
+          if (range.matches_none()) {
+            return;
+          }
+          if (range.matches_all()) {
+            add_matches([](const ChunkOffset) { return true; });
+            return;
+          }
+          resolve_attribute_vector(*typed_segment.attribute_vector(), [&](const auto& attribute_vector) {
+            add_matches(
+                [&](const ChunkOffset chunk_offset) { return range.contains(attribute_vector.get(chunk_offset)); });
+          });
+        } else {
+          with_comparator(_scan_type, [&](auto comparator) {
+            add_matches([&](const ChunkOffset chunk_offset) {
+              return comparator(typed_segment.get(chunk_offset), search_value);
+            });
+          });
+        }
+      });
+    }
+  });
+  return matches;
+}
+
+}  // namespace opossum
@@ -12,36 +12,45 @@
 
 namespace opossum {
 
-class BaseTableScanImpl;
+class Chunk;
+class ReferenceSegment;
 class Table;
 
+// TableScan selects the rows of its input for which "column <scan_type> search_value" holds. The output consists of
+// ReferenceSegments, which reference the rows of the table that holds the data, also if the input consists of
+// ReferenceSegments itself. The positions refer to the snapshot of the table's chunks that was scanned, so the output
+// stays valid if the table is reorganized later (see ReferenceSegment).
+//
+// Chunks are scanned in parallel on the ThreadPool. Chunks whose zone map rules out a match are skipped, and invalid
+// (deleted) rows are not part of the output. The scan works on the encoded data: For DictionarySegments, the search
+// value is translated once into a range of value ids, so that the attribute vector is scanned by comparing integers
+// of its width, and segments are accepted or rejected as a whole if the range covers all value ids or none.
+// RunLengthSegments and FrameOfReferenceSegments are scanned by their own scan methods.
 class TableScan : public AbstractOperator {
  public:
   TableScan(const std::shared_ptr<const AbstractOperator>& in, const ColumnID column_id, const ScanType scan_type,
-            const AllTypeVariant search_value) {
-    // TODO(student) implement it in a source file and change this to a declaration.
-  }
+            const AllTypeVariant search_value);
 
-  ColumnID column_id() const {
-    // TODO(student) implement it in a source file and change this to a declaration.
-    return ColumnID{};
-  }
+  ColumnID column_id() const;
 
-  ScanType scan_type() const {
-    // TODO(student) implement it in a source file and change this to a declaration.
-    Fail("Implementation missing.");
-  }
+  ScanType scan_type() const;
 
-  const AllTypeVariant& search_value() const {
-    // TODO(student) implement it in a source file and change this to a declaration.
-    Fail("Implementation missing.");
-  }
+  const AllTypeVariant& search_value() const;
 
  protected:
-  std::shared_ptr<const Table> _on_execute() override {
-    // TODO(student) implement it in a source file and change this to a declaration.
-    Fail("Implementation missing.");
-  }
+  std::shared_ptr<const Table> _on_execute() override;
+
+  // Returns the positions of the matching rows of a chunk of the input table, which holds data.
+  std::shared_ptr<const PosList> _scan_chunk(const ChunkID chunk_id, const Chunk& chunk,
+                                             const std::string& column_type) const;
+
+  // Returns the positions of the matching rows that a segment references.
+  std::shared_ptr<const PosList> _scan_reference_segment(const ReferenceSegment& segment,
+                                                         const std::string& column_type) const;
+
+  const ColumnID _column_id;
+  const ScanType _scan_type;
+  const AllTypeVariant _search_value;
 };
 
 }  // namespace opossum
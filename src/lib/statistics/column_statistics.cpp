@@ -0,0 +1,88 @@
+#include "column_statistics.hpp"
+
+#include <algorithm>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "resolve_type.hpp"
+#include "storage/resolve_segment.hpp"
+#include "type_cast.hpp"
+
+namespace opossum {
+
+float BaseColumnStatistics::null_fraction() const { return 0.0f; }
+
+template <typename T>
+std::shared_ptr<const BaseColumnStatistics> ColumnStatistics<T>::with_segment(
+    const std::shared_ptr<AbstractSegment>& segment) const {
+  auto values = std::vector<T>{};
+  values.reserve(segment->size());
+  resolve_segment<T>(*segment, [&](const auto& typed_segment) {
+    const auto segment_size = typed_segment.size();
+    for (auto chunk_offset = ChunkOffset{0}; chunk_offset < segment_size; ++chunk_offset) {
+      values.push_back(typed_segment.get(chunk_offset));
+    }
+  });
+  std::sort(values.begin(), values.end());
+
+  auto statistics = std::make_shared<ColumnStatistics<T>>();
+  statistics->_histogram = _histogram;
+
+  // The segment's values are summarized in a sketch of their own, which is merged into the sketch of the column.
+  auto segment_sketch = DistinctCountSketch{};
+  for (auto index = size_t{0}; index < values.size(); ++index) {
+    if (index == 0 || values[index] != values[index - 1]) {
+      segment_sketch.add(values[index]);
+    }
+  }
+  statistics->_distinct_count_sketch = _distinct_count_sketch;
+  statistics->_distinct_count_sketch.merge(segment_sketch);
+
+  if (!values.empty()) {
+    const auto segment_histogram = EquiDepthHistogram<T>::from_sorted_values(values, HISTOGRAM_BIN_COUNT);
+    statistics->_histogram = _histogram
+                                 ? EquiDepthHistogram<T>::merge({_histogram, segment_histogram}, HISTOGRAM_BIN_COUNT)
+                                 : segment_histogram;
+  }
+
+  return statistics;
+}
+
+template <typename T>
+size_t ColumnStatistics<T>::row_count() const {
+  return _histogram ? _histogram->total_count() : 0;
+}
+
+template <typename T>
+size_t ColumnStatistics<T>::distinct_count() const {
+  return _distinct_count_sketch.estimate();
+}
+
+template <typename T>
+float ColumnStatistics<T>::estimate_selectivity(const ScanType scan_type, const AllTypeVariant& search_value) const {
+  if (!_histogram || _histogram->total_count() == 0) {
+    return 0.0f;
+  }
+  const auto cardinality = _histogram->estimate_cardinality(scan_type, type_cast<T>(search_value), distinct_count());
+  return cardinality / static_cast<float>(_histogram->total_count());
+}
+
+template <typename T>
+std::shared_ptr<const EquiDepthHistogram<T>> ColumnStatistics<T>::histogram() const {
+  return _histogram;
+}
+
+EXPLICITLY_INSTANTIATE_DATA_TYPES(ColumnStatistics);
+
+std::shared_ptr<const BaseColumnStatistics> create_column_statistics(const std::string& column_type) {
+  auto statistics = std::shared_ptr<const BaseColumnStatistics>{};
+  resolve_data_type(column_type, [&](const auto data_type_t) {
+    using ColumnDataType = typename decltype(data_type_t)::type;
+    statistics = std::make_shared<ColumnStatistics<ColumnDataType>>();
+  });
+  return statistics;
+}
+
+}  // namespace opossum
@@ -0,0 +1,67 @@
+#pragma once
+
+#include <memory>
+#include <vector>
+
+#include "all_type_variant.hpp"
+#include "distinct_count_sketch.hpp"
+#include "equi_depth_histogram.hpp"
+#include "types.hpp"
+
+namespace opossum {
+
+class AbstractSegment;
+
+// Statistics of a column, covering the segments of all chunks that were added so far. Column statistics are immutable
+// so that they can be read while new chunks are added. Adding a segment returns updated statistics.
+class BaseColumnStatistics : private Noncopyable {
+ public:
+  virtual ~BaseColumnStatistics() = default;
+
+  // Returns statistics that additionally cover the given segment.
+  virtual std::shared_ptr<const BaseColumnStatistics> with_segment(
+      const std::shared_ptr<AbstractSegment>& segment) const = 0;
+
+  // Returns the number of rows covered by the statistics.
+  virtual size_t row_count() const = 0;
+
+  // Returns the estimated number of distinct values.
+  virtual size_t distinct_count() const = 0;
+
+  // Returns the fraction of NULL values. Segments cannot hold NULLs yet, so this is always zero.
+  float null_fraction() const;
+
+  // Estimates the fraction of rows that satisfy "value <scan_type> search_value".
+  virtual float estimate_selectivity(const ScanType scan_type, const AllTypeVariant& search_value) const = 0;
+};
+
+template <typename T>
+class ColumnStatistics : public BaseColumnStatistics {
+ public:
+  // Number of bins of the histograms of each segment and of the column.
+  static constexpr auto HISTOGRAM_BIN_COUNT = size_t{64};
+
+  // Creates statistics that do not cover any rows.
+  ColumnStatistics() = default;
+
+  std::shared_ptr<const BaseColumnStatistics> with_segment(
+      const std::shared_ptr<AbstractSegment>& segment) const final;
+
+  size_t row_count() const final;
+  size_t distinct_count() const final;
+  float estimate_selectivity(const ScanType scan_type, const AllTypeVariant& search_value) const final;
+
+  // Returns the histogram of the column, or nullptr if no rows are covered.
+  std::shared_ptr<const EquiDepthHistogram<T>> histogram() const;
+
+ protected:
+  // When a segment is added, its histogram and distinct count sketch are merged into those of the column, so that adding
+  // a segment does not become more expensive the more segments were added before.
+  std::shared_ptr<const EquiDepthHistogram<T>> _histogram{};
+  DistinctCountSketch _distinct_count_sketch{};
+};
+
+// Creates empty statistics for a column of the given type.
+std::shared_ptr<const BaseColumnStatistics> create_column_statistics(const std::string& column_type);
+
+}  // namespace opossum
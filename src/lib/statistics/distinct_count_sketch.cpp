@@ -0,0 +1,53 @@
+#include "distinct_count_sketch.hpp"
+
+#include <cmath>
+#include <iterator>
+#include <limits>
+
+namespace opossum {
+
+void DistinctCountSketch::_add_hash(const size_t hash) {
+  // std::hash is the identity for integers on common platforms, so the hash is scrambled (splitmix64 finalizer) to be
+  // uniformly distributed.
+  auto mixed_hash = static_cast<uint64_t>(hash);
+  mixed_hash = (mixed_hash ^ (mixed_hash >> 30)) * uint64_t{0xbf58476d1ce4e5b9};
+  mixed_hash = (mixed_hash ^ (mixed_hash >> 27)) * uint64_t{0x94d049bb133111eb};
+  mixed_hash ^= mixed_hash >> 31;
+
+  if (_smallest_hashes.size() == SKETCH_SIZE) {
+    if (mixed_hash >= *_smallest_hashes.rbegin()) {
+      return;
+    }
+    if (!_smallest_hashes.insert(mixed_hash).second) {
+      return;
+    }
+    _smallest_hashes.erase(std::prev(_smallest_hashes.end()));
+    return;
+  }
+  _smallest_hashes.insert(mixed_hash);
+}
+
+void DistinctCountSketch::merge(const DistinctCountSketch& other) {
+  // the hashes of the other sketch are already scrambled
+  for (const auto hash : other._smallest_hashes) {
+    if (_smallest_hashes.size() == SKETCH_SIZE && hash >= *_smallest_hashes.rbegin()) {
+      break;
+    }
+    if (_smallest_hashes.insert(hash).second && _smallest_hashes.size() > SKETCH_SIZE) {
+      _smallest_hashes.erase(std::prev(_smallest_hashes.end()));
+    }
+  }
+}
+
+size_t DistinctCountSketch::estimate() const {
+  if (_smallest_hashes.size() < SKETCH_SIZE) {
+    return _smallest_hashes.size();
+  }
+
+  // The k-th smallest of n uniformly distributed hashes is expected at k / n of the hash range.
+  const auto largest_hash_share =
+      static_cast<double>(*_smallest_hashes.rbegin()) / static_cast<double>(std::numeric_limits<uint64_t>::max());
+  return static_cast<size_t>(std::round(static_cast<double>(SKETCH_SIZE - 1) / largest_hash_share));
+}
+
+}  // namespace opossum
@@ -0,0 +1,33 @@
+#pragma once
+
+#include <cstdint>
+#include <functional>
+#include <set>
+
+namespace opossum {
+
+// DistinctCountSketch estimates the number of distinct values with the k-minimum-values (KMV) algorithm: It keeps the
+// SKETCH_SIZE smallest hashes of all added values. The smaller the largest of them, the more distinct values were
+// added. Sketches of several chunks can be merged without looking at the values again.
+class DistinctCountSketch {
+ public:
+  static constexpr auto SKETCH_SIZE = size_t{1024};
+
+  template <typename T>
+  void add(const T& value) {
+    _add_hash(std::hash<T>{}(value));
+  }
+
+  // Adds all hashes of another sketch, as if its values had been added to this sketch.
+  void merge(const DistinctCountSketch& other);
+
+  // Returns the estimated number of distinct values. Up to SKETCH_SIZE distinct values, the result is exact.
+  size_t estimate() const;
+
+ protected:
+  void _add_hash(const size_t hash);
+
+  std::set<uint64_t> _smallest_hashes{};
+};
+
+}  // namespace opossum
@@ -0,0 +1,179 @@
+#include "equi_depth_histogram.hpp"
+
+#include <algorithm>
+#include <memory>
+#include <numeric>
+#include <string>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "all_type_variant.hpp"
+#include "utils/assert.hpp"
+
+namespace opossum {
+
+template <typename T>
+EquiDepthHistogram<T>::EquiDepthHistogram(std::vector<T> bin_minima, std::vector<T> bin_maxima,
+                                          std::vector<size_t> bin_heights)
+    : _bin_minima{std::move(bin_minima)},
+      _bin_maxima{std::move(bin_maxima)},
+      _bin_heights{std::move(bin_heights)},
+      _total_count{std::accumulate(_bin_heights.cbegin(), _bin_heights.cend(), size_t{0})} {
+  Assert(_bin_minima.size() == _bin_maxima.size() && _bin_minima.size() == _bin_heights.size(),
+         "Each bin needs a minimum, a maximum, and a height.");
+}
+
+template <typename T>
+std::shared_ptr<EquiDepthHistogram<T>> EquiDepthHistogram<T>::from_sorted_values(const std::vector<T>& sorted_values,
+                                                                                 const size_t bin_count) {
+  Assert(bin_count > 0, "A histogram needs at least one bin.");
+  DebugAssert(std::is_sorted(sorted_values.cbegin(), sorted_values.cend()), "Values must be sorted.");
+
+  const auto value_count = sorted_values.size();
+  const auto target_bin_height = std::max((value_count + bin_count - 1) / bin_count, size_t{1});
+
+  auto bin_minima = std::vector<T>{};
+  auto bin_maxima = std::vector<T>{};
+  auto bin_heights = std::vector<size_t>{};
+  auto bin_begin = size_t{0};
+  while (bin_begin < value_count) {
+    auto bin_end = std::min(bin_begin + target_bin_height, value_count);
+    // extend the bin until the next value differs
+    while (bin_end < value_count && sorted_values[bin_end] == sorted_values[bin_end - 1]) {
+      ++bin_end;
+    }
+
+    bin_minima.push_back(sorted_values[bin_begin]);
+    bin_maxima.push_back(sorted_values[bin_end - 1]);
+    bin_heights.push_back(bin_end - bin_begin);
+    bin_begin = bin_end;
+  }
+
+  return std::make_shared<EquiDepthHistogram<T>>(std::move(bin_minima), std::move(bin_maxima), std::move(bin_heights));
+}
+
+template <typename T>
+std::shared_ptr<EquiDepthHistogram<T>> EquiDepthHistogram<T>::merge(
+    const std::vector<std::shared_ptr<const EquiDepthHistogram<T>>>& histograms, const size_t bin_count) {
+  Assert(bin_count > 0, "A histogram needs at least one bin.");
+
+  // collect the bins of all histograms ordered by their maxima
+  auto bins = std::vector<std::tuple<T, T, size_t>>{};
+  auto total_count = size_t{0};
+  for (const auto& histogram : histograms) {
+    for (auto bin_id = size_t{0}; bin_id < histogram->bin_count(); ++bin_id) {
+      bins.emplace_back(histogram->bin_maximum(bin_id), histogram->bin_minimum(bin_id), histogram->bin_height(bin_id));
+    }
+    total_count += histogram->total_count();
+  }
+  std::sort(bins.begin(), bins.end());
+
+  // combine consecutive bins until each reaches the target height
+  const auto target_bin_height = std::max((total_count + bin_count - 1) / bin_count, size_t{1});
+  auto bin_minima = std::vector<T>{};
+  auto bin_maxima = std::vector<T>{};
+  auto bin_heights = std::vector<size_t>{};
+  for (const auto& [bin_maximum, bin_minimum, bin_height] : bins) {
+    if (bin_heights.empty() || bin_heights.back() >= target_bin_height) {
+      bin_minima.push_back(bin_minimum);
+      bin_maxima.push_back(bin_maximum);
+      bin_heights.push_back(bin_height);
+    } else {
+      bin_minima.back() = std::min(bin_minima.back(), bin_minimum);
+      bin_maxima.back() = bin_maximum;
+      bin_heights.back() += bin_height;
+    }
+  }
+
+  return std::make_shared<EquiDepthHistogram<T>>(std::move(bin_minima), std::move(bin_maxima), std::move(bin_heights));
+}
+
+template <typename T>
+size_t EquiDepthHistogram<T>::bin_count() const {
+  return _bin_heights.size();
+}
+
+template <typename T>
+const T& EquiDepthHistogram<T>::bin_minimum(const size_t bin_id) const {
+  return _bin_minima.at(bin_id);
+}
+
+template <typename T>
+const T& EquiDepthHistogram<T>::bin_maximum(const size_t bin_id) const {
+  return _bin_maxima.at(bin_id);
+}
+
+template <typename T>
+size_t EquiDepthHistogram<T>::bin_height(const size_t bin_id) const {
+  return _bin_heights.at(bin_id);
+}
+
+template <typename T>
+size_t EquiDepthHistogram<T>::total_count() const {
+  return _total_count;
+}
+
+template <typename T>
+float EquiDepthHistogram<T>::_estimate_less_than(const T& search_value) const {
+  auto cardinality = 0.0f;
+  for (auto bin_id = size_t{0}; bin_id < bin_count(); ++bin_id) {
+    const auto& bin_minimum = _bin_minima[bin_id];
+    const auto& bin_maximum = _bin_maxima[bin_id];
+    const auto bin_height = static_cast<float>(_bin_heights[bin_id]);
+
+    if (bin_maximum < search_value) {
+      cardinality += bin_height;
+    } else if (bin_minimum < search_value) {
+      // The search value lies within the bin. Strings cannot be interpolated, so we assume half of the bin.
+      if constexpr (std::is_same_v<T, std::string>) {
+        cardinality += bin_height / 2.0f;
+      } else {
+        const auto bin_width = static_cast<double>(bin_maximum) - static_cast<double>(bin_minimum);
+        const auto share = (static_cast<double>(search_value) - static_cast<double>(bin_minimum)) / bin_width;
+        cardinality += bin_height * static_cast<float>(share);
+      }
+    }
+  }
+  return cardinality;
+}
+
+template <typename T>
+float EquiDepthHistogram<T>::_estimate_equals(const T& search_value, const size_t distinct_count) const {
+  auto is_covered = false;
+  for (auto bin_id = size_t{0}; bin_id < bin_count() && !is_covered; ++bin_id) {
+    is_covered = !(search_value < _bin_minima[bin_id]) && !(_bin_maxima[bin_id] < search_value);
+  }
+  if (!is_covered || distinct_count == 0) {
+    return 0.0f;
+  }
+  return static_cast<float>(_total_count) / static_cast<float>(distinct_count);
+}
+
+template <typename T>
+float EquiDepthHistogram<T>::estimate_cardinality(const ScanType scan_type, const T& search_value,
+                                                  const size_t distinct_count) const {
+  const auto total_count = static_cast<float>(_total_count);
+  const auto clamp = [&](const float cardinality) { return std::clamp(cardinality, 0.0f, total_count); };
+
+  switch (scan_type) {
+    case ScanType::OpEquals:
+      return clamp(_estimate_equals(search_value, distinct_count));
+    case ScanType::OpNotEquals:
+      return clamp(total_count - _estimate_equals(search_value, distinct_count));
+    case ScanType::OpLessThan:
+      return clamp(_estimate_less_than(search_value));
+    case ScanType::OpLessThanEquals:
+      return clamp(_estimate_less_than(search_value) + _estimate_equals(search_value, distinct_count));
+    case ScanType::OpGreaterThan:
+      return clamp(total_count - _estimate_less_than(search_value) - _estimate_equals(search_value, distinct_count));
+    case ScanType::OpGreaterThanEquals:
+      return clamp(total_count - _estimate_less_than(search_value));
+  }
+  Fail("Unknown scan type.");
+}
+
+EXPLICITLY_INSTANTIATE_DATA_TYPES(EquiDepthHistogram);
+
+}  // namespace opossum
@@ -0,0 +1,51 @@
+#pragma once
+
+#include <memory>
+#include <vector>
+
+#include "types.hpp"
+
+namespace opossum {
+
+// An equi-depth histogram splits the values of a column into bins that hold roughly the same number of values. Each
+// bin stores its minimum, its maximum, and the number of values it holds (its height). Bins of histograms that were
+// merged may overlap.
+template <typename T>
+class EquiDepthHistogram {
+ public:
+  EquiDepthHistogram(std::vector<T> bin_minima, std::vector<T> bin_maxima, std::vector<size_t> bin_heights);
+
+  // Builds a histogram with at most bin_count bins from sorted values. Equal values are never split across bins.
+  static std::shared_ptr<EquiDepthHistogram<T>> from_sorted_values(const std::vector<T>& sorted_values,
+                                                                   const size_t bin_count);
+
+  // Combines histograms, e.g., of several chunks, into a single one with at most bin_count bins.
+  static std::shared_ptr<EquiDepthHistogram<T>> merge(
+      const std::vector<std::shared_ptr<const EquiDepthHistogram<T>>>& histograms, const size_t bin_count);
+
+  size_t bin_count() const;
+  const T& bin_minimum(const size_t bin_id) const;
+  const T& bin_maximum(const size_t bin_id) const;
+  size_t bin_height(const size_t bin_id) const;
+
+  // Returns the number of values in all bins.
+  size_t total_count() const;
+
+  // Estimates the number of values that satisfy "value <scan_type> search_value". Equality predicates assume that all
+  // of the given number of distinct values occur equally often.
+  float estimate_cardinality(const ScanType scan_type, const T& search_value, const size_t distinct_count) const;
+
+ protected:
+  // Estimates the number of values smaller than the search value, interpolating linearly within numeric bins.
+  float _estimate_less_than(const T& search_value) const;
+
+  // Estimates the number of values equal to the search value.
+  float _estimate_equals(const T& search_value, const size_t distinct_count) const;
+
+  std::vector<T> _bin_minima;
+  std::vector<T> _bin_maxima;
+  std::vector<size_t> _bin_heights;
+  size_t _total_count;
+};
+
+}  // namespace opossum
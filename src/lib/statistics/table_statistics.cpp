@@ -0,0 +1,51 @@
+#include "table_statistics.hpp"
+
+#include <memory>
+#include <mutex>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "storage/chunk.hpp"
+#include "utils/assert.hpp"
+
+namespace opossum {
+
+void TableStatistics::add_column(const std::string& column_type) {
+  auto update_lock = std::lock_guard<std::mutex>{_update_mutex};
+  auto lock = std::lock_guard<std::mutex>{_mutex};
+  Assert(_row_count == 0, "Columns can only be added before any rows were added.");
+  _column_statistics.push_back(create_column_statistics(column_type));
+}
+
+void TableStatistics::add_chunk(const Chunk& chunk) {
+  auto update_lock = std::lock_guard<std::mutex>{_update_mutex};
+  Assert(chunk.column_count() == _column_statistics.size(), "The chunk does not match the columns of the statistics.");
+
+  // Only updates modify the statistics, which are serialized, so they can be read without _mutex here.
+  auto column_statistics = _column_statistics;
+  for (auto column_id = ColumnID{0}; column_id < column_statistics.size(); ++column_id) {
+    column_statistics[column_id] = column_statistics[column_id]->with_segment(chunk.get_segment(column_id));
+  }
+
+  auto lock = std::lock_guard<std::mutex>{_mutex};
+  _column_statistics = std::move(column_statistics);
+  _row_count += chunk.size();
+}
+
+size_t TableStatistics::row_count() const {
+  auto lock = std::lock_guard<std::mutex>{_mutex};
+  return _row_count;
+}
+
+std::shared_ptr<const BaseColumnStatistics> TableStatistics::column_statistics(const ColumnID column_id) const {
+  auto lock = std::lock_guard<std::mutex>{_mutex};
+  return _column_statistics.at(column_id);
+}
+
+float TableStatistics::estimate_selectivity(const ColumnID column_id, const ScanType scan_type,
+                                            const AllTypeVariant& search_value) const {
+  return column_statistics(column_id)->estimate_selectivity(scan_type, search_value);
+}
+
+}  // namespace opossum
@@ -0,0 +1,53 @@
+#pragma once
+
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include "all_type_variant.hpp"
+#include "column_statistics.hpp"
+#include "types.hpp"
+
+namespace opossum {
+
+class Chunk;
+
+// TableStatistics holds the statistics of all columns of a table. They cover all chunks that were sealed or
+// compressed, i.e., chunks whose values do not change anymore. Statistics are updated incrementally per chunk, so that
+// selectivities can be estimated without scanning the table.
+//
+// Rows are never removed from the statistics, as histograms and distinct count sketches cannot forget values. Rows
+// deleted by Table::delete_rows, including those that Table::compact removes, remain counted, so row counts and
+// histograms overestimate tables with many deleted rows.
+class TableStatistics : private Noncopyable {
+ public:
+  // Adds statistics for a new column. This can only be done as long as no rows were added.
+  void add_column(const std::string& column_type);
+
+  // Updates the statistics with the rows of a chunk, e.g., a sealed chunk or the rows that Table::merge_delta merged
+  // into a sealed chunk. Callers add each row once. Chunks are not identified by their ids, which shift when chunks are
+  // coalesced.
+  void add_chunk(const Chunk& chunk);
+
+  // Returns the number of rows covered by the statistics.
+  size_t row_count() const;
+
+  // Returns the current statistics of a column. The returned statistics are not affected by chunks added later.
+  std::shared_ptr<const BaseColumnStatistics> column_statistics(const ColumnID column_id) const;
+
+  // Estimates the fraction of rows that satisfy "column <scan_type> search_value".
+  float estimate_selectivity(const ColumnID column_id, const ScanType scan_type,
+                             const AllTypeVariant& search_value) const;
+
+ protected:
+  std::vector<std::shared_ptr<const BaseColumnStatistics>> _column_statistics{};
+  size_t _row_count{0};
+
+  // Updates are serialized by _update_mutex and are computed without blocking readers. _mutex only protects the
+  // members above while the updated statistics are published or read.
+  std::mutex _update_mutex{};
+  mutable std::mutex _mutex{};
+};
+
+}  // namespace opossum
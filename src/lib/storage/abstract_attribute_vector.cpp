@@ -0,0 +1,12 @@
+#include "abstract_attribute_vector.hpp"
+
+#include "utils/assert.hpp"
+
+namespace opossum {
+
+void AbstractAttributeVector::decode(const size_t begin_index, const size_t end_index, ValueID* output) const {
+  Assert(begin_index <= end_index && end_index <= size(), "Invalid range for decoding.");
+  _on_decode(begin_index, end_index, output);
+}
+
+}  // namespace opossum
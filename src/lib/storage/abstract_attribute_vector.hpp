@@ -27,6 +27,18 @@ class AbstractAttributeVector : private Noncopyable {
 
   // returns the width of biggest value id in bytes
   virtual AttributeVectorWidth width() const = 0;
+
+  // returns the calculated memory usage
+  virtual size_t estimate_memory_usage() const = 0;
+
+  // Writes the value ids in [begin_index, end_index) to output, which must have space for all of them. In contrast to
+  // get(), this requires a single virtual call for the entire range. Prefer it when processing many values, e.g., in
+  // scans, or use resolve_attribute_vector() to access the concrete vector.
+  void decode(const size_t begin_index, const size_t end_index, ValueID* output) const;
+
+ protected:
+  // Implementation of decode(). The range has already been checked.
+  virtual void _on_decode(const size_t begin_index, const size_t end_index, ValueID* output) const = 0;
 };
 
 }  // namespace opossum
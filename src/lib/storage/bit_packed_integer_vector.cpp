@@ -0,0 +1,122 @@
+#include "bit_packed_integer_vector.hpp"
+
+#include <algorithm>
+#include <array>
+#include <utility>
+#include <vector>
+
+namespace opossum {
+
+namespace {
+
+constexpr auto BITS_PER_WORD = size_t{64};
+
+// Unpacks a group of 64 value ids, which is stored in exactly BitWidth words. As all shifts are known at compile time,
+// the compiler fully unrolls the loop and can use SIMD instructions for it.
+template <size_t BitWidth>
+void unpack_group(const uint64_t* words, ValueID* output) {
+  constexpr auto mask = (uint64_t{1} << BitWidth) - 1;
+
+  for (auto value_index = size_t{0}; value_index < BITS_PER_WORD; ++value_index) {
+    const auto bit_offset = value_index * BitWidth;
+    const auto word_index = bit_offset / BITS_PER_WORD;
+    const auto shift = bit_offset % BITS_PER_WORD;
+
+    auto value = words[word_index] >> shift;
+    if (shift + BitWidth > BITS_PER_WORD) {
+      value |= words[word_index + 1] << (BITS_PER_WORD - shift);
+    }
+    output[value_index] = ValueID{static_cast<ValueID::base_type>(value & mask)};
+  }
+}
+
+using UnpackGroupFunction = void (*)(const uint64_t*, ValueID*);
+
+template <size_t... BitWidthIndices>
+constexpr auto make_unpack_group_functions(std::index_sequence<BitWidthIndices...>) {
+  return std::array<UnpackGroupFunction, sizeof...(BitWidthIndices)>{&unpack_group<BitWidthIndices + 1>...};
+}
+
+// Holds the unpack function for bit width n at index n - 1.
+constexpr auto unpack_group_functions = make_unpack_group_functions(std::make_index_sequence<32>{});
+
+}  // namespace
+
+BitPackedIntegerVector::BitPackedIntegerVector(const uint8_t bit_width) : _bit_width{bit_width} {
+  Assert(bit_width > 0 && bit_width <= 32, "Bit-packed value ids must use between 1 and 32 bits.");
+}
+
+BitPackedIntegerVector::BitPackedIntegerVector(const uint8_t bit_width, MappableVector<uint64_t> words,
+                                               const size_t size)
+    : BitPackedIntegerVector{bit_width} {
+  Assert(words.size() == (size * bit_width + BITS_PER_WORD - 1) / BITS_PER_WORD,
+         "The number of words does not match the number of value ids.");
+  _words = std::move(words);
+  _size = size;
+}
+
+void BitPackedIntegerVector::set(const size_t index, const ValueID value_id) {
+  Assert(index <= size(), "You can only set existing values or one beyond the last element for extension purposes!");
+  DebugAssert((uint64_t{value_id} >> _bit_width) == 0, "Value id does not fit into the bit width of this vector.");
+
+  if (index == _size) {
+    ++_size;
+    _words.resize((_size * _bit_width + BITS_PER_WORD - 1) / BITS_PER_WORD);
+  }
+
+  const auto bit_offset = index * _bit_width;
+  const auto word_index = bit_offset / BITS_PER_WORD;
+  const auto shift = bit_offset % BITS_PER_WORD;
+  const auto mask = (uint64_t{1} << _bit_width) - 1;
+  const auto value = uint64_t{value_id};
+
+  auto* words = _words.mutable_data();
+  words[word_index] = (words[word_index] & ~(mask << shift)) | (value << shift);
+
+  // the value id continues in the next word
+  if (shift + _bit_width > BITS_PER_WORD) {
+    const auto written_bits = BITS_PER_WORD - shift;
+    words[word_index + 1] = (words[word_index + 1] & ~(mask >> written_bits)) | (value >> written_bits);
+  }
+}
+
+void BitPackedIntegerVector::reserve(const size_t size) {
+  _words.reserve((size * _bit_width + BITS_PER_WORD - 1) / BITS_PER_WORD);
+}
+
+size_t BitPackedIntegerVector::size() const { return _size; }
+
+AttributeVectorWidth BitPackedIntegerVector::width() const {
+  return static_cast<AttributeVectorWidth>((_bit_width + 7) / 8);
+}
+
+size_t BitPackedIntegerVector::estimate_memory_usage() const { return _words.size() * sizeof(uint64_t); }
+
+uint8_t BitPackedIntegerVector::bit_width() const { return _bit_width; }
+
+const MappableVector<uint64_t>& BitPackedIntegerVector::words() const { return _words; }
+
+void BitPackedIntegerVector::_on_decode(const size_t begin_index, const size_t end_index, ValueID* output) const {
+  // Decode single values until we reach the start of a group of 64 values, then unpack full groups at once and finally
+  // decode the remaining values one by one.
+  const auto first_group_begin =
+      std::min((begin_index + BITS_PER_WORD - 1) / BITS_PER_WORD * BITS_PER_WORD, end_index);
+  const auto last_group_end = std::max(end_index / BITS_PER_WORD * BITS_PER_WORD, first_group_begin);
+
+  auto index = begin_index;
+  for (; index < first_group_begin; ++index) {
+    *output++ = get(index);
+  }
+
+  const auto unpack_group_function = unpack_group_functions[_bit_width - 1];
+  for (; index < last_group_end; index += BITS_PER_WORD) {
+    unpack_group_function(&_words[index / BITS_PER_WORD * _bit_width], output);
+    output += BITS_PER_WORD;
+  }
+
+  for (; index < end_index; ++index) {
+    *output++ = get(index);
+  }
+}
+
+}  // namespace opossum
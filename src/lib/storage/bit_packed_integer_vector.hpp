@@ -0,0 +1,73 @@
+#pragma once
+
+#include <vector>
+
+#include "all_type_variant.hpp"
+#include "utils/assert.hpp"
+
+#include "abstract_attribute_vector.hpp"
+#include "mappable_vector.hpp"
+
+namespace opossum {
+
+// BitPackedIntegerVector stores each value id with exactly as many bits as the largest value id requires, e.g., 9 bits
+// for a dictionary with 300 entries. Value ids are packed back to back into 64-bit words, so a single value id may span
+// two words. Since 64 consecutive value ids always occupy exactly bit_width() words, aligned groups of 64 value ids can
+// be unpacked with shifts that are known at compile time, which allows the compiler to vectorize bulk decoding.
+class BitPackedIntegerVector final : public AbstractAttributeVector {
+ public:
+  // Creates an empty vector that stores value ids with the given number of bits (between 1 and 32).
+  explicit BitPackedIntegerVector(const uint8_t bit_width);
+
+  // Creates a vector of size value ids from their packed words, e.g., when reading a serialized vector. The words may
+  // reference a memory-mapped file.
+  BitPackedIntegerVector(const uint8_t bit_width, MappableVector<uint64_t> words, const size_t size);
+
+  // returns the value id at a given position
+  ValueID get(const size_t index) const override {
+    DebugAssert(index < _size, "Index is out of bounds.");
+
+    const auto bit_offset = index * _bit_width;
+    const auto word_index = bit_offset / 64;
+    const auto shift = bit_offset % 64;
+
+    auto value = _words[word_index] >> shift;
+    // the value id continues in the next word
+    if (shift + _bit_width > 64) {
+      value |= _words[word_index + 1] << (64 - shift);
+    }
+
+    return ValueID{static_cast<ValueID::base_type>(value & ((uint64_t{1} << _bit_width) - 1))};
+  }
+
+  // sets the value id at a given position
+  void set(const size_t index, const ValueID value_id) override;
+
+  // reserves space for the given number of value ids
+  void reserve(const size_t size);
+
+  // returns the number of values
+  size_t size() const override;
+
+  // returns the width of biggest value id in bytes, rounded up to full bytes
+  AttributeVectorWidth width() const override;
+
+  // returns the calculated memory usage
+  size_t estimate_memory_usage() const override;
+
+  // returns the number of bits used to store a single value id
+  uint8_t bit_width() const;
+
+  // returns the words into which the value ids are packed
+  const MappableVector<uint64_t>& words() const;
+
+ protected:
+  // Unpacks aligned groups of 64 value ids at once.
+  void _on_decode(const size_t begin_index, const size_t end_index, ValueID* output) const override;
+
+  MappableVector<uint64_t> _words{};
+  size_t _size{0};
+  uint8_t _bit_width;
+};
+
+}  // namespace opossum
@@ -0,0 +1,235 @@
+#include "buffer_manager.hpp"
+
+#include <unistd.h>
+
+#include <algorithm>
+#include <exception>
+#include <filesystem>
+#include <memory>
+#include <string>
+#include <system_error>
+#include <utility>
+#include <vector>
+
+#include "abstract_segment.hpp"
+#include "chunk.hpp"
+#include "import_export/binary_parser.hpp"
+#include "import_export/binary_writer.hpp"
+#include "utils/assert.hpp"
+
+namespace opossum {
+
+namespace {
+
+// Frames are not purged before there are at least this many, as purging iterates over all frames.
+constexpr auto MIN_PURGED_FRAME_COUNT = size_t{64};
+
+std::string default_spill_directory() {
+  const auto directory_name = "opossum_buffer_manager_" + std::to_string(getpid());
+  return (std::filesystem::temp_directory_path() / directory_name).string();
+}
+
+}  // namespace
+
+struct BufferManager::SpillFile {
+  explicit SpillFile(std::string init_file_name) : file_name{std::move(init_file_name)} {}
+
+  ~SpillFile() {
+    auto error_code = std::error_code{};
+    std::filesystem::remove(file_name, error_code);
+  }
+
+  const std::string file_name;
+};
+
+BufferManager::BufferManager() : _spill_directory{default_spill_directory()} {}
+
+BufferManager& BufferManager::get() {
+  static auto instance = BufferManager{};
+  return instance;
+}
+
+void BufferManager::set_memory_budget(const size_t memory_budget) {
+  auto guard = std::unique_lock<std::mutex>{_mutex};
+  _memory_budget = memory_budget;
+  _evict(guard);
+}
+
+size_t BufferManager::memory_budget() const {
+  auto guard = std::lock_guard<std::mutex>{_mutex};
+  return _memory_budget;
+}
+
+void BufferManager::set_spill_directory(const std::string& directory) {
+  auto guard = std::lock_guard<std::mutex>{_mutex};
+  _spill_directory = directory;
+}
+
+void BufferManager::register_chunk(const std::shared_ptr<Chunk>& chunk, const std::vector<std::string>& column_types) {
+  auto frame = std::make_shared<Frame>();
+  frame->chunk = chunk;
+  frame->column_types = column_types;
+  for (auto column_id = ColumnID{0}; column_id < chunk->column_count(); ++column_id) {
+    frame->memory_usage += chunk->get_segment(column_id)->estimate_memory_usage();
+  }
+
+  auto guard = std::unique_lock<std::mutex>{_mutex};
+  if (_frames.size() >= 2 * std::max(_frame_count_after_purge, MIN_PURGED_FRAME_COUNT)) {
+    _remove_expired_frames_unsafe();
+  }
+  _resident_memory_usage += frame->memory_usage;
+  _frames.push_back(std::move(frame));
+  _evict(guard);
+}
+
+size_t BufferManager::resident_memory_usage() const {
+  auto guard = std::lock_guard<std::mutex>{_mutex};
+  auto memory_usage = size_t{0};
+  for (const auto& frame : _frames) {
+    if (frame->is_resident && !frame->chunk.expired()) {
+      memory_usage += frame->memory_usage;
+    }
+  }
+  return memory_usage;
+}
+
+size_t BufferManager::evicted_chunk_count() const {
+  auto guard = std::lock_guard<std::mutex>{_mutex};
+  return static_cast<size_t>(std::count_if(_frames.cbegin(), _frames.cend(), [](const auto& frame) {
+    return !frame->is_resident && !frame->chunk.expired();
+  }));
+}
+
+void BufferManager::reset() {
+  auto guard = std::lock_guard<std::mutex>{_mutex};
+  _memory_budget = std::numeric_limits<size_t>::max();
+  _spill_directory = default_spill_directory();
+  _frames.clear();
+  _clock_hand = 0;
+  _resident_memory_usage = 0;
+  _frame_count_after_purge = 0;
+  ++_reset_count;
+}
+
+void BufferManager::_on_chunk_restored(const std::shared_ptr<Frame>& frame) {
+  auto guard = std::unique_lock<std::mutex>{_mutex};
+  frame->is_resident = true;
+  _resident_memory_usage += frame->memory_usage;
+  _evict(guard, frame);
+}
+
+void BufferManager::_evict(std::unique_lock<std::mutex>& guard, const std::shared_ptr<const Frame>& skipped_frame) {
+  const auto victims = _select_victims_unsafe(skipped_frame);
+  if (victims.empty()) {
+    return;
+  }
+  const auto spill_directory = _spill_directory;
+  const auto reset_count = _reset_count;
+
+  // The victims cannot be chosen by other evictions, and their chunks are kept alive and do not change, so their
+  // files can be written without the lock. A chunk is evicted even if it is accessed meanwhile, as it is restored on
+  // demand.
+  guard.unlock();
+  auto spill_files = std::vector<std::shared_ptr<const SpillFile>>(victims.size());
+  auto failure = std::exception_ptr{};
+  try {
+    for (auto victim_id = size_t{0}; victim_id < victims.size(); ++victim_id) {
+      const auto& victim = victims[victim_id];
+      if (!victim.file_name.empty()) {
+        std::filesystem::create_directories(spill_directory);
+        BinaryWriter::write_chunk(*victim.chunk, victim.frame->column_types, victim.file_name);
+        spill_files[victim_id] = std::make_shared<const SpillFile>(victim.file_name);
+      }
+    }
+  } catch (...) {
+    failure = std::current_exception();
+  }
+  guard.lock();
+
+  for (auto victim_id = size_t{0}; victim_id < victims.size(); ++victim_id) {
+    const auto& victim = victims[victim_id];
+    victim.frame->is_selected = false;
+    _selected_memory_usage -= victim.frame->memory_usage;
+    if (spill_files[victim_id]) {
+      victim.frame->spill_file = spill_files[victim_id];
+    }
+    if (victim.frame->spill_file && _reset_count == reset_count) {
+      _try_evict_unsafe(victim);
+    }
+  }
+
+  if (failure) {
+    std::rethrow_exception(failure);
+  }
+}
+
+std::vector<BufferManager::Victim> BufferManager::_select_victims_unsafe(
+    const std::shared_ptr<const Frame>& skipped_frame) {
+  const auto exceeds_budget = [&]() {
+    return _resident_memory_usage > _selected_memory_usage &&
+           _resident_memory_usage - _selected_memory_usage > _memory_budget;
+  };
+  auto victims = std::vector<Victim>{};
+  if (!exceeds_budget()) {
+    return victims;
+  }
+
+  _remove_expired_frames_unsafe();
+  // Within two rounds, the clock hand reaches every chunk that was accessed at the beginning a second time.
+  for (auto step = size_t{0}; step < 2 * _frames.size() && exceeds_budget(); ++step) {
+    _clock_hand %= _frames.size();
+    const auto frame = _frames[_clock_hand++];
+    if (frame == skipped_frame || !frame->is_resident || frame->is_selected) {
+      continue;
+    }
+    auto chunk = frame->chunk.lock();
+    if (!chunk || chunk->is_pinned() || chunk->fetch_and_reset_accessed()) {
+      continue;
+    }
+
+    // A chunk is immutable once registered, so a file written for an earlier eviction is reused.
+    auto file_name = std::string{};
+    if (!frame->spill_file) {
+      const auto spill_file_name = "chunk_" + std::to_string(_next_spill_file_id++);
+      file_name = (std::filesystem::path{_spill_directory} / spill_file_name).string();
+    }
+    frame->is_selected = true;
+    _selected_memory_usage += frame->memory_usage;
+    victims.push_back({frame, std::move(chunk), std::move(file_name)});
+  }
+  return victims;
+}
+
+void BufferManager::_try_evict_unsafe(const Victim& victim) {
+  const auto& frame = victim.frame;
+  if (!frame->is_resident) {
+    return;
+  }
+
+  // The loader keeps the file alive even if the frame is removed, and does not keep the frame alive.
+  auto loader = [this, weak_frame = std::weak_ptr<Frame>{frame}, spill_file = frame->spill_file,
+                 column_types = frame->column_types]() {
+    auto segments = BinaryParser::parse_chunk(spill_file->file_name, column_types);
+    if (const auto restored_frame = weak_frame.lock()) {
+      _on_chunk_restored(restored_frame);
+    }
+    return segments;
+  };
+  if (victim.chunk->try_evict(std::move(loader))) {
+    frame->is_resident = false;
+    _resident_memory_usage -= frame->memory_usage;
+  }
+}
+
+void BufferManager::_remove_expired_frames_unsafe() {
+  const auto is_expired = [](const auto& frame) { return frame->chunk.expired(); };
+  for (const auto& frame : _frames) {
+    if (frame->is_resident && is_expired(frame)) {
+      _resident_memory_usage -= frame->memory_usage;
+    }
+  }
+  _frames.erase(std::remove_if(_frames.begin(), _frames.end(), is_expired), _frames.end());
+  _frame_count_after_purge = _frames.size();
+}
+
+}  // namespace opossum
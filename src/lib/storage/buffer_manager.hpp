@@ -0,0 +1,108 @@
+#pragma once
+
+#include <limits>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include "types.hpp"
+
+namespace opossum {
+
+class Chunk;
+
+// The BufferManager is a singleton that keeps the memory used by compressed chunks within a budget. Tables register
+// their chunks once they are compressed, as only those do not change anymore. If the registered chunks that are
+// resident exceed the budget, cold chunks are written to files in the spill directory and their segments are dropped.
+// A chunk is restored from its file on the next access to its segments (see Chunk::get_segment).
+//
+// Chunks are chosen by the CLOCK algorithm: a chunk whose segments were accessed since the clock hand last passed it
+// gets a second chance. Pinned chunks are never evicted. A chunk is only written once, as it is immutable; its file is
+// removed when the chunk is destroyed.
+//
+// Restored segments reference their file through a memory mapping, so their pages are managed by the operating system
+// and, in contrast to the segments before eviction, can be dropped under memory pressure.
+class BufferManager : private Noncopyable {
+ public:
+  static BufferManager& get();
+
+  // Sets the number of bytes that resident registered chunks may use and evicts chunks if they use more. The default
+  // budget is unlimited.
+  void set_memory_budget(const size_t memory_budget);
+  size_t memory_budget() const;
+
+  // Sets the directory to which evicted chunks are written. It is created on the first eviction. Defaults to a
+  // directory in the temporary directory of the system.
+  void set_spill_directory(const std::string& directory);
+
+  // Starts tracking a compressed chunk, whose columns have the given types. Evicts chunks if the budget is exceeded.
+  void register_chunk(const std::shared_ptr<Chunk>& chunk, const std::vector<std::string>& column_types);
+
+  // Returns the estimated memory usage of the registered chunks that are resident.
+  size_t resident_memory_usage() const;
+
+  // Returns the number of registered chunks that are currently evicted.
+  size_t evicted_chunk_count() const;
+
+  // Forgets all registered chunks and restores the default budget, used especially in tests. Evicted chunks can still
+  // be restored.
+  void reset();
+
+ protected:
+  // A file that is removed once neither the BufferManager nor an evicted chunk needs it anymore.
+  struct SpillFile;
+
+  struct Frame {
+    std::weak_ptr<Chunk> chunk;
+    std::vector<std::string> column_types;
+    size_t memory_usage{0};
+    bool is_resident{true};
+    // set while the chunk is being evicted, so that concurrent evictions do not choose it as well
+    bool is_selected{false};
+    std::shared_ptr<const SpillFile> spill_file{};
+  };
+
+  // A chunk chosen for eviction, together with the file to which it is written if it has no spill file yet.
+  struct Victim {
+    std::shared_ptr<Frame> frame;
+    std::shared_ptr<Chunk> chunk;
+    std::string file_name;
+  };
+
+  BufferManager();
+
+  // Called by the loader of an evicted chunk once its segments are restored.
+  void _on_chunk_restored(const std::shared_ptr<Frame>& frame);
+
+  // Evicts chunks until the budget is met or no chunk can be evicted. The given frame, which is currently being
+  // restored, is skipped. Victims are chosen while holding the lock, which is released while their spill files are
+  // written, so that other threads do not wait for the disk. Expects the guard to hold _mutex.
+  void _evict(std::unique_lock<std::mutex>& guard, const std::shared_ptr<const Frame>& skipped_frame = nullptr);
+
+  // Advances the clock hand and chooses chunks to evict until the budget would be met. Chunks that are pinned or were
+  // accessed recently are skipped, in which case their access flag is reset.
+  std::vector<Victim> _select_victims_unsafe(const std::shared_ptr<const Frame>& skipped_frame);
+
+  // Evicts the chunk of a selected frame whose spill file was written.
+  void _try_evict_unsafe(const Victim& victim);
+
+  // Removes the frames of destroyed chunks.
+  void _remove_expired_frames_unsafe();
+
+  size_t _memory_budget{std::numeric_limits<size_t>::max()};
+  std::string _spill_directory{};
+  std::vector<std::shared_ptr<Frame>> _frames{};
+  size_t _clock_hand{0};
+  size_t _resident_memory_usage{0};
+  // memory usage of the selected frames, which is freed once their chunks are evicted
+  size_t _selected_memory_usage{0};
+  // evictions that started before a reset do not update the counters of the forgotten frames
+  size_t _reset_count{0};
+  size_t _next_spill_file_id{0};
+  // frames are purged once their number doubled, so that the frames of dropped tables do not accumulate
+  size_t _frame_count_after_purge{0};
+  mutable std::mutex _mutex{};
+};
+
+}  // namespace opossum
@@ -3,18 +3,25 @@
 #include <limits>
 #include <memory>
 #include <mutex>
+#include <shared_mutex>
 #include <string>
 #include <utility>
 #include <vector>
 
 #include "abstract_segment.hpp"
 #include "chunk.hpp"
+#include "validity_bitmap.hpp"
+#include "zone_map.hpp"
 
 #include "utils/assert.hpp"
 
 namespace opossum {
 
-void Chunk::add_segment(const std::shared_ptr<AbstractSegment> segment) { _segments.push_back(segment); }
+void Chunk::add_segment(const std::shared_ptr<AbstractSegment> segment) {
+  auto segments = std::make_shared<Segments>(*_resident_segments());
+  segments->push_back(segment);
+  _segments.store(std::move(segments));
+}
 
 void Chunk::append(const std::vector<AllTypeVariant>& values) {
   const auto& n_columns = column_count();
@@ -22,20 +29,123 @@ void Chunk::append(const std::vector<AllTypeVariant>& values) {
   // required guard, as a smaller row would not cause issues when using the .at accessor on the vector
   Assert(values.size() == n_columns, "The row you're trying to insert does not match the number of columns expected.");
 
+  const auto segments = _resident_segments();
   for (auto column_index = ColumnCount{0}; column_index < n_columns; ++column_index) {
-    _segments[column_index]->append(values[column_index]);
+    (*segments)[column_index]->append(values[column_index]);
+  }
+}
+
+std::shared_ptr<AbstractSegment> Chunk::get_segment(const ColumnID column_id) const {
+  return _resident_segments()->at(column_id);
+}
+
+std::shared_ptr<const Chunk::Segments> Chunk::_resident_segments() const {
+  // The flag is only written if it is not set yet, so that concurrent scans do not contend for its cache line.
+  if (!_accessed.load(std::memory_order_relaxed)) {
+    _accessed.store(true, std::memory_order_relaxed);
+  }
+
+  auto segments = _segments.load();
+  if (segments) {
+    return segments;
+  }
+
+  auto lock = std::lock_guard<std::mutex>{_residency_mutex};
+  segments = _segments.load();
+  if (!segments) {
+    segments = std::make_shared<const Segments>(_segment_loader());
+    _segment_loader = nullptr;
+    _segments.store(segments);
+  }
+  return segments;
+}
+
+void Chunk::pin() { ++_pin_count; }
+
+void Chunk::unpin() {
+  DebugAssert(_pin_count > 0, "The chunk is not pinned.");
+  --_pin_count;
+}
+
+bool Chunk::is_pinned() const { return _pin_count > 0; }
+
+bool Chunk::is_resident() const { return static_cast<bool>(_segments.load()); }
+
+bool Chunk::try_evict(SegmentLoader loader) {
+  auto lock = std::unique_lock<std::mutex>{_residency_mutex, std::try_to_lock};
+  if (!lock.owns_lock() || is_pinned() || !is_resident()) {
+    return false;
   }
+
+  _evicted_size = size();
+  _evicted_column_count = column_count();
+  _segment_loader = std::move(loader);
+  _segments.store(nullptr);
+  return true;
+}
+
+bool Chunk::fetch_and_reset_accessed() { return _accessed.exchange(false, std::memory_order_relaxed); }
+
+void Chunk::set_zone_maps(std::vector<std::shared_ptr<BaseZoneMap>> zone_maps) {
+  Assert(zone_maps.size() == column_count(), "A chunk needs exactly one zone map per segment.");
+  auto lock = std::unique_lock<std::shared_mutex>{_zone_maps_mutex};
+  _zone_maps = std::move(zone_maps);
+}
+
+std::shared_ptr<const BaseZoneMap> Chunk::zone_map(const ColumnID column_id) const {
+  auto lock = std::shared_lock<std::shared_mutex>{_zone_maps_mutex};
+  if (_zone_maps.empty()) {
+    return nullptr;
+  }
+  return _zone_maps.at(column_id);
+}
+
+bool Chunk::can_prune(const ColumnID column_id, const ScanType scan_type, const AllTypeVariant& search_value) const {
+  const auto segment_zone_map = zone_map(column_id);
+  return segment_zone_map && segment_zone_map->can_prune(scan_type, search_value);
 }
 
-std::shared_ptr<AbstractSegment> Chunk::get_segment(const ColumnID column_id) const { return _segments.at(column_id); }
+ChunkOffset Chunk::invalidate_rows(const std::vector<ChunkOffset>& chunk_offsets) {
+  auto lock = std::lock_guard<std::mutex>{_validity_mutex};
+  const auto chunk_size = size();
+  auto validity = _validity.load();
+  if (!validity || validity->size() < chunk_size) {
+    validity = validity ? std::make_shared<ValidityBitmap>(*validity, chunk_size)
+                        : std::make_shared<ValidityBitmap>(chunk_size);
+    _validity.store(validity);
+  }
+
+  auto invalidated_row_count = ChunkOffset{0};
+  for (const auto chunk_offset : chunk_offsets) {
+    Assert(chunk_offset < chunk_size, "The row does not exist in this chunk.");
+    invalidated_row_count += validity->invalidate(chunk_offset);
+  }
+  return invalidated_row_count;
+}
+
+std::shared_ptr<const ValidityBitmap> Chunk::validity() const { return _validity.load(); }
 
-ColumnCount Chunk::column_count() const { return static_cast<ColumnCount>(_segments.size()); }
+ChunkOffset Chunk::invalid_row_count() const {
+  const auto validity = _validity.load();
+  return validity ? validity->invalid_count() : 0;
+}
+
+ColumnCount Chunk::column_count() const {
+  const auto segments = _segments.load();
+  if (!segments) {
+    return _evicted_column_count;
+  }
+  return static_cast<ColumnCount>(segments->size());
+}
 
 ChunkOffset Chunk::size() const {
-  if (_segments.empty()) {
+  const auto segments = _segments.load();
+  if (!segments) {
+    return _evicted_size;
+  } else if (segments->empty()) {
     return 0;
   } else {
-    return _segments.front()->size();
+    return segments->front()->size();
   }
 }
 
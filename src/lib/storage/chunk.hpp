@@ -4,7 +4,9 @@
 #include <shared_mutex>
 
 #include <atomic>
+#include <functional>
 #include <memory>
+#include <mutex>
 #include <string>
 #include <vector>
 
@@ -14,14 +16,25 @@
 namespace opossum {
 
 class BaseIndex;
+class BaseZoneMap;
 class AbstractSegment;
+class ValidityBitmap;
 
 // A chunk is a horizontal partition of a table.
 // For each column in the table, it holds one segment. The segments across all chunks constitute the column.
 //
 // Find more information about this in our wiki: https://github.com/hyrise/hyrise/wiki/chunk-concept
+//
+// A compressed chunk may be evicted from memory by the BufferManager. Its segments are then restored transparently on
+// the next call of get_segment(), while zone maps, size() and column_count() remain available without restoring them.
+//
+// Rows are deleted by marking them as invalid in a ValidityBitmap, which is kept apart from the segments. Thus, deletes
+// do not modify (possibly compressed or evicted) segments, and readers skip invalid rows.
 class Chunk : private Noncopyable {
  public:
+  using Segments = std::vector<std::shared_ptr<AbstractSegment>>;
+  using SegmentLoader = std::function<Segments()>;
+
   // Creates an empty chunk.
   Chunk() = default;
 
@@ -38,12 +51,68 @@ class Chunk : private Noncopyable {
   // for testing purposes only.
   void append(const std::vector<AllTypeVariant>& values);
 
-  // Returns the segment at a given position.
+  // Returns the segment at a given position. Restores the segments first if the chunk is evicted.
   std::shared_ptr<AbstractSegment> get_segment(ColumnID column_id) const;
 
+  // Pinned chunks are not evicted, so that operators can repeatedly access their segments without restoring them.
+  // Segments that were returned by get_segment() remain valid even if the chunk is evicted, as they are shared.
+  void pin();
+  void unpin();
+  bool is_pinned() const;
+
+  // Returns false if the chunk is evicted.
+  bool is_resident() const;
+
+  // Drops the segments of the chunk. The loader is called to restore them on the next access. Returns false, and does
+  // nothing, if the chunk is pinned, evicted, or currently being restored.
+  bool try_evict(SegmentLoader loader);
+
+  // Returns whether the segments were accessed since the last call and resets this flag. Used for CLOCK eviction.
+  bool fetch_and_reset_accessed();
+
+  // Sets one zone map per segment. Zone maps are created once a chunk is sealed (i.e., full) or compressed.
+  void set_zone_maps(std::vector<std::shared_ptr<BaseZoneMap>> zone_maps);
+
+  // Returns the zone map of a segment, or nullptr if the chunk has none (yet).
+  std::shared_ptr<const BaseZoneMap> zone_map(const ColumnID column_id) const;
+
+  // Returns true if the zone map of the given column shows that no row of this chunk can match the predicate.
+  bool can_prune(const ColumnID column_id, const ScanType scan_type, const AllTypeVariant& search_value) const;
+
+  // Marks the rows at the given positions as invalid and returns the number of rows that were valid before.
+  ChunkOffset invalidate_rows(const std::vector<ChunkOffset>& chunk_offsets);
+
+  // Returns the validity bitmap, or nullptr if no row was invalidated yet. Rows beyond the size of the bitmap, e.g.,
+  // rows appended after it was created, are valid.
+  std::shared_ptr<const ValidityBitmap> validity() const;
+
+  // Returns the number of invalid rows.
+  ChunkOffset invalid_row_count() const;
+
  protected:
-  // Implementation goes here
-  std::vector<std::shared_ptr<AbstractSegment>> _segments{};
+  // Returns the segments, restoring them if the chunk is evicted.
+  std::shared_ptr<const Segments> _resident_segments() const;
+
+  // The segment list is replaced as a whole, so that it can be dropped on eviction while it is read. It is nullptr
+  // while the chunk is evicted.
+  mutable std::atomic<std::shared_ptr<const Segments>> _segments{std::make_shared<const Segments>()};
+
+  // Guards eviction and restoring. The size and column count of an evicted chunk are kept.
+  mutable std::mutex _residency_mutex{};
+  mutable SegmentLoader _segment_loader{};
+  ChunkOffset _evicted_size{0};
+  ColumnCount _evicted_column_count{0};
+  std::atomic<uint32_t> _pin_count{0};
+  mutable std::atomic<bool> _accessed{false};
+
+  // The bitmap is replaced by a larger copy if rows beyond its size are invalidated. Invalidations are serialized, so
+  // that none is lost to a concurrent replacement.
+  std::atomic<std::shared_ptr<ValidityBitmap>> _validity{};
+  std::mutex _validity_mutex{};
+
+  // Zone maps may be set while the chunk is scanned, so access to them is synchronized.
+  std::vector<std::shared_ptr<BaseZoneMap>> _zone_maps{};
+  mutable std::shared_mutex _zone_maps_mutex{};
 };
 
 }  // namespace opossum
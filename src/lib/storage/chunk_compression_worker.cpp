@@ -0,0 +1,75 @@
+#include "chunk_compression_worker.hpp"
+
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <utility>
+
+namespace opossum {
+
+ChunkCompressionWorker::ChunkCompressionWorker(std::function<void(const std::shared_ptr<Chunk>&)> compress_chunk)
+    : _compress_chunk{std::move(compress_chunk)}, _thread{&ChunkCompressionWorker::_run, this} {}
+
+ChunkCompressionWorker::~ChunkCompressionWorker() {
+  {
+    auto lock = std::lock_guard<std::mutex>{_mutex};
+    _shutdown = true;
+  }
+  _queue_condition.notify_one();
+  _thread.join();
+}
+
+void ChunkCompressionWorker::enqueue(const std::shared_ptr<Chunk>& chunk) {
+  {
+    auto lock = std::lock_guard<std::mutex>{_mutex};
+    _queue.push_back(chunk);
+  }
+  _queue_condition.notify_one();
+}
+
+void ChunkCompressionWorker::wait_until_idle() {
+  auto lock = std::unique_lock<std::mutex>{_mutex};
+  _idle_condition.wait(lock, [&] { return _queue.empty() && !_is_compressing; });
+  if (_failure) {
+    std::rethrow_exception(std::exchange(_failure, nullptr));
+  }
+}
+
+void ChunkCompressionWorker::_run() {
+  auto lock = std::unique_lock<std::mutex>{_mutex};
+  while (true) {
+    _queue_condition.wait(lock, [&] { return _shutdown || !_queue.empty(); });
+    if (_shutdown) {
+      break;
+    }
+
+    const auto chunk = _queue.front();
+    _queue.pop_front();
+    _is_compressing = true;
+
+    // An exception must not escape the thread, which would terminate the process.
+    lock.unlock();
+    auto failure = std::exception_ptr{};
+    try {
+      _compress_chunk(chunk);
+    } catch (...) {
+      failure = std::current_exception();
+    }
+    lock.lock();
+
+    if (failure && !_failure) {
+      _failure = failure;
+    }
+    _is_compressing = false;
+    if (_queue.empty()) {
+      _idle_condition.notify_all();
+    }
+  }
+
+  // wake up waiting threads, as the remaining chunks will not be compressed
+  _queue.clear();
+  _idle_condition.notify_all();
+}
+
+}  // namespace opossum
@@ -0,0 +1,51 @@
+#pragma once
+
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+
+#include "types.hpp"
+
+namespace opossum {
+
+class Chunk;
+
+// ChunkCompressionWorker compresses chunks in a background thread, so that appending to a table does not wait for the
+// compression of the chunks it has filled. Chunks are compressed in the order in which they were enqueued. They are
+// queued by pointer instead of by id, as ids shift when chunks are coalesced (see Table::coalesce_chunks). A chunk
+// whose compression fails does not stop the worker. Instead, the failure is reported by the next call of
+// wait_until_idle().
+class ChunkCompressionWorker : private Noncopyable {
+ public:
+  // Starts the worker thread, which calls compress_chunk for each enqueued chunk.
+  explicit ChunkCompressionWorker(std::function<void(const std::shared_ptr<Chunk>&)> compress_chunk);
+
+  // Stops the worker thread. Chunks that are still queued are not compressed.
+  ~ChunkCompressionWorker();
+
+  // Hands a chunk to the worker.
+  void enqueue(const std::shared_ptr<Chunk>& chunk);
+
+  // Blocks until all enqueued chunks are compressed. Rethrows the first exception thrown by compress_chunk since the
+  // last call, if any.
+  void wait_until_idle();
+
+ protected:
+  void _run();
+
+  const std::function<void(const std::shared_ptr<Chunk>&)> _compress_chunk;
+  std::deque<std::shared_ptr<Chunk>> _queue{};
+  bool _is_compressing{false};
+  std::exception_ptr _failure{};
+  bool _shutdown{false};
+  std::mutex _mutex{};
+  std::condition_variable _queue_condition{};
+  std::condition_variable _idle_condition{};
+  std::thread _thread;
+};
+
+}  // namespace opossum
@@ -1,6 +1,16 @@
-#include <unordered_set>
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <iterator>
+#include <string>
+#include <type_traits>
+#include <unordered_map>
+#include <utility>
+#include <vector>
 
+#include "bit_packed_integer_vector.hpp"
 #include "dictionary_segment.hpp"
+#include "resolve_attribute_vector.hpp"
 #include "type_cast.hpp"
 #include "value_segment.hpp"
 
@@ -8,55 +18,222 @@
 
 namespace opossum {
 
+namespace {
+
+// Reads the entries of a sorted dictionary in order. Front-coded strings are decoded incrementally from their
+// predecessor instead of decoding their block for each entry.
+template <typename T>
+class DictionaryCursor {
+ public:
+  explicit DictionaryCursor(const DictionaryVector<T>& dictionary) : _dictionary{dictionary} { _read(); }
+
+  bool at_end() const { return _index == _dictionary.size(); }
+  size_t index() const { return _index; }
+  const T& value() const { return _value; }
+
+  void advance() {
+    ++_index;
+    _read();
+  }
+
+ protected:
+  void _read() {
+    if (at_end()) {
+      return;
+    }
+    if constexpr (std::is_same_v<T, std::string>) {
+      _value.resize(_dictionary.prefix_lengths()[_index]);
+      _value.append(_dictionary.entries()[_index]);
+    } else {
+      _value = _dictionary[_index];
+    }
+  }
+
+  const DictionaryVector<T>& _dictionary;
+  size_t _index{0};
+  T _value{};
+};
+
+}  // namespace
+
 template <typename T>
 DictionarySegment<T>::DictionarySegment(const std::shared_ptr<AbstractSegment>& abstract_segment) {
   const auto& segment_values = std::static_pointer_cast<ValueSegment<T>>(abstract_segment)->values();
-  for (auto index = ChunkOffset{0}; index < abstract_segment->size(); index++) {
+  const auto segment_size = segment_values.size();
+
+  // Sorted input, e.g., from clustered columns, needs neither hashing nor sorting. The value id simply increases
+  // whenever the value changes.
+  if (std::is_sorted(segment_values.cbegin(), segment_values.cend())) {
+    auto value_ids = std::vector<ValueID>(segment_size);
+    for (auto index = size_t{0}; index < segment_size; ++index) {
+      if (index == 0 || segment_values[index - 1] != segment_values[index]) {
+        _dictionary.push_back(segment_values[index]);
+      }
+      value_ids[index] = static_cast<ValueID>(_dictionary.size() - 1);
+    }
+    _dictionary.shrink_to_fit();
+
+    _attribute_vector = _create_attribute_vector(_dictionary.size());
+    resolve_attribute_vector(*_attribute_vector, [&](auto& attribute_vector) {
+      attribute_vector.reserve(segment_size);
+      for (auto index = size_t{0}; index < segment_size; ++index) {
+        attribute_vector.set(index, value_ids[index]);
+      }
+    });
+    return;
+  }
+
+  // Otherwise, collect the distinct values with a hash table. For each row, we remember the position of its value in
+  // the order of first occurrence, so that rows do not have to be looked up again once the distinct values are sorted.
+  // Strings are referenced as std::string_views into the value segment and are only copied into the dictionary.
+  using ValueType = typename ValueVector<T>::value_type;
+  auto first_occurrence_positions = std::unordered_map<ValueType, ValueID::base_type>{};
+  auto distinct_values = std::vector<ValueType>{};
+  auto row_positions = std::vector<ValueID::base_type>(segment_size);
+  for (auto index = size_t{0}; index < segment_size; ++index) {
     const auto& value = segment_values[index];
-    _dictionary.push_back(value);
+    const auto [position_it, inserted] =
+        first_occurrence_positions.try_emplace(value, static_cast<ValueID::base_type>(distinct_values.size()));
+    if (inserted) {
+      distinct_values.push_back(value);
+    }
+    row_positions[index] = position_it->second;
+  }
+
+  // Sort only the distinct values and translate the positions of first occurrence into value ids.
+  std::sort(distinct_values.begin(), distinct_values.end());
+
+  auto value_ids_by_position = std::vector<ValueID>(distinct_values.size());
+  for (const auto& [value, position] : first_occurrence_positions) {
+    const auto value_it = std::lower_bound(distinct_values.cbegin(), distinct_values.cend(), value);
+    value_ids_by_position[position] = static_cast<ValueID>(std::distance(distinct_values.cbegin(), value_it));
   }
 
-  // use standard library functions to remove duplicate values from dictionary
-  // sorted dictionary also allows us to be more efficient in element lookup
-  std::sort(begin(_dictionary), end(_dictionary));
-  const auto& end_it = std::unique(begin(_dictionary), end(_dictionary));
-  _dictionary.erase(end_it, _dictionary.end());
-  _dictionary.shrink_to_fit();
-
-  // determine how many bits are needed to encode based on dictionary size
-  const auto num_bits = std::ceil(std::log2(_dictionary.size()));
-  Assert(num_bits <= 32, "The dictionary is too large for this compression algorithm!");
-
-  // initialize attribute vector with the smallest applicable integer type
-  if (num_bits <= 8) {
-    _attribute_vector = std::make_shared<FixedWidthIntegerVector<uint8_t>>();
-  } else if (num_bits <= 16) {
-    _attribute_vector = std::make_shared<FixedWidthIntegerVector<uint16_t>>();
+  if constexpr (std::is_same_v<T, std::string>) {
+    _dictionary.reserve(distinct_values.size());
+    for (const auto& value : distinct_values) {
+      _dictionary.push_back(value);
+    }
+    _dictionary.shrink_to_fit();
   } else {
-    DebugAssert(num_bits <= 32, "We do not support any integers that require more than 32 bits for storage.");
-    _attribute_vector = std::make_shared<FixedWidthIntegerVector<uint32_t>>();
+    _dictionary = std::move(distinct_values);
   }
 
-  // encode segment
-  for (auto index = ChunkOffset{0}; index < abstract_segment->size(); ++index) {
-    const auto& value = segment_values[index];
-    _attribute_vector->set(index, get_encoded_value(value));
+  _attribute_vector = _create_attribute_vector(_dictionary.size());
+  resolve_attribute_vector(*_attribute_vector, [&](auto& attribute_vector) {
+    attribute_vector.reserve(segment_size);
+    for (auto index = size_t{0}; index < segment_size; ++index) {
+      attribute_vector.set(index, value_ids_by_position[row_positions[index]]);
+    }
+  });
+}
+
+template <typename T>
+DictionarySegment<T>::DictionarySegment(DictionaryVector<T> dictionary,
+                                        const std::shared_ptr<AbstractAttributeVector>& attribute_vector)
+    : _dictionary{std::move(dictionary)}, _attribute_vector{attribute_vector} {}
+
+size_t attribute_vector_bits(const size_t dictionary_size) {
+  // determine how many bits are needed to encode the largest value id (at least one, even for a single value)
+  const auto largest_value_id = dictionary_size > 1 ? dictionary_size - 1 : size_t{1};
+  const auto required_bits = static_cast<size_t>(std::bit_width(largest_value_id));
+  Assert(required_bits <= 32, "The dictionary is too large for this compression algorithm!");
+
+  const auto byte_aligned_bits = required_bits <= 8 ? size_t{8} : (required_bits <= 16 ? size_t{16} : size_t{32});
+
+  // Bit-packed value ids are more expensive to decode than byte-aligned ones. We only pay that price if bit-packing
+  // saves at least a quarter of the attribute vector's memory, e.g., for 9 instead of 16 bits but not for 15 bits.
+  if (required_bits * 4 <= byte_aligned_bits * 3) {
+    return required_bits;
+  }
+  return byte_aligned_bits;
+}
+
+template <typename T>
+std::shared_ptr<AbstractAttributeVector> DictionarySegment<T>::_create_attribute_vector(const size_t dictionary_size) {
+  const auto bits = attribute_vector_bits(dictionary_size);
+  if (bits == 8) {
+    return std::make_shared<FixedWidthIntegerVector<uint8_t>>();
+  } else if (bits == 16) {
+    return std::make_shared<FixedWidthIntegerVector<uint16_t>>();
+  } else if (bits == 32) {
+    return std::make_shared<FixedWidthIntegerVector<uint32_t>>();
   }
+  return std::make_shared<BitPackedIntegerVector>(static_cast<uint8_t>(bits));
 }
 
 template <typename T>
-const ValueID DictionarySegment<T>::get_encoded_value(const T& raw_value) const {
-  /* "lower_bound" is more efficient than "find" and can be used as dictionary is sorted & immutable
-   * "lower_bound" would return a valid pointer to an element smaller than raw_value if raw_value is not in _dictionary,
-   * however, we are certain that any time this function is called, we only call it with a raw_value in _dictionary
-   */
-  const auto target_it = std::lower_bound(_dictionary.begin(), _dictionary.end(), raw_value);
-  return static_cast<ValueID>(std::distance(_dictionary.begin(), target_it));
+std::shared_ptr<DictionarySegment<T>> DictionarySegment<T>::merge(
+    const std::vector<std::shared_ptr<const DictionarySegment<T>>>& segments) {
+  // Merge the dictionaries and remember the merged value id of each entry of each input dictionary.
+  auto cursors = std::vector<DictionaryCursor<T>>{};
+  auto value_id_mappings = std::vector<std::vector<ValueID>>{};
+  auto merged_size = size_t{0};
+  for (const auto& segment : segments) {
+    cursors.emplace_back(segment->dictionary());
+    value_id_mappings.emplace_back(segment->dictionary().size());
+    merged_size += segment->dictionary().size();
+  }
+
+  auto dictionary = DictionaryVector<T>{};
+  dictionary.reserve(merged_size);
+  while (true) {
+    // The number of segments is small, so the smallest current entry is searched linearly.
+    const T* smallest_value = nullptr;
+    for (const auto& cursor : cursors) {
+      if (!cursor.at_end() && (!smallest_value || cursor.value() < *smallest_value)) {
+        smallest_value = &cursor.value();
+      }
+    }
+    if (!smallest_value) {
+      break;
+    }
+
+    dictionary.push_back(*smallest_value);
+    const auto value_id = static_cast<ValueID>(dictionary.size() - 1);
+    // Copy the value, as advancing the cursor that holds it overwrites it.
+    const auto value = T{*smallest_value};
+    for (auto segment_index = size_t{0}; segment_index < cursors.size(); ++segment_index) {
+      auto& cursor = cursors[segment_index];
+      if (!cursor.at_end() && cursor.value() == value) {
+        value_id_mappings[segment_index][cursor.index()] = value_id;
+        cursor.advance();
+      }
+    }
+  }
+  dictionary.shrink_to_fit();
+
+  // Translate the value ids of each segment, decoding them block-wise.
+  constexpr auto DECODE_BLOCK_SIZE = size_t{1024};
+  auto attribute_vector = _create_attribute_vector(dictionary.size());
+  resolve_attribute_vector(*attribute_vector, [&](auto& typed_attribute_vector) {
+    auto row_count = size_t{0};
+    for (const auto& segment : segments) {
+      row_count += segment->attribute_vector()->size();
+    }
+    typed_attribute_vector.reserve(row_count);
+
+    auto value_ids = std::array<ValueID, DECODE_BLOCK_SIZE>{};
+    auto row_id = size_t{0};
+    for (auto segment_index = size_t{0}; segment_index < segments.size(); ++segment_index) {
+      const auto& input_attribute_vector = *segments[segment_index]->attribute_vector();
+      const auto& value_id_mapping = value_id_mappings[segment_index];
+      for (auto begin = size_t{0}; begin < input_attribute_vector.size(); begin += DECODE_BLOCK_SIZE) {
+        const auto end = std::min(begin + DECODE_BLOCK_SIZE, input_attribute_vector.size());
+        input_attribute_vector.decode(begin, end, value_ids.data());
+        for (auto index = size_t{0}; index < end - begin; ++index) {
+          typed_attribute_vector.set(row_id++, value_id_mapping[value_ids[index]]);
+        }
+      }
+    }
+  });
+
+  return std::make_shared<DictionarySegment<T>>(std::move(dictionary), attribute_vector);
 }
 
 template <typename T>
 AllTypeVariant DictionarySegment<T>::operator[](const ChunkOffset chunk_offset) const {
-  return _dictionary[_attribute_vector->get(chunk_offset)];
+  return T{_dictionary[_attribute_vector->get(chunk_offset)]};
 }
 
 template <typename T>
@@ -70,7 +247,7 @@ void DictionarySegment<T>::append(const AllTypeVariant& value) {
 }
 
 template <typename T>
-const std::vector<T>& DictionarySegment<T>::dictionary() const {
+const DictionaryVector<T>& DictionarySegment<T>::dictionary() const {
   return _dictionary;
 }
 
@@ -81,18 +258,23 @@ std::shared_ptr<const AbstractAttributeVector> DictionarySegment<T>::attribute_v
 
 template <typename T>
 const T DictionarySegment<T>::value_of_value_id(const ValueID value_id) const {
-  return _dictionary.at(value_id);
+  return T{_dictionary.at(value_id)};
 }
 
 template <typename T>
 ValueID DictionarySegment<T>::lower_bound(const T value) const {
-  const auto& target_it = std::lower_bound(begin(_dictionary), end(_dictionary), value);
+  auto value_id = size_t{};
+  if constexpr (std::is_same_v<T, std::string>) {
+    value_id = _dictionary.lower_bound(value);
+  } else {
+    value_id = std::distance(_dictionary.cbegin(), std::lower_bound(_dictionary.cbegin(), _dictionary.cend(), value));
+  }
 
-  if (target_it == _dictionary.end()) {
+  if (value_id == _dictionary.size()) {
     return INVALID_VALUE_ID;
   }
 
-  return static_cast<ValueID>(std::distance(_dictionary.begin(), target_it));
+  return static_cast<ValueID>(value_id);
 }
 
 template <typename T>
@@ -102,13 +284,18 @@ ValueID DictionarySegment<T>::lower_bound(const AllTypeVariant& value) const {
 
 template <typename T>
 ValueID DictionarySegment<T>::upper_bound(const T value) const {
-  const auto& target_it = std::upper_bound(begin(_dictionary), end(_dictionary), value);
+  auto value_id = size_t{};
+  if constexpr (std::is_same_v<T, std::string>) {
+    value_id = _dictionary.upper_bound(value);
+  } else {
+    value_id = std::distance(_dictionary.cbegin(), std::upper_bound(_dictionary.cbegin(), _dictionary.cend(), value));
+  }
 
-  if (target_it == _dictionary.end()) {
+  if (value_id == _dictionary.size()) {
     return INVALID_VALUE_ID;
   }
 
-  return static_cast<ValueID>(std::distance(_dictionary.begin(), target_it));
+  return static_cast<ValueID>(value_id);
 }
 
 template <typename T>
@@ -128,7 +315,13 @@ ChunkOffset DictionarySegment<T>::size() const {
 
 template <typename T>
 size_t DictionarySegment<T>::estimate_memory_usage() const {
-  return _dictionary.size() * sizeof(T) + _attribute_vector->size() * _attribute_vector->width();
+  auto dictionary_memory_usage = size_t{};
+  if constexpr (std::is_same_v<T, std::string>) {
+    dictionary_memory_usage = _dictionary.estimate_memory_usage();
+  } else {
+    dictionary_memory_usage = _dictionary.capacity() * sizeof(T);
+  }
+  return dictionary_memory_usage + _attribute_vector->estimate_memory_usage();
 }
 
 EXPLICITLY_INSTANTIATE_DATA_TYPES(DictionarySegment);
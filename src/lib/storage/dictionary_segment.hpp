@@ -4,6 +4,7 @@
 #include <limits>
 #include <memory>
 #include <string>
+#include <type_traits>
 #include <utility>
 #include <vector>
 
@@ -12,6 +13,8 @@
 #include "types.hpp"
 
 #include "fixed_width_integer_vector.hpp"
+#include "front_coded_dictionary.hpp"
+#include "mappable_vector.hpp"
 
 namespace opossum {
 
@@ -21,6 +24,15 @@ class AbstractAttributeVector;
 // types (uint8_t, uint16_t) since after a down-cast INVALID_VALUE_ID will look like their numeric_limit::max().
 constexpr ValueID INVALID_VALUE_ID{std::numeric_limits<ValueID::base_type>::max()};
 
+// Sorted string dictionaries are front coded, all other dictionaries are plain vectors. Both may reference a
+// memory-mapped file.
+template <typename T>
+using DictionaryVector = std::conditional_t<std::is_same_v<T, std::string>, FrontCodedDictionary, MappableVector<T>>;
+
+// Returns the number of bits per value id that the attribute vector of a dictionary with the given size uses, i.e.,
+// the bit width for bit-packed vectors and 8, 16, or 32 otherwise.
+size_t attribute_vector_bits(const size_t dictionary_size);
+
 // Dictionary is a specific segment type that stores all its values in a vector
 template <typename T>
 class DictionarySegment : public AbstractSegment {
@@ -30,6 +42,16 @@ class DictionarySegment : public AbstractSegment {
    */
   explicit DictionarySegment(const std::shared_ptr<AbstractSegment>& abstract_segment);
 
+  // Creates a Dictionary segment from an existing dictionary and attribute vector, e.g., when reading a serialized
+  // segment.
+  DictionarySegment(DictionaryVector<T> dictionary, const std::shared_ptr<AbstractAttributeVector>& attribute_vector);
+
+  // Creates a Dictionary segment that holds the rows of the given segments one after another. Their sorted dictionaries
+  // are merged in a single pass, and the value ids of each segment are translated to the merged dictionary, so rows
+  // are neither decoded nor looked up.
+  static std::shared_ptr<DictionarySegment<T>> merge(
+      const std::vector<std::shared_ptr<const DictionarySegment<T>>>& segments);
+
   // Return the value at a certain position. If you want to write efficient operators, back off!
   AllTypeVariant operator[](const ChunkOffset chunk_offset) const override;
 
@@ -39,8 +61,8 @@ class DictionarySegment : public AbstractSegment {
   // Dictionary segments are immutable.
   void append(const AllTypeVariant& value) override;
 
-  // Returns an underlying dictionary.
-  const std::vector<T>& dictionary() const;
+  // Returns an underlying dictionary. For strings, this is a FrontCodedDictionary.
+  const DictionaryVector<T>& dictionary() const;
 
   // Returns an underlying data structure.
   std::shared_ptr<const AbstractAttributeVector> attribute_vector() const;
@@ -72,10 +94,11 @@ class DictionarySegment : public AbstractSegment {
   size_t estimate_memory_usage() const final;
 
  protected:
-  std::vector<T> _dictionary{};  // contains unique values from ValueSegment - index is encoded value
+  DictionaryVector<T> _dictionary{};  // contains unique values from ValueSegment - index is encoded value
   std::shared_ptr<AbstractAttributeVector> _attribute_vector{};  // contains encoded values
 
-  const ValueID get_encoded_value(const T& raw_value) const;
+  // Chooses the attribute vector with the smallest memory footprint that is still cheap to decode.
+  static std::shared_ptr<AbstractAttributeVector> _create_attribute_vector(const size_t dictionary_size);
 };
 
 }  // namespace opossum
@@ -0,0 +1,222 @@
+#include "encoding_advisor.hpp"
+
+#include <algorithm>
+#include <bit>
+#include <cmath>
+#include <limits>
+#include <memory>
+#include <optional>
+#include <string>
+#include <tuple>
+#include <type_traits>
+#include <unordered_map>
+#include <utility>
+
+#include "dictionary_segment.hpp"
+#include "frame_of_reference_segment.hpp"
+#include "resolve_type.hpp"
+#include "value_segment.hpp"
+#include "utils/assert.hpp"
+
+namespace opossum {
+
+namespace {
+
+// The sample consists of evenly spread windows of consecutive rows, so that runs and sortedness can be observed.
+constexpr auto SAMPLE_WINDOW_COUNT = size_t{16};
+constexpr auto SAMPLE_WINDOW_SIZE = size_t{256};
+
+// Memory of a std::string that exceeds the small string optimization, as stored by RunLengthSegment.
+constexpr auto SMALL_STRING_CAPACITY = size_t{15};
+
+// On sorted segments, run-length and frame-of-reference encoding are chosen over dictionary encoding unless the
+// dictionary segment is smaller by more than this factor. Their scans match whole runs or blocks at once, while the
+// value ids of a dictionary segment are compared row by row.
+constexpr auto SORTED_ENCODING_TOLERANCE = 1.5;
+
+template <typename T>
+SegmentCharacteristics analyze_values(const ValueVector<T>& values) {
+  auto characteristics = SegmentCharacteristics{};
+  const auto row_count = values.size();
+  characteristics.row_count = row_count;
+  if (row_count == 0) {
+    return characteristics;
+  }
+
+  // Small segments are analyzed completely.
+  const auto window_count = row_count <= SAMPLE_WINDOW_COUNT * SAMPLE_WINDOW_SIZE ? size_t{1} : SAMPLE_WINDOW_COUNT;
+  const auto window_size = window_count == 1 ? row_count : SAMPLE_WINDOW_SIZE;
+  const auto window_stride = row_count / window_count;
+
+  using ValueType = typename ValueVector<T>::value_type;
+  auto value_frequencies = std::unordered_map<ValueType, size_t>{};
+  auto sample_run_count = size_t{0};
+  auto sample_string_length = size_t{0};
+  for (auto window_index = size_t{0}; window_index < window_count; ++window_index) {
+    const auto window_begin = window_index * window_stride;
+    const auto window_end = window_begin + window_size;
+
+    // a window that starts with a smaller value than the previous window ended with breaks the sort order
+    if (window_index > 0 && values[window_begin] < values[window_begin - window_stride + window_size - 1]) {
+      characteristics.is_sorted = false;
+    }
+
+    for (auto index = window_begin; index < window_end; ++index) {
+      const auto& value = values[index];
+      ++value_frequencies[value];
+      if (index == window_begin || values[index - 1] != value) {
+        ++sample_run_count;
+      }
+      if (index > window_begin && value < values[index - 1]) {
+        characteristics.is_sorted = false;
+      }
+      if constexpr (std::is_same_v<T, std::string>) {
+        sample_string_length += value.size();
+      }
+    }
+  }
+
+  const auto sample_size = window_count * window_size;
+  if (sample_size == row_count) {
+    characteristics.distinct_count = value_frequencies.size();
+    characteristics.run_count = sample_run_count;
+  } else {
+    // Values that occur only once in the sample are likely to occur rarely in the segment, too. Following the GEE
+    // estimator by Charikar et al., we scale their number by the square root of the inverse sampling ratio.
+    // If the sample does not contain any duplicates, the column is most likely a key column.
+    const auto singleton_count = static_cast<size_t>(std::count_if(
+        value_frequencies.cbegin(), value_frequencies.cend(), [](const auto& entry) { return entry.second == 1; }));
+    const auto scale = static_cast<double>(row_count) / static_cast<double>(sample_size);
+    const auto estimated_distinct_count = std::sqrt(scale) * static_cast<double>(singleton_count) +
+                                          static_cast<double>(value_frequencies.size() - singleton_count);
+    characteristics.distinct_count = singleton_count == sample_size
+                                         ? row_count
+                                         : std::min(static_cast<size_t>(estimated_distinct_count), row_count);
+
+    // Each value occupies at least one run.
+    const auto estimated_run_count = static_cast<size_t>(scale * static_cast<double>(sample_run_count));
+    characteristics.run_count = std::clamp(estimated_run_count, characteristics.distinct_count, row_count);
+  }
+
+  if constexpr (std::is_same_v<T, std::string>) {
+    characteristics.average_string_length = sample_string_length / sample_size;
+  }
+
+  // A frame-of-reference segment cannot store offsets of more than 32 bits. As choosing it for such values would fail,
+  // the value range is not estimated but determined for all blocks, which is cheap for integers.
+  if constexpr (std::is_integral_v<T>) {
+    using UnsignedT = std::make_unsigned_t<T>;
+    constexpr auto block_size = size_t{FrameOfReferenceSegment<T>::BLOCK_SIZE};
+    auto block_value_range = uint64_t{0};
+    for (auto block_begin = size_t{0}; block_begin < row_count; block_begin += block_size) {
+      const auto block_end = std::min(block_begin + block_size, row_count);
+      const auto [min_it, max_it] = std::minmax_element(values.cbegin() + block_begin, values.cbegin() + block_end);
+      block_value_range =
+          std::max(block_value_range, uint64_t{static_cast<UnsignedT>(*max_it) - static_cast<UnsignedT>(*min_it)});
+    }
+    characteristics.block_value_range = block_value_range;
+  }
+
+  return characteristics;
+}
+
+}  // namespace
+
+SegmentCharacteristics analyze_segment(const std::string& column_type,
+                                       const std::shared_ptr<AbstractSegment>& value_segment) {
+  auto characteristics = SegmentCharacteristics{};
+  resolve_data_type(column_type, [&](const auto data_type_t) {
+    using ColumnDataType = typename decltype(data_type_t)::type;
+    const auto typed_segment = std::dynamic_pointer_cast<ValueSegment<ColumnDataType>>(value_segment);
+    Assert(typed_segment, "Only value segments of the column's type can be analyzed.");
+    characteristics = analyze_values<ColumnDataType>(typed_segment->values());
+  });
+  return characteristics;
+}
+
+std::optional<size_t> estimate_encoded_memory_usage(const EncodingType encoding_type, const std::string& column_type,
+                                                    const SegmentCharacteristics& characteristics) {
+  auto memory_usage = std::optional<size_t>{};
+  resolve_data_type(column_type, [&](const auto data_type_t) {
+    using ColumnDataType = typename decltype(data_type_t)::type;
+    const auto row_count = characteristics.row_count;
+
+    // Strings are stored with their characters and an offset in a StringHeap.
+    auto stored_value_size = sizeof(ColumnDataType);
+    if constexpr (std::is_same_v<ColumnDataType, std::string>) {
+      stored_value_size = characteristics.average_string_length + sizeof(size_t);
+    }
+
+    switch (encoding_type) {
+      case EncodingType::Unencoded:
+        memory_usage = row_count * stored_value_size;
+        return;
+      case EncodingType::Dictionary: {
+        // front coding of string dictionaries is not taken into account
+        const auto value_id_bits = attribute_vector_bits(characteristics.distinct_count);
+        memory_usage = characteristics.distinct_count * stored_value_size + (row_count * value_id_bits + 7) / 8;
+        return;
+      }
+      case EncodingType::RunLength: {
+        auto run_value_size = sizeof(ColumnDataType);
+        if constexpr (std::is_same_v<ColumnDataType, std::string>) {
+          if (characteristics.average_string_length > SMALL_STRING_CAPACITY) {
+            run_value_size += characteristics.average_string_length;
+          }
+        }
+        memory_usage = characteristics.run_count * (run_value_size + sizeof(ChunkOffset));
+        return;
+      }
+      case EncodingType::FrameOfReference:
+        if constexpr (std::is_integral_v<ColumnDataType>) {
+          const auto value_range = characteristics.block_value_range.value_or(0);
+          if (value_range > std::numeric_limits<ValueID::base_type>::max()) {
+            return;
+          }
+          const auto offset_bits = std::max(static_cast<size_t>(std::bit_width(value_range)), size_t{1});
+          const auto block_size = size_t{FrameOfReferenceSegment<ColumnDataType>::BLOCK_SIZE};
+          const auto block_count = (row_count + block_size - 1) / block_size;
+          memory_usage = block_count * sizeof(ColumnDataType) + (row_count * offset_bits + 63) / 64 * sizeof(uint64_t);
+        }
+        return;
+      case EncodingType::Automatic:
+        Fail("Automatic is not an encoding of its own.");
+    }
+  });
+  return memory_usage;
+}
+
+EncodingAdvice advise_encoding(const std::string& column_type, const std::shared_ptr<AbstractSegment>& value_segment) {
+  auto advice = EncodingAdvice{};
+  advice.characteristics = analyze_segment(column_type, value_segment);
+  advice.estimated_memory_usage = *estimate_encoded_memory_usage(EncodingType::Unencoded, column_type,
+                                                                 advice.characteristics);
+
+  // ordered from cheapest to most expensive access
+  for (const auto encoding_type : {EncodingType::FrameOfReference, EncodingType::Dictionary, EncodingType::RunLength}) {
+    const auto memory_usage = estimate_encoded_memory_usage(encoding_type, column_type, advice.characteristics);
+    if (memory_usage && *memory_usage < advice.estimated_memory_usage) {
+      advice.encoding_type = encoding_type;
+      advice.estimated_memory_usage = *memory_usage;
+    }
+  }
+
+  if (advice.characteristics.is_sorted && advice.encoding_type == EncodingType::Dictionary) {
+    const auto max_memory_usage = static_cast<double>(advice.estimated_memory_usage) * SORTED_ENCODING_TOLERANCE;
+    auto sorted_advice = std::optional<std::pair<EncodingType, size_t>>{};
+    for (const auto encoding_type : {EncodingType::FrameOfReference, EncodingType::RunLength}) {
+      const auto memory_usage = estimate_encoded_memory_usage(encoding_type, column_type, advice.characteristics);
+      if (memory_usage && static_cast<double>(*memory_usage) <= max_memory_usage &&
+          (!sorted_advice || *memory_usage < sorted_advice->second)) {
+        sorted_advice.emplace(encoding_type, *memory_usage);
+      }
+    }
+    if (sorted_advice) {
+      std::tie(advice.encoding_type, advice.estimated_memory_usage) = *sorted_advice;
+    }
+  }
+
+  return advice;
+}
+
+}  // namespace opossum
@@ -0,0 +1,49 @@
+#pragma once
+
+#include <memory>
+#include <optional>
+#include <string>
+
+#include "types.hpp"
+
+namespace opossum {
+
+class AbstractSegment;
+
+// Characteristics of a ValueSegment that determine which encoding is the cheapest. Apart from the row count and the
+// value range, they are estimated from a sample of the segment.
+struct SegmentCharacteristics {
+  size_t row_count{0};
+  size_t distinct_count{0};
+  size_t run_count{0};
+  bool is_sorted{true};
+  // average number of characters per value, only set for string columns
+  size_t average_string_length{0};
+  // largest difference between two values within a block of FrameOfReferenceSegment::BLOCK_SIZE rows, only set for
+  // integer columns
+  std::optional<uint64_t> block_value_range{};
+};
+
+// The encoding chosen for a segment, based on its characteristics and the estimated memory usage of each encoding.
+struct EncodingAdvice {
+  EncodingType encoding_type{EncodingType::Unencoded};
+  SegmentCharacteristics characteristics{};
+  size_t estimated_memory_usage{0};
+};
+
+// Analyzes a ValueSegment of the given column type.
+SegmentCharacteristics analyze_segment(const std::string& column_type,
+                                       const std::shared_ptr<AbstractSegment>& value_segment);
+
+// Estimates the memory usage of a segment with the given characteristics in the given encoding. Returns std::nullopt
+// if the encoding cannot be used for the column type or the values.
+std::optional<size_t> estimate_encoded_memory_usage(const EncodingType encoding_type, const std::string& column_type,
+                                                    const SegmentCharacteristics& characteristics);
+
+// Chooses the encoding with the smallest estimated memory usage for a ValueSegment of the given column type. If
+// several encodings are equally small, the one that is cheaper to access is chosen, i.e., unencoded before
+// frame-of-reference before dictionary before run-length encoding. For sorted segments, frame-of-reference and
+// run-length encoding are preferred to a slightly smaller dictionary encoding, as they are scanned block- or run-wise.
+EncodingAdvice advise_encoding(const std::string& column_type, const std::shared_ptr<AbstractSegment>& value_segment);
+
+}  // namespace opossum
@@ -1,11 +1,12 @@
 #include "fixed_width_integer_vector.hpp"
 
+#include <algorithm>
+#include <utility>
+
 namespace opossum {
 
 template <typename T>
-ValueID FixedWidthIntegerVector<T>::get(const size_t index) const {
-  return static_cast<ValueID>(_indices.at(index));
-}
+FixedWidthIntegerVector<T>::FixedWidthIntegerVector(MappableVector<T> values) : _indices{std::move(values)} {}
 
 template <typename T>
 void FixedWidthIntegerVector<T>::set(const size_t index, const ValueID value_id) {
@@ -14,10 +15,15 @@ void FixedWidthIntegerVector<T>::set(const size_t index, const ValueID value_id)
   if (index == size()) {
     _indices.push_back(value_id);
   } else {
-    _indices[index] = value_id;
+    _indices.mutable_data()[index] = value_id;
   }
 }
 
+template <typename T>
+void FixedWidthIntegerVector<T>::reserve(const size_t size) {
+  _indices.reserve(size);
+}
+
 template <typename T>
 size_t FixedWidthIntegerVector<T>::size() const {
   return _indices.size();
@@ -28,6 +34,23 @@ AttributeVectorWidth FixedWidthIntegerVector<T>::width() const {
   return sizeof(T);
 }
 
+template <typename T>
+size_t FixedWidthIntegerVector<T>::estimate_memory_usage() const {
+  return _indices.size() * sizeof(T);
+}
+
+template <typename T>
+const MappableVector<T>& FixedWidthIntegerVector<T>::values() const {
+  return _indices;
+}
+
+template <typename T>
+void FixedWidthIntegerVector<T>::_on_decode(const size_t begin_index, const size_t end_index, ValueID* output) const {
+  const auto indices_begin = _indices.cbegin();
+  std::transform(indices_begin + begin_index, indices_begin + end_index, output,
+                 [](const T value_id) { return ValueID{value_id}; });
+}
+
 BOOST_PP_SEQ_FOR_EACH(EXPLICIT_INSTANTIATION, FixedWidthIntegerVector, (uint8_t)(uint16_t)(uint32_t))
 
 }  // namespace opossum
@@ -6,26 +6,47 @@
 #include "utils/assert.hpp"
 
 #include "abstract_attribute_vector.hpp"
+#include "mappable_vector.hpp"
 
 namespace opossum {
 
+// FixedWidthIntegerVector stores each value id in an unsigned integer of type T (uint8_t, uint16_t, or uint32_t).
 template <typename T>
-class FixedWidthIntegerVector : public AbstractAttributeVector {
+class FixedWidthIntegerVector final : public AbstractAttributeVector {
  public:
+  FixedWidthIntegerVector() = default;
+
+  // Creates a vector that holds the given value ids, which may reference a memory-mapped file.
+  explicit FixedWidthIntegerVector(MappableVector<T> values);
+
   // returns the value id at a given position
-  ValueID get(const size_t index) const override;
+  ValueID get(const size_t index) const override {
+    DebugAssert(index < _indices.size(), "Index is out of bounds.");
+    return static_cast<ValueID>(_indices[index]);
+  }
 
   // sets the value id at a given position
   void set(const size_t index, const ValueID value_id) override;
 
+  // reserves space for the given number of value ids
+  void reserve(const size_t size);
+
   // returns the number of values
   size_t size() const override;
 
   // returns the width of biggest value id in bytes
   AttributeVectorWidth width() const override;
 
+  // returns the calculated memory usage
+  size_t estimate_memory_usage() const override;
+
+  // Returns all stored value ids. Loops over these values are as cheap as loops over a plain vector.
+  const MappableVector<T>& values() const;
+
  protected:
-  std::vector<T> _indices{};
+  void _on_decode(const size_t begin_index, const size_t end_index, ValueID* output) const override;
+
+  MappableVector<T> _indices{};
 };
 
 }  // namespace opossum
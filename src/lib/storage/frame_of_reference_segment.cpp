@@ -0,0 +1,156 @@
+#include "frame_of_reference_segment.hpp"
+
+#include <algorithm>
+#include <bit>
+#include <limits>
+#include <memory>
+#include <optional>
+#include <utility>
+#include <vector>
+
+#include "bit_packed_integer_vector.hpp"
+#include "type_cast.hpp"
+#include "utils/assert.hpp"
+#include "utils/with_comparator.hpp"
+#include "validity_bitmap.hpp"
+#include "value_segment.hpp"
+
+namespace opossum {
+
+template <typename T>
+FrameOfReferenceSegment<T>::FrameOfReferenceSegment(const std::shared_ptr<AbstractSegment>& abstract_segment) {
+  const auto& segment_values = std::static_pointer_cast<ValueSegment<T>>(abstract_segment)->values();
+  const auto segment_size = segment_values.size();
+  const auto block_count = (segment_size + BLOCK_SIZE - 1) / BLOCK_SIZE;
+
+  // The offsets are computed in the unsigned domain, where the difference of two values of T cannot overflow.
+  using UnsignedT = std::make_unsigned_t<T>;
+
+  // determine the minimum of each block and the largest offset, which defines the bit width of all offsets
+  _block_minima.reserve(block_count);
+  auto max_offset = uint64_t{0};
+  for (auto block_begin = size_t{0}; block_begin < segment_size; block_begin += BLOCK_SIZE) {
+    const auto block_end = std::min(block_begin + BLOCK_SIZE, segment_size);
+    const auto [min_it, max_it] =
+        std::minmax_element(segment_values.cbegin() + block_begin, segment_values.cbegin() + block_end);
+    _block_minima.push_back(*min_it);
+    max_offset = std::max(max_offset, uint64_t{static_cast<UnsignedT>(*max_it) - static_cast<UnsignedT>(*min_it)});
+  }
+  Assert(max_offset <= std::numeric_limits<ValueID::base_type>::max(),
+         "The value range within a block is too large for frame-of-reference encoding.");
+
+  const auto bit_width = std::max(static_cast<uint8_t>(std::bit_width(max_offset)), uint8_t{1});
+  _offsets = std::make_shared<BitPackedIntegerVector>(bit_width);
+  for (auto index = size_t{0}; index < segment_size; ++index) {
+    const auto block_minimum = _block_minima[index / BLOCK_SIZE];
+    const auto offset = static_cast<UnsignedT>(segment_values[index]) - static_cast<UnsignedT>(block_minimum);
+    _offsets->set(index, ValueID{static_cast<ValueID::base_type>(offset)});
+  }
+}
+
+template <typename T>
+FrameOfReferenceSegment<T>::FrameOfReferenceSegment(std::vector<T> block_minima,
+                                                    const std::shared_ptr<BitPackedIntegerVector>& offsets)
+    : _block_minima{std::move(block_minima)}, _offsets{offsets} {
+  Assert(_block_minima.size() == (_offsets->size() + BLOCK_SIZE - 1) / BLOCK_SIZE,
+         "The number of blocks does not match the number of offsets.");
+}
+
+template <typename T>
+AllTypeVariant FrameOfReferenceSegment<T>::operator[](const ChunkOffset chunk_offset) const {
+  return get(chunk_offset);
+}
+
+template <typename T>
+T FrameOfReferenceSegment<T>::get(const ChunkOffset chunk_offset) const {
+  Assert(chunk_offset < size(), "Position is out of bounds.");
+  using UnsignedT = std::make_unsigned_t<T>;
+  const auto block_minimum = static_cast<UnsignedT>(_block_minima[chunk_offset / BLOCK_SIZE]);
+  return static_cast<T>(block_minimum + static_cast<UnsignedT>(_offsets->get(chunk_offset)));
+}
+
+template <typename T>
+void FrameOfReferenceSegment<T>::append(const AllTypeVariant& value) {
+  Fail("Frame-of-reference segments are immutable, i.e., values cannot be appended.");
+}
+
+template <typename T>
+ChunkOffset FrameOfReferenceSegment<T>::size() const {
+  return static_cast<ChunkOffset>(_offsets->size());
+}
+
+template <typename T>
+size_t FrameOfReferenceSegment<T>::estimate_memory_usage() const {
+  return _block_minima.size() * sizeof(T) + _offsets->estimate_memory_usage();
+}
+
+template <typename T>
+const std::vector<T>& FrameOfReferenceSegment<T>::block_minima() const {
+  return _block_minima;
+}
+
+template <typename T>
+std::shared_ptr<const BitPackedIntegerVector> FrameOfReferenceSegment<T>::offsets() const {
+  return _offsets;
+}
+
+template <typename T>
+void FrameOfReferenceSegment<T>::scan(const ScanType scan_type, const T search_value, const ChunkID chunk_id,
+                                      PosList& matches, const ValidityBitmap* validity) const {
+  using UnsignedT = std::make_unsigned_t<T>;
+  const auto segment_size = size();
+  auto block_offsets = std::vector<ValueID>(BLOCK_SIZE);
+
+  // visits the valid rows of a block, skipping words of invalid rows at once
+  const auto for_each_row = [&](const ChunkOffset begin_offset, const ChunkOffset end_offset, const auto& functor) {
+    if (validity) {
+      validity->for_each_valid(begin_offset, end_offset, functor);
+    } else {
+      for (auto chunk_offset = begin_offset; chunk_offset < end_offset; ++chunk_offset) {
+        functor(chunk_offset);
+      }
+    }
+  };
+
+  with_comparator(scan_type, [&](auto comparator) {
+    for (auto block_index = size_t{0}; block_index < _block_minima.size(); ++block_index) {
+      const auto block_begin = static_cast<ChunkOffset>(block_index * BLOCK_SIZE);
+      const auto block_end = std::min(block_begin + BLOCK_SIZE, segment_size);
+      const auto block_minimum = _block_minima[block_index];
+
+      // If the search value cannot be expressed as an offset in this block, all values of the block are either larger
+      // (search value below the minimum) or smaller (search value beyond the largest possible offset) than it.
+      const auto search_offset = static_cast<uint64_t>(static_cast<UnsignedT>(search_value) -
+                                                       static_cast<UnsignedT>(block_minimum));
+      auto block_matches_entirely = std::optional<bool>{};
+      if (search_value < block_minimum) {
+        block_matches_entirely = comparator(1, 0);
+      } else if (search_offset > std::numeric_limits<ValueID::base_type>::max()) {
+        block_matches_entirely = comparator(0, 1);
+      }
+
+      if (block_matches_entirely) {
+        if (*block_matches_entirely) {
+          for_each_row(block_begin, block_end,
+                       [&](const ChunkOffset chunk_offset) { matches.push_back(RowID{chunk_id, chunk_offset}); });
+        }
+        continue;
+      }
+
+      // compare the offsets of the block with the offset of the search value
+      const auto typed_search_offset = static_cast<ValueID::base_type>(search_offset);
+      _offsets->decode(block_begin, block_end, block_offsets.data());
+      for_each_row(block_begin, block_end, [&](const ChunkOffset chunk_offset) {
+        if (comparator(static_cast<ValueID::base_type>(block_offsets[chunk_offset - block_begin]),
+                       typed_search_offset)) {
+          matches.push_back(RowID{chunk_id, chunk_offset});
+        }
+      });
+    }
+  });
+}
+
+template class FrameOfReferenceSegment<int32_t>;
+template class FrameOfReferenceSegment<int64_t>;
+
+}  // namespace opossum
@@ -0,0 +1,64 @@
+#pragma once
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "abstract_segment.hpp"
+#include "all_type_variant.hpp"
+#include "types.hpp"
+
+namespace opossum {
+
+class BitPackedIntegerVector;
+class ValidityBitmap;
+
+// FrameOfReferenceSegment is a segment type for integer columns with many distinct values but a narrow value range,
+// e.g., timestamps or increasing ids. The segment is split into blocks of BLOCK_SIZE rows. For each block, it stores
+// the minimum ("frame of reference"), and for each row the offset of its value to that minimum. The offsets are
+// bit-packed with the width of the largest offset. Offsets must fit into 32 bits.
+template <typename T>
+class FrameOfReferenceSegment : public AbstractSegment {
+ public:
+  static constexpr auto BLOCK_SIZE = ChunkOffset{2048};
+
+  // Creates a frame-of-reference encoded segment from a given value segment.
+  explicit FrameOfReferenceSegment(const std::shared_ptr<AbstractSegment>& abstract_segment);
+
+  // Creates a frame-of-reference encoded segment from existing blocks, e.g., when reading a serialized segment.
+  FrameOfReferenceSegment(std::vector<T> block_minima, const std::shared_ptr<BitPackedIntegerVector>& offsets);
+
+  // Return the value at a certain position. If you want to write efficient operators, back off!
+  AllTypeVariant operator[](const ChunkOffset chunk_offset) const override;
+
+  // Return the value at a certain position.
+  T get(const ChunkOffset chunk_offset) const;
+
+  // Frame-of-reference segments are immutable.
+  void append(const AllTypeVariant& value) override;
+
+  // Return the number of entries.
+  ChunkOffset size() const override;
+
+  // Returns the calculated memory usage.
+  size_t estimate_memory_usage() const final;
+
+  // Returns the minimum of each block.
+  const std::vector<T>& block_minima() const;
+
+  // Returns the offsets of all values to the minimum of their block.
+  std::shared_ptr<const BitPackedIntegerVector> offsets() const;
+
+  // Appends the positions of all rows whose value satisfies "value <scan_type> search_value" to matches. The search
+  // value is translated into an offset per block, so the rows are compared without being decoded. Blocks for which the
+  // search value lies outside of the representable range are accepted or rejected as a whole. Invalid rows, as given by
+  // an optional validity bitmap, are skipped.
+  void scan(const ScanType scan_type, const T search_value, const ChunkID chunk_id, PosList& matches,
+            const ValidityBitmap* validity = nullptr) const;
+
+ protected:
+  std::vector<T> _block_minima{};
+  std::shared_ptr<BitPackedIntegerVector> _offsets{};
+};
+
+}  // namespace opossum
@@ -0,0 +1,127 @@
+#include "front_coded_dictionary.hpp"
+
+#include <algorithm>
+#include <limits>
+#include <string>
+#include <string_view>
+#include <utility>
+
+#include "utils/assert.hpp"
+
+namespace opossum {
+
+FrontCodedDictionary::FrontCodedDictionary(StringHeap entries, MappableVector<uint8_t> prefix_lengths)
+    : _entries{std::move(entries)}, _prefix_lengths{std::move(prefix_lengths)} {
+  Assert(_entries.size() == _prefix_lengths.size(), "Each entry requires a prefix length.");
+}
+
+void FrontCodedDictionary::push_back(const std::string_view value) {
+  const auto index = size();
+  if (!_last_value) {
+    _last_value = empty() ? std::string{} : back();
+  }
+  const auto& last_value = *_last_value;
+
+  DebugAssert(index == 0 || last_value <= value, "Strings must be appended in sorted order.");
+
+  auto prefix_length = size_t{0};
+  if (index % BLOCK_SIZE != 0) {
+    const auto max_prefix_length =
+        std::min({last_value.size(), value.size(), size_t{std::numeric_limits<uint8_t>::max()}});
+    while (prefix_length < max_prefix_length && last_value[prefix_length] == value[prefix_length]) {
+      ++prefix_length;
+    }
+  }
+
+  _entries.push_back(value.substr(prefix_length));
+  _prefix_lengths.push_back(static_cast<uint8_t>(prefix_length));
+  _last_value->assign(value);
+}
+
+std::string FrontCodedDictionary::operator[](const size_t index) const {
+  // start with the complete first string of the block and apply the following suffixes up to the requested string
+  const auto block_begin = index / BLOCK_SIZE * BLOCK_SIZE;
+  auto value = std::string{_entries[block_begin]};
+  for (auto entry_index = block_begin + 1; entry_index <= index; ++entry_index) {
+    value.resize(_prefix_lengths[entry_index]);
+    value.append(_entries[entry_index]);
+  }
+  return value;
+}
+
+std::string FrontCodedDictionary::at(const size_t index) const {
+  Assert(index < size(), "Index is out of bounds.");
+  return (*this)[index];
+}
+
+std::string FrontCodedDictionary::front() const { return at(0); }
+
+std::string FrontCodedDictionary::back() const { return at(size() - 1); }
+
+size_t FrontCodedDictionary::size() const { return _prefix_lengths.size(); }
+
+bool FrontCodedDictionary::empty() const { return _prefix_lengths.empty(); }
+
+void FrontCodedDictionary::reserve(const size_t string_count) {
+  _entries.reserve(string_count);
+  _prefix_lengths.reserve(string_count);
+}
+
+void FrontCodedDictionary::shrink_to_fit() {
+  _entries.shrink_to_fit();
+  _prefix_lengths.shrink_to_fit();
+  _last_value.reset();
+}
+
+template <typename Predicate>
+size_t FrontCodedDictionary::_partition_point(const Predicate& is_beyond_search_value) const {
+  const auto dictionary_size = size();
+  const auto block_count = (dictionary_size + BLOCK_SIZE - 1) / BLOCK_SIZE;
+
+  // Find the first block whose first string is beyond the search value. The result lies in the block before it.
+  auto low = size_t{0};
+  auto high = block_count;
+  while (low < high) {
+    const auto middle = low + (high - low) / 2;
+    if (is_beyond_search_value(_entries[middle * BLOCK_SIZE])) {
+      high = middle;
+    } else {
+      low = middle + 1;
+    }
+  }
+
+  if (low == 0) {
+    return 0;
+  }
+
+  // decode the candidate block string by string
+  const auto block_begin = (low - 1) * BLOCK_SIZE;
+  const auto block_end = std::min(block_begin + BLOCK_SIZE, dictionary_size);
+  auto value = std::string{_entries[block_begin]};
+  for (auto index = block_begin + 1; index < block_end; ++index) {
+    value.resize(_prefix_lengths[index]);
+    value.append(_entries[index]);
+    if (is_beyond_search_value(value)) {
+      return index;
+    }
+  }
+  return block_end;
+}
+
+size_t FrontCodedDictionary::lower_bound(const std::string_view value) const {
+  return _partition_point([&](const std::string_view entry) { return entry >= value; });
+}
+
+size_t FrontCodedDictionary::upper_bound(const std::string_view value) const {
+  return _partition_point([&](const std::string_view entry) { return entry > value; });
+}
+
+size_t FrontCodedDictionary::estimate_memory_usage() const {
+  return _entries.estimate_memory_usage() + _prefix_lengths.capacity() * sizeof(uint8_t);
+}
+
+const StringHeap& FrontCodedDictionary::entries() const { return _entries; }
+
+const MappableVector<uint8_t>& FrontCodedDictionary::prefix_lengths() const { return _prefix_lengths; }
+
+}  // namespace opossum
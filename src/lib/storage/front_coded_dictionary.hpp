@@ -0,0 +1,86 @@
+#pragma once
+
+#include <optional>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "mappable_vector.hpp"
+#include "string_heap.hpp"
+#include "types.hpp"
+
+namespace opossum {
+
+// FrontCodedDictionary stores a sorted list of distinct strings, e.g., the dictionary of a DictionarySegment. Sorted
+// strings such as URLs, paths, or product codes often share long prefixes with their predecessor. The dictionary is
+// split into blocks of BLOCK_SIZE strings. The first string of each block is stored completely, all others only store
+// the length of the prefix they share with their predecessor and the remaining suffix.
+//
+// Searching first performs a binary search over the uncompressed first strings of all blocks and then decodes a single
+// block. Accessing a string decodes at most BLOCK_SIZE - 1 predecessors within its block.
+class FrontCodedDictionary {
+ public:
+  static constexpr auto BLOCK_SIZE = size_t{16};
+
+  FrontCodedDictionary() = default;
+
+  // Creates a dictionary from its encoded entries and prefix lengths, e.g., when reading a serialized dictionary. Both
+  // may reference a memory-mapped file.
+  FrontCodedDictionary(StringHeap entries, MappableVector<uint8_t> prefix_lengths);
+
+  // Appends a string, which must not be smaller than the last string of the dictionary. The last string is kept to
+  // compare it with the next one until shrink_to_fit() finishes building the dictionary.
+  void push_back(const std::string_view value);
+
+  // Returns the string at the given position.
+  std::string operator[](const size_t index) const;
+
+  // Returns the string at the given position and fails for invalid positions.
+  std::string at(const size_t index) const;
+
+  std::string front() const;
+  std::string back() const;
+
+  // Returns the number of strings.
+  size_t size() const;
+
+  bool empty() const;
+
+  // Reserves space for the given number of strings.
+  void reserve(const size_t string_count);
+
+  // Releases unused capacity and the last string kept by push_back().
+  void shrink_to_fit();
+
+  // Returns the position of the first string that is not smaller than the search value, or size() if there is none.
+  size_t lower_bound(const std::string_view value) const;
+
+  // Returns the position of the first string that is larger than the search value, or size() if there is none.
+  size_t upper_bound(const std::string_view value) const;
+
+  // Returns the calculated memory usage.
+  size_t estimate_memory_usage() const;
+
+  // Returns the complete first string of each block and the suffixes of all other strings.
+  const StringHeap& entries() const;
+
+  const MappableVector<uint8_t>& prefix_lengths() const;
+
+ protected:
+  // Returns the position of the first string in [0, size()) for which is_beyond_search_value returns true.
+  template <typename Predicate>
+  size_t _partition_point(const Predicate& is_beyond_search_value) const;
+
+  // Holds the complete first string of each block and the suffixes of all other strings.
+  StringHeap _entries{};
+
+  // Length of the prefix a string shares with its predecessor (zero for the first string of each block). Prefixes are
+  // shared up to a length of 255 characters, longer common prefixes are partially stored in the suffix.
+  MappableVector<uint8_t> _prefix_lengths{};
+
+  // The last appended string, which push_back() compares the next string with instead of decoding it from its block.
+  // It is only kept while the dictionary is built and decoded again if strings are appended after shrink_to_fit().
+  std::optional<std::string> _last_value{};
+};
+
+}  // namespace opossum
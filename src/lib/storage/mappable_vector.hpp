@@ -0,0 +1,168 @@
+#pragma once
+
+#include <algorithm>
+#include <memory>
+#include <utility>
+#include <vector>
+
+#include "utils/assert.hpp"
+
+namespace opossum {
+
+// MappableVector is a vector that either owns its elements or references read-only elements in memory that is owned
+// elsewhere, e.g., a region of a memory-mapped file. A referenced region is kept alive by a shared_ptr to its owner,
+// so reading a segment from a mapped file neither copies its data nor requires it to be resident; the operating system
+// pages it in on first access.
+//
+// Reading is as cheap as for a std::vector. Modifying a vector that references external memory first copies the
+// elements, which only happens when a vector is built, e.g., by an encoder.
+template <typename T>
+class MappableVector {
+ public:
+  using value_type = T;
+  using const_iterator = const T*;
+  using iterator = const_iterator;
+
+  MappableVector() = default;
+
+  // Takes over the elements of the given vector. This is implicit so that a MappableVector can be used wherever a
+  // std::vector was used to build a segment.
+  MappableVector(std::vector<T> values)  // NOLINT(runtime/explicit)
+      : _owned_values{std::move(values)} {
+    _update_view();
+  }
+
+  // References size elements at data, which remain valid as long as memory_owner is alive.
+  MappableVector(const T* data, const size_t size, std::shared_ptr<const void> memory_owner)
+      : _data{data}, _size{size}, _memory_owner{std::move(memory_owner)} {}
+
+  MappableVector(const MappableVector& other)
+      : _owned_values{other._owned_values}, _data{other._data}, _size{other._size}, _memory_owner{other._memory_owner} {
+    _update_view();
+  }
+
+  MappableVector(MappableVector&& other) noexcept
+      : _owned_values{std::move(other._owned_values)},
+        _data{other._data},
+        _size{other._size},
+        _memory_owner{std::move(other._memory_owner)} {
+    _update_view();
+    other._update_view();
+  }
+
+  MappableVector& operator=(const MappableVector& other) {
+    auto copy = other;
+    return *this = std::move(copy);
+  }
+
+  MappableVector& operator=(MappableVector&& other) noexcept {
+    _owned_values = std::move(other._owned_values);
+    _data = other._data;
+    _size = other._size;
+    _memory_owner = std::move(other._memory_owner);
+    _update_view();
+    other._update_view();
+    return *this;
+  }
+
+  const T& operator[](const size_t index) const { return _data[index]; }
+
+  const T& at(const size_t index) const {
+    Assert(index < _size, "Index is out of bounds.");
+    return _data[index];
+  }
+
+  const T& front() const { return at(0); }
+  const T& back() const { return at(_size - 1); }
+
+  const T* data() const { return _data; }
+  size_t size() const { return _size; }
+  bool empty() const { return _size == 0; }
+
+  // Returns the number of owned elements that fit into the allocated memory, or the size for referenced elements.
+  size_t capacity() const { return is_mapped() ? _size : _owned_values.capacity(); }
+
+  const_iterator begin() const { return _data; }
+  const_iterator end() const { return _data + _size; }
+  const_iterator cbegin() const { return begin(); }
+  const_iterator cend() const { return end(); }
+
+  // Returns true if the elements reference external memory.
+  bool is_mapped() const { return static_cast<bool>(_memory_owner); }
+
+  // Returns a pointer to modifiable elements. Referenced elements are copied first.
+  T* mutable_data() {
+    _materialize();
+    return _owned_values.data();
+  }
+
+  void push_back(const T& value) {
+    _materialize();
+    _owned_values.push_back(value);
+    _update_view();
+  }
+
+  template <typename InputIterator>
+  void insert(const const_iterator position, const InputIterator first, const InputIterator last) {
+    const auto index = static_cast<size_t>(position - begin());
+    _materialize();
+    _owned_values.insert(_owned_values.begin() + index, first, last);
+    _update_view();
+  }
+
+  void resize(const size_t size) {
+    _materialize();
+    _owned_values.resize(size);
+    _update_view();
+  }
+
+  void reserve(const size_t capacity) {
+    _materialize();
+    _owned_values.reserve(capacity);
+    _update_view();
+  }
+
+  void shrink_to_fit() {
+    if (!is_mapped()) {
+      _owned_values.shrink_to_fit();
+      _update_view();
+    }
+  }
+
+ protected:
+  void _materialize() {
+    if (is_mapped()) {
+      _owned_values.assign(begin(), end());
+      _memory_owner.reset();
+      _update_view();
+    }
+  }
+
+  // _data is only written if the elements moved, so that appending within the capacity does not conflict with
+  // concurrent readers of the existing elements (see Table::append_batch).
+  void _update_view() {
+    if (!is_mapped()) {
+      if (_data != _owned_values.data()) {
+        _data = _owned_values.data();
+      }
+      _size = _owned_values.size();
+    }
+  }
+
+  std::vector<T> _owned_values{};
+  const T* _data{nullptr};
+  size_t _size{0};
+  std::shared_ptr<const void> _memory_owner{};
+};
+
+template <typename T>
+bool operator==(const MappableVector<T>& lhs, const MappableVector<T>& rhs) {
+  return std::equal(lhs.cbegin(), lhs.cend(), rhs.cbegin(), rhs.cend());
+}
+
+template <typename T>
+bool operator==(const MappableVector<T>& lhs, const std::vector<T>& rhs) {
+  return std::equal(lhs.cbegin(), lhs.cend(), rhs.cbegin(), rhs.cend());
+}
+
+}  // namespace opossum
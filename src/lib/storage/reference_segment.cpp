@@ -0,0 +1,49 @@
+#include "reference_segment.hpp"
+
+#include <memory>
+
+#include "chunk.hpp"
+#include "table.hpp"
+
+namespace opossum {
+
+ReferenceSegment::ReferenceSegment(const std::shared_ptr<const Table>& referenced_table,
+                                   const ColumnID referenced_column_id, const std::shared_ptr<const PosList>& pos)
+    : _referenced_table{referenced_table}, _referenced_column_id{referenced_column_id}, _pos_list{pos} {
+  // The version is read first, so that it is outdated rather than too new if the table is reorganized in between.
+  _layout_version = referenced_table->layout_version();
+  _referenced_chunks = referenced_table->chunks();
+}
+
+ReferenceSegment::ReferenceSegment(const std::shared_ptr<const Table>& referenced_table,
+                                   const ColumnID referenced_column_id, const std::shared_ptr<const PosList>& pos,
+                                   const std::shared_ptr<const ChunkVector>& referenced_chunks,
+                                   const uint64_t layout_version)
+    : _referenced_table{referenced_table},
+      _referenced_column_id{referenced_column_id},
+      _pos_list{pos},
+      _referenced_chunks{referenced_chunks},
+      _layout_version{layout_version} {}
+
+AllTypeVariant ReferenceSegment::operator[](const ChunkOffset chunk_offset) const {
+  const auto& row_id = _pos_list->at(chunk_offset);
+  return (*_referenced_chunks->at(row_id.chunk_id)->get_segment(_referenced_column_id))[row_id.chunk_offset];
+}
+
+ChunkOffset ReferenceSegment::size() const { return static_cast<ChunkOffset>(_pos_list->size()); }
+
+const std::shared_ptr<const PosList>& ReferenceSegment::pos_list() const { return _pos_list; }
+
+const std::shared_ptr<const Table>& ReferenceSegment::referenced_table() const { return _referenced_table; }
+
+ColumnID ReferenceSegment::referenced_column_id() const { return _referenced_column_id; }
+
+const std::shared_ptr<const ReferenceSegment::ChunkVector>& ReferenceSegment::referenced_chunks() const {
+  return _referenced_chunks;
+}
+
+uint64_t ReferenceSegment::layout_version() const { return _layout_version; }
+
+size_t ReferenceSegment::estimate_memory_usage() const { return sizeof(RowID) * _pos_list->size(); }
+
+}  // namespace opossum
@@ -1,61 +1,66 @@
 #pragma once
 
-#include <map>
 #include <memory>
 #include <string>
-#include <unordered_map>
-#include <utility>
 #include <vector>
 
 #include "abstract_segment.hpp"
-#include "dictionary_segment.hpp"
-#include "table.hpp"
 #include "types.hpp"
-#include "utils/assert.hpp"
-#include "value_segment.hpp"
 
 namespace opossum {
 
+class Chunk;
+class Table;
+
 // ReferenceSegment is a specific segment type that stores all its values as position list of a referenced column.
+//
+// The positions refer to a snapshot of the referenced table's chunks (see Table::chunks()). compact(),
+// coalesce_chunks() and merge_delta() move rows to other positions, so values are always read from the snapshot, which
+// keeps the chunks it holds alive. Rows deleted later may still be visible through the snapshot.
 class ReferenceSegment : public AbstractSegment {
  public:
-  // Creates a reference segment. The parameters specify the positions and the referenced column.
+  using ChunkVector = std::vector<std::shared_ptr<Chunk>>;
+
+  // Creates a reference segment. The parameters specify the positions and the referenced column. The positions refer
+  // to the current chunks of the referenced table.
+  ReferenceSegment(const std::shared_ptr<const Table>& referenced_table, const ColumnID referenced_column_id,
+                   const std::shared_ptr<const PosList>& pos);
+
+  // Creates a reference segment whose positions refer to a snapshot of the chunks of the referenced table, which was
+  // taken when Table::layout_version() returned layout_version.
   ReferenceSegment(const std::shared_ptr<const Table>& referenced_table, const ColumnID referenced_column_id,
-                   const std::shared_ptr<const PosList>& pos) {
-    // TODO(student) implement it in a source file and change this to a declaration.
-  }
+                   const std::shared_ptr<const PosList>& pos,
+                   const std::shared_ptr<const ChunkVector>& referenced_chunks, const uint64_t layout_version);
 
-  AllTypeVariant operator[](const ChunkOffset chunk_offset) const override {
-    // TODO(student) implement it in a source file and change this to a declaration.
-    return AllTypeVariant{};
-  }
+  AllTypeVariant operator[](const ChunkOffset chunk_offset) const override;
 
   void append(const AllTypeVariant&) override { throw std::logic_error("ReferenceSegment is immutable"); }
 
-  ChunkOffset size() const override {
-    // TODO(student) implement it in a source file and change this to a declaration.
-    throw std::logic_error("ReferenceSegment is not implemented yet.");
-  }
-
-  const std::shared_ptr<const PosList>& pos_list() const {
-    // TODO(student) implement it in a source file and change this to a declaration.
-    throw std::logic_error("ReferenceSegment is not implemented yet.");
-  }
-
-  const std::shared_ptr<const Table>& referenced_table() const {
-    // TODO(student) implement it in a source file and change this to a declaration.
-    throw std::logic_error("ReferenceSegment is not implemented yet.");
-  }
-
-  ColumnID referenced_column_id() const {
-    // TODO(student) implement it in a source file and change this to a declaration.
-    throw std::logic_error("ReferenceSegment is not implemented yet.");
-  }
-
-  size_t estimate_memory_usage() const final {
-    // TODO(student) implement it in a source file and change this to a declaration.
-    throw std::logic_error("ReferenceSegment is not implemented yet.");
-  }
+  ChunkOffset size() const override;
+
+  const std::shared_ptr<const PosList>& pos_list() const;
+
+  const std::shared_ptr<const Table>& referenced_table() const;
+
+  ColumnID referenced_column_id() const;
+
+  // Returns the snapshot of the chunks that the positions refer to.
+  const std::shared_ptr<const ChunkVector>& referenced_chunks() const;
+
+  // Returns the layout version of the referenced table when the snapshot was taken. Pass it to Table::delete_rows, so
+  // that the positions are rejected if rows were moved since.
+  uint64_t layout_version() const;
+
+  // Returns the memory usage of the position list. As the list is usually shared by all segments of a chunk, it is
+  // counted once per segment.
+  size_t estimate_memory_usage() const final;
+
+ protected:
+  const std::shared_ptr<const Table> _referenced_table;
+  const ColumnID _referenced_column_id;
+  const std::shared_ptr<const PosList> _pos_list;
+  std::shared_ptr<const ChunkVector> _referenced_chunks;
+  uint64_t _layout_version;
 };
 
 }  // namespace opossum
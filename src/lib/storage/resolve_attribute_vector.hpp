@@ -0,0 +1,55 @@
+#pragma once
+
+#include "abstract_attribute_vector.hpp"
+#include "bit_packed_integer_vector.hpp"
+#include "fixed_width_integer_vector.hpp"
+#include "utils/assert.hpp"
+
+namespace opossum {
+
+/**
+ * Resolves the concrete type of an attribute vector and passes the vector with that type on to a generic lambda.
+ * All attribute vectors are final, so calls to get() within the lambda are not virtual and can be inlined. This makes
+ * a single dispatch sufficient for processing an entire attribute vector, e.g., in a scan.
+ *
+ * Example:
+ *
+ *   resolve_attribute_vector(*dictionary_segment->attribute_vector(), [&](const auto& attribute_vector) {
+ *     const auto size = attribute_vector.size();
+ *     for (auto index = size_t{0}; index < size; ++index) {
+ *       if (attribute_vector.get(index) == search_value_id) { ... }
+ *     }
+ *   });
+ */
+template <typename Functor>
+void resolve_attribute_vector(const AbstractAttributeVector& attribute_vector, const Functor& func) {
+  if (const auto* vector = dynamic_cast<const FixedWidthIntegerVector<uint8_t>*>(&attribute_vector)) {
+    func(*vector);
+  } else if (const auto* vector = dynamic_cast<const FixedWidthIntegerVector<uint16_t>*>(&attribute_vector)) {
+    func(*vector);
+  } else if (const auto* vector = dynamic_cast<const FixedWidthIntegerVector<uint32_t>*>(&attribute_vector)) {
+    func(*vector);
+  } else if (const auto* vector = dynamic_cast<const BitPackedIntegerVector*>(&attribute_vector)) {
+    func(*vector);
+  } else {
+    Fail("Unknown attribute vector type.");
+  }
+}
+
+// Resolves a mutable attribute vector, e.g., to fill a new vector without a virtual call per value id.
+template <typename Functor>
+void resolve_attribute_vector(AbstractAttributeVector& attribute_vector, const Functor& func) {
+  if (auto* vector = dynamic_cast<FixedWidthIntegerVector<uint8_t>*>(&attribute_vector)) {
+    func(*vector);
+  } else if (auto* vector = dynamic_cast<FixedWidthIntegerVector<uint16_t>*>(&attribute_vector)) {
+    func(*vector);
+  } else if (auto* vector = dynamic_cast<FixedWidthIntegerVector<uint32_t>*>(&attribute_vector)) {
+    func(*vector);
+  } else if (auto* vector = dynamic_cast<BitPackedIntegerVector*>(&attribute_vector)) {
+    func(*vector);
+  } else {
+    Fail("Unknown attribute vector type.");
+  }
+}
+
+}  // namespace opossum
@@ -0,0 +1,46 @@
+#pragma once
+
+#include <type_traits>
+
+#include "abstract_segment.hpp"
+#include "dictionary_segment.hpp"
+#include "frame_of_reference_segment.hpp"
+#include "run_length_segment.hpp"
+#include "value_segment.hpp"
+#include "utils/assert.hpp"
+
+namespace opossum {
+
+/**
+ * Resolves the concrete type of a segment with the data type T and passes the segment with that type on to a generic
+ * lambda. All segment types provide a typed get(), so the lambda can read values without going through
+ * AllTypeVariant.
+ *
+ * Example:
+ *
+ *   resolve_segment<int32_t>(*segment, [&](const auto& typed_segment) {
+ *     for (auto chunk_offset = ChunkOffset{0}; chunk_offset < typed_segment.size(); ++chunk_offset) {
+ *       sum += typed_segment.get(chunk_offset);
+ *     }
+ *   });
+ */
+template <typename T, typename Functor>
+void resolve_segment(const AbstractSegment& segment, const Functor& func) {
+  if (const auto* typed_segment = dynamic_cast<const ValueSegment<T>*>(&segment)) {
+    func(*typed_segment);
+  } else if (const auto* typed_segment = dynamic_cast<const DictionarySegment<T>*>(&segment)) {
+    func(*typed_segment);
+  } else if (const auto* typed_segment = dynamic_cast<const RunLengthSegment<T>*>(&segment)) {
+    func(*typed_segment);
+  } else {
+    if constexpr (std::is_integral_v<T>) {
+      if (const auto* typed_segment = dynamic_cast<const FrameOfReferenceSegment<T>*>(&segment)) {
+        func(*typed_segment);
+        return;
+      }
+    }
+    Fail("Unknown segment type.");
+  }
+}
+
+}  // namespace opossum
@@ -0,0 +1,119 @@
+#include "run_length_segment.hpp"
+
+#include <algorithm>
+#include <iterator>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "type_cast.hpp"
+#include "utils/assert.hpp"
+#include "utils/with_comparator.hpp"
+#include "validity_bitmap.hpp"
+#include "value_segment.hpp"
+
+namespace opossum {
+
+template <typename T>
+RunLengthSegment<T>::RunLengthSegment(const std::shared_ptr<AbstractSegment>& abstract_segment) {
+  const auto& segment_values = std::static_pointer_cast<ValueSegment<T>>(abstract_segment)->values();
+  const auto segment_size = segment_values.size();
+
+  // a new run starts at the first row and whenever the value changes
+  for (auto index = size_t{0}; index < segment_size; ++index) {
+    if (index == 0 || segment_values[index] != _values.back()) {
+      _values.emplace_back(segment_values[index]);
+      _end_positions.push_back(static_cast<ChunkOffset>(index));
+    } else {
+      ++_end_positions.back();
+    }
+  }
+
+  _values.shrink_to_fit();
+  _end_positions.shrink_to_fit();
+}
+
+template <typename T>
+RunLengthSegment<T>::RunLengthSegment(std::vector<T> values, std::vector<ChunkOffset> end_positions)
+    : _values{std::move(values)}, _end_positions{std::move(end_positions)} {
+  Assert(_values.size() == _end_positions.size(), "Each run requires an end position.");
+}
+
+template <typename T>
+AllTypeVariant RunLengthSegment<T>::operator[](const ChunkOffset chunk_offset) const {
+  return get(chunk_offset);
+}
+
+template <typename T>
+T RunLengthSegment<T>::get(const ChunkOffset chunk_offset) const {
+  return _values[run_index(chunk_offset)];
+}
+
+template <typename T>
+void RunLengthSegment<T>::append(const AllTypeVariant& value) {
+  Fail("Run-length segments are immutable, i.e., values cannot be appended.");
+}
+
+template <typename T>
+ChunkOffset RunLengthSegment<T>::size() const {
+  if (_end_positions.empty()) {
+    return 0;
+  }
+  return _end_positions.back() + 1;
+}
+
+template <typename T>
+size_t RunLengthSegment<T>::estimate_memory_usage() const {
+  return _values.size() * sizeof(T) + _end_positions.size() * sizeof(ChunkOffset);
+}
+
+template <typename T>
+const std::vector<T>& RunLengthSegment<T>::values() const {
+  return _values;
+}
+
+template <typename T>
+const std::vector<ChunkOffset>& RunLengthSegment<T>::end_positions() const {
+  return _end_positions;
+}
+
+template <typename T>
+size_t RunLengthSegment<T>::run_count() const {
+  return _values.size();
+}
+
+template <typename T>
+size_t RunLengthSegment<T>::run_index(const ChunkOffset chunk_offset) const {
+  Assert(chunk_offset < size(), "Position is out of bounds.");
+  // the first run whose end position is not before the requested position contains it
+  const auto run_it = std::lower_bound(_end_positions.cbegin(), _end_positions.cend(), chunk_offset);
+  return std::distance(_end_positions.cbegin(), run_it);
+}
+
+template <typename T>
+void RunLengthSegment<T>::scan(const ScanType scan_type, const T& search_value, const ChunkID chunk_id,
+                               PosList& matches, const ValidityBitmap* validity) const {
+  const auto add_match = [&](const ChunkOffset chunk_offset) { matches.push_back(RowID{chunk_id, chunk_offset}); };
+  with_comparator(scan_type, [&](auto comparator) {
+    const auto run_count = _values.size();
+    auto run_begin = ChunkOffset{0};
+    for (auto run_index = size_t{0}; run_index < run_count; ++run_index) {
+      const auto run_end = _end_positions[run_index];
+      if (comparator(_values[run_index], search_value)) {
+        if (validity) {
+          validity->for_each_valid(run_begin, run_end + 1, add_match);
+        } else {
+          for (auto chunk_offset = run_begin; chunk_offset <= run_end; ++chunk_offset) {
+            add_match(chunk_offset);
+          }
+        }
+      }
+      run_begin = run_end + 1;
+    }
+  });
+}
+
+EXPLICITLY_INSTANTIATE_DATA_TYPES(RunLengthSegment);
+
+}  // namespace opossum
@@ -0,0 +1,65 @@
+#pragma once
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "abstract_segment.hpp"
+#include "all_type_variant.hpp"
+#include "types.hpp"
+
+namespace opossum {
+
+class ValidityBitmap;
+
+// RunLengthSegment is a segment type that stores each run of consecutive equal values only once, together with the
+// position of the run's last row. It is well suited for sorted or clustered columns, e.g., dates or tenant ids.
+// The rows end_positions()[i - 1] + 1 to end_positions()[i] all have the value values()[i].
+template <typename T>
+class RunLengthSegment : public AbstractSegment {
+ public:
+  // Creates a run-length encoded segment from a given value segment.
+  explicit RunLengthSegment(const std::shared_ptr<AbstractSegment>& abstract_segment);
+
+  // Creates a run-length encoded segment from existing runs, e.g., when reading a serialized segment.
+  RunLengthSegment(std::vector<T> values, std::vector<ChunkOffset> end_positions);
+
+  // Return the value at a certain position. If you want to write efficient operators, back off!
+  AllTypeVariant operator[](const ChunkOffset chunk_offset) const override;
+
+  // Return the value at a certain position. This requires a binary search over the runs.
+  T get(const ChunkOffset chunk_offset) const;
+
+  // Run-length segments are immutable.
+  void append(const AllTypeVariant& value) override;
+
+  // Return the number of entries.
+  ChunkOffset size() const override;
+
+  // Returns the calculated memory usage.
+  size_t estimate_memory_usage() const final;
+
+  // Returns the value of each run.
+  const std::vector<T>& values() const;
+
+  // Returns the position of the last row of each run.
+  const std::vector<ChunkOffset>& end_positions() const;
+
+  // Returns the number of runs.
+  size_t run_count() const;
+
+  // Returns the index of the run that contains the given position.
+  size_t run_index(const ChunkOffset chunk_offset) const;
+
+  // Appends the positions of all rows whose value satisfies "value <scan_type> search_value" to matches. The predicate
+  // is evaluated once per run and all positions of a matching run are added at once. Invalid rows, as given by an
+  // optional validity bitmap, are skipped.
+  void scan(const ScanType scan_type, const T& search_value, const ChunkID chunk_id, PosList& matches,
+            const ValidityBitmap* validity = nullptr) const;
+
+ protected:
+  std::vector<T> _values{};
+  std::vector<ChunkOffset> _end_positions{};
+};
+
+}  // namespace opossum
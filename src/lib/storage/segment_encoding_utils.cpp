@@ -0,0 +1,101 @@
+#include "segment_encoding_utils.hpp"
+
+#include <memory>
+#include <string>
+#include <type_traits>
+
+#include "dictionary_segment.hpp"
+#include "encoding_advisor.hpp"
+#include "frame_of_reference_segment.hpp"
+#include "resolve_segment.hpp"
+#include "resolve_type.hpp"
+#include "run_length_segment.hpp"
+#include "value_segment.hpp"
+#include "utils/assert.hpp"
+
+namespace opossum {
+
+std::shared_ptr<AbstractSegment> encode_segment(const EncodingType encoding_type, const std::string& column_type,
+                                                const std::shared_ptr<AbstractSegment>& value_segment) {
+  if (encoding_type == EncodingType::Automatic) {
+    return encode_segment(advise_encoding(column_type, value_segment).encoding_type, column_type, value_segment);
+  }
+
+  auto encoded_segment = std::shared_ptr<AbstractSegment>{};
+  resolve_data_type(column_type, [&](const auto data_type_t) {
+    using ColumnDataType = typename decltype(data_type_t)::type;
+    Assert(std::dynamic_pointer_cast<ValueSegment<ColumnDataType>>(value_segment),
+           "Only value segments of the column's type can be encoded.");
+
+    switch (encoding_type) {
+      case EncodingType::Unencoded:
+        encoded_segment = value_segment;
+        return;
+      case EncodingType::Dictionary:
+        encoded_segment = std::make_shared<DictionarySegment<ColumnDataType>>(value_segment);
+        return;
+      case EncodingType::RunLength:
+        encoded_segment = std::make_shared<RunLengthSegment<ColumnDataType>>(value_segment);
+        return;
+      case EncodingType::FrameOfReference:
+        if constexpr (std::is_integral_v<ColumnDataType>) {
+          encoded_segment = std::make_shared<FrameOfReferenceSegment<ColumnDataType>>(value_segment);
+          return;
+        } else {
+          Fail("Frame-of-reference encoding is only supported for integer columns.");
+        }
+      case EncodingType::Automatic:
+        Fail("Automatic encoding must be resolved before.");
+    }
+  });
+
+  Assert(encoded_segment, "Unknown column type or encoding type.");
+  return encoded_segment;
+}
+
+bool is_encoding_supported(const EncodingType encoding_type, const std::string& column_type) {
+  auto is_supported = true;
+  resolve_data_type(column_type, [&](const auto data_type_t) {
+    using ColumnDataType = typename decltype(data_type_t)::type;
+    is_supported = encoding_type != EncodingType::FrameOfReference || std::is_integral_v<ColumnDataType>;
+  });
+  return is_supported;
+}
+
+EncodingType segment_encoding_type(const std::string& column_type, const AbstractSegment& segment) {
+  auto encoding_type = EncodingType::Unencoded;
+  resolve_data_type(column_type, [&](const auto data_type_t) {
+    using ColumnDataType = typename decltype(data_type_t)::type;
+    resolve_segment<ColumnDataType>(segment, [&](const auto& typed_segment) {
+      using SegmentType = std::decay_t<decltype(typed_segment)>;
+      if constexpr (std::is_same_v<SegmentType, ValueSegment<ColumnDataType>>) {
+        encoding_type = EncodingType::Unencoded;
+      } else if constexpr (std::is_same_v<SegmentType, DictionarySegment<ColumnDataType>>) {
+        encoding_type = EncodingType::Dictionary;
+      } else if constexpr (std::is_same_v<SegmentType, RunLengthSegment<ColumnDataType>>) {
+        encoding_type = EncodingType::RunLength;
+      } else {
+        encoding_type = EncodingType::FrameOfReference;
+      }
+    });
+  });
+  return encoding_type;
+}
+
+std::ostream& operator<<(std::ostream& stream, const EncodingType encoding_type) {
+  switch (encoding_type) {
+    case EncodingType::Unencoded:
+      return stream << "Unencoded";
+    case EncodingType::Dictionary:
+      return stream << "Dictionary";
+    case EncodingType::RunLength:
+      return stream << "RunLength";
+    case EncodingType::FrameOfReference:
+      return stream << "FrameOfReference";
+    case EncodingType::Automatic:
+      return stream << "Automatic";
+  }
+  Fail("Unknown encoding type.");
+}
+
+}  // namespace opossum
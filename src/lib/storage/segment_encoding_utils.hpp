@@ -0,0 +1,28 @@
+#pragma once
+
+#include <memory>
+#include <ostream>
+#include <string>
+
+#include "types.hpp"
+
+namespace opossum {
+
+class AbstractSegment;
+
+// Encodes a ValueSegment of the given column type with the given encoding. For EncodingType::Unencoded, the value
+// segment itself is returned. For EncodingType::Automatic, the encoding is chosen by advise_encoding().
+std::shared_ptr<AbstractSegment> encode_segment(const EncodingType encoding_type, const std::string& column_type,
+                                                const std::shared_ptr<AbstractSegment>& value_segment);
+
+// Returns whether segments of the given column type can be encoded with the given encoding, i.e., frame-of-reference
+// encoding is only available for integer columns. Encoding may still fail for values that the encoding cannot
+// represent.
+bool is_encoding_supported(const EncodingType encoding_type, const std::string& column_type);
+
+// Returns the encoding of a segment of the given column type, e.g., to encode a rewritten segment in the same way.
+EncodingType segment_encoding_type(const std::string& column_type, const AbstractSegment& segment);
+
+std::ostream& operator<<(std::ostream& stream, const EncodingType encoding_type);
+
+}  // namespace opossum
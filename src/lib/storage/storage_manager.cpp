@@ -1,45 +1,111 @@
 #include "storage_manager.hpp"
 
 #include <algorithm>
+#include <filesystem>
+#include <functional>
+#include <future>
 #include <memory>
 #include <string>
 #include <utility>
 #include <vector>
 
+#include "import_export/binary_parser.hpp"
+#include "import_export/binary_writer.hpp"
 #include "utils/assert.hpp"
+#include "utils/thread_pool.hpp"
 
 namespace opossum {
 
+namespace {
+
+constexpr auto BINARY_TABLE_FILE_EXTENSION = ".bin";
+
+}  // namespace
+
 StorageManager& StorageManager::get() {
   static auto instance = StorageManager{};
   return instance;
 }
 
 void StorageManager::add_table(const std::string& name, std::shared_ptr<Table> table) {
-  const bool insert_success = _tables.insert(std::make_pair(name, table)).second;
+  auto& shard = _shard(name);
+  auto guard = std::lock_guard<std::mutex>(shard.mutex);
+  auto tables = std::make_shared<TableMap>(*shard.tables.load());
+  const bool insert_success = tables->insert(std::make_pair(name, table)).second;
   Assert(insert_success, name + " already exists, choose a different name!");
+  shard.tables.store(std::move(tables));
 }
 
 void StorageManager::drop_table(const std::string& name) {
-  const auto values_erased = _tables.erase(name);
+  auto& shard = _shard(name);
+  auto guard = std::lock_guard<std::mutex>(shard.mutex);
+  auto tables = std::make_shared<TableMap>(*shard.tables.load());
+  const auto values_erased = tables->erase(name);
   Assert(values_erased, name + " does not exist and cannot be deleted.");
+  shard.tables.store(std::move(tables));
 }
 
-std::shared_ptr<Table> StorageManager::get_table(const std::string& name) const { return _tables.at(name); }
+std::shared_ptr<Table> StorageManager::get_table(const std::string& name) const {
+  return _shard(name).tables.load()->at(name);
+}
 
-bool StorageManager::has_table(const std::string& name) const { return _tables.contains(name); }
+bool StorageManager::has_table(const std::string& name) const { return _shard(name).tables.load()->contains(name); }
 
 std::vector<std::string> StorageManager::table_names() const {
   auto table_names = std::vector<std::string>{};
-  table_names.reserve(_tables.size());
 
-  for (const auto& table : _tables) {
-    table_names.push_back(table.first);
+  for (const auto& shard : _shards) {
+    const auto tables = shard.tables.load();
+    for (const auto& table : *tables) {
+      table_names.push_back(table.first);
+    }
   }
 
   return table_names;
 }
 
+void StorageManager::save(const std::string& directory) const {
+  std::filesystem::create_directories(directory);
+
+  auto& thread_pool = ThreadPool::get();
+  auto tasks = std::vector<std::future<void>>{};
+  for (const auto& shard : _shards) {
+    const auto tables = shard.tables.load();
+    for (const auto& [name, table] : *tables) {
+      const auto file_name = (std::filesystem::path{directory} / (name + BINARY_TABLE_FILE_EXTENSION)).string();
+      tasks.push_back(thread_pool.submit([table = table, file_name]() { BinaryWriter::write(*table, file_name); }));
+    }
+  }
+
+  for (const auto& task : tasks) {
+    thread_pool.wait(task);
+  }
+  for (auto& task : tasks) {
+    task.get();
+  }
+}
+
+void StorageManager::load(const std::string& directory) {
+  auto& thread_pool = ThreadPool::get();
+  auto names = std::vector<std::string>{};
+  auto tasks = std::vector<std::future<std::shared_ptr<Table>>>{};
+  for (const auto& entry : std::filesystem::directory_iterator{directory}) {
+    if (!entry.is_regular_file() || entry.path().extension() != BINARY_TABLE_FILE_EXTENSION) {
+      continue;
+    }
+    names.push_back(entry.path().stem().string());
+    const auto file_name = entry.path().string();
+    tasks.push_back(thread_pool.submit([file_name]() { return BinaryParser::parse(file_name); }));
+  }
+
+  for (const auto& task : tasks) {
+    thread_pool.wait(task);
+  }
+  for (auto index = size_t{0}; index < tasks.size(); ++index) {
+    add_table(names[index], tasks[index].get());
+  }
+}
+
 void StorageManager::print(std::ostream& out) const {
   auto sorted_table_names = table_names();
   // sort the vector of table names, both for better user output (sorted vs randomly ordered tables) and for easy tests
@@ -51,6 +117,19 @@ void StorageManager::print(std::ostream& out) const {
   }
 }
 
-void StorageManager::reset() { StorageManager::get() = StorageManager{}; }
+void StorageManager::reset() {
+  for (auto& shard : _shards) {
+    auto guard = std::lock_guard<std::mutex>(shard.mutex);
+    shard.tables.store(std::make_shared<const TableMap>());
+  }
+}
+
+StorageManager::Shard& StorageManager::_shard(const std::string& name) {
+  return _shards[std::hash<std::string>{}(name) % SHARD_COUNT];
+}
+
+const StorageManager::Shard& StorageManager::_shard(const std::string& name) const {
+  return _shards[std::hash<std::string>{}(name) % SHARD_COUNT];
+}
 
 }  // namespace opossum
@@ -1,7 +1,10 @@
 #pragma once
 
+#include <array>
+#include <atomic>
 #include <iostream>
 #include <memory>
+#include <mutex>
 #include <string>
 #include <unordered_map>
 #include <vector>
@@ -12,7 +15,9 @@
 namespace opossum {
 
 // The StorageManager is a singleton that maintains all tables
-// by mapping table names to table instances.
+// by mapping table names to table instances. It is thread-safe: the catalog is split into shards by the hash of the
+// table name. Each shard publishes its map copy-on-write, so lookups never block, while catalog mutations are
+// serialized per shard.
 class StorageManager : private Noncopyable {
  public:
   static StorageManager& get();
@@ -32,19 +37,37 @@ class StorageManager : private Noncopyable {
   // Returns a list of all table names.
   std::vector<std::string> table_names() const;
 
+  // Writes each table to the given directory as a file in the binary table format, which is named after the table.
+  void save(const std::string& directory) const;
+
+  // Adds all tables that were written to the given directory by save(). Tables are read in parallel.
+  void load(const std::string& directory);
+
   // Prints information about all tables in the storage manager (name, #columns, #rows, #chunks).
   void print(std::ostream& out = std::cout) const;
 
-  // Deletes the entire StorageManager and creates a new one, used especially in tests.
+  // Removes all tables from the StorageManager, used especially in tests.
   void reset();
 
   StorageManager(StorageManager&&) = delete;
 
  protected:
+  static constexpr auto SHARD_COUNT = size_t{16};
+
+  using TableMap = std::unordered_map<std::string, std::shared_ptr<Table>>;
+
+  struct Shard {
+    std::atomic<std::shared_ptr<const TableMap>> tables{std::make_shared<const TableMap>()};
+    // serializes writers of the shard
+    std::mutex mutex{};
+  };
+
   StorageManager() {}
-  StorageManager& operator=(StorageManager&&) = default;
 
-  std::unordered_map<std::string, std::shared_ptr<Table>> _tables{};
+  Shard& _shard(const std::string& name);
+  const Shard& _shard(const std::string& name) const;
+
+  std::array<Shard, SHARD_COUNT> _shards{};
 };
 
 }  // namespace opossum
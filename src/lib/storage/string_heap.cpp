@@ -0,0 +1,74 @@
+#include "string_heap.hpp"
+
+#include <string_view>
+#include <utility>
+
+#include "utils/assert.hpp"
+
+namespace opossum {
+
+StringHeap::StringHeap(MappableVector<char> characters, MappableVector<size_t> offsets)
+    : _characters{std::move(characters)}, _offsets{std::move(offsets)} {
+  Assert(!_offsets.empty() && _offsets.front() == 0 && _offsets.back() == _characters.size(),
+         "The offsets do not match the characters.");
+}
+
+void StringHeap::push_back(const std::string_view value) {
+  _characters.insert(_characters.end(), value.begin(), value.end());
+  _offsets.push_back(_characters.size());
+}
+
+void StringHeap::append(const StringHeap& other, const size_t begin_index, const size_t end_index) {
+  DebugAssert(begin_index <= end_index && end_index <= other.size(), "Invalid range of strings.");
+
+  const auto other_begin_offset = other._offsets[begin_index];
+  const auto base_offset = _characters.size();
+  _characters.insert(_characters.end(), other._characters.cbegin() + other_begin_offset,
+                     other._characters.cbegin() + other._offsets[end_index]);
+
+  _offsets.reserve(_offsets.size() + (end_index - begin_index));
+  for (auto index = begin_index + 1; index <= end_index; ++index) {
+    _offsets.push_back(base_offset + other._offsets[index] - other_begin_offset);
+  }
+}
+
+std::string_view StringHeap::at(const size_t index) const {
+  Assert(index < size(), "Index is out of bounds.");
+  return (*this)[index];
+}
+
+std::string_view StringHeap::front() const { return at(0); }
+
+std::string_view StringHeap::back() const { return at(size() - 1); }
+
+size_t StringHeap::size() const { return _offsets.size() - 1; }
+
+bool StringHeap::empty() const { return size() == 0; }
+
+void StringHeap::reserve(const size_t string_count, const size_t character_count) {
+  _offsets.reserve(string_count + 1);
+  _characters.reserve(character_count);
+}
+
+void StringHeap::shrink_to_fit() {
+  _offsets.shrink_to_fit();
+  _characters.shrink_to_fit();
+}
+
+StringHeap::Iterator StringHeap::begin() const { return Iterator{this, 0}; }
+
+StringHeap::Iterator StringHeap::end() const { return Iterator{this, size()}; }
+
+StringHeap::Iterator StringHeap::cbegin() const { return begin(); }
+
+StringHeap::Iterator StringHeap::cend() const { return end(); }
+
+size_t StringHeap::estimate_memory_usage() const {
+  return _characters.capacity() * sizeof(char) + _offsets.capacity() * sizeof(size_t);
+}
+
+const MappableVector<char>& StringHeap::characters() const { return _characters; }
+
+const MappableVector<size_t>& StringHeap::offsets() const { return _offsets; }
+
+}  // namespace opossum
@@ -0,0 +1,113 @@
+#pragma once
+
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <vector>
+
+#include <boost/iterator/iterator_facade.hpp>
+
+#include "mappable_vector.hpp"
+#include "types.hpp"
+
+namespace opossum {
+
+// StringHeap stores strings back to back in a single contiguous character buffer, together with the offset at which
+// each string starts. Compared to std::vector<std::string>, this avoids one allocation per string that is too long for
+// the small string optimization, saves the per-string overhead of std::string, and keeps neighboring strings in
+// neighboring cache lines, which makes binary searches over sorted strings cache-friendly. Strings are returned as
+// std::string_view. The views remain valid until the heap is modified.
+class StringHeap {
+ public:
+  using value_type = std::string_view;
+
+  class Iterator : public boost::iterator_facade<Iterator, std::string_view, std::random_access_iterator_tag,
+                                                 std::string_view, std::ptrdiff_t> {
+   public:
+    Iterator() = default;
+    Iterator(const StringHeap* heap, const size_t index) : _heap{heap}, _index{index} {}
+
+   private:
+    friend class boost::iterator_core_access;
+
+    std::string_view dereference() const { return (*_heap)[_index]; }
+    bool equal(const Iterator& other) const { return _index == other._index; }
+    void increment() { ++_index; }
+    void decrement() { --_index; }
+    void advance(const std::ptrdiff_t distance) { _index += distance; }
+    std::ptrdiff_t distance_to(const Iterator& other) const {
+      return static_cast<std::ptrdiff_t>(other._index) - static_cast<std::ptrdiff_t>(_index);
+    }
+
+    const StringHeap* _heap{nullptr};
+    size_t _index{0};
+  };
+
+  StringHeap() = default;
+
+  // Creates a heap from the characters of all strings and the offsets at which they start, followed by the end offset
+  // of the last string, e.g., when reading a serialized heap. Both may reference a memory-mapped file.
+  StringHeap(MappableVector<char> characters, MappableVector<size_t> offsets);
+
+  // Appends a copy of the given string.
+  void push_back(const std::string_view value);
+
+  // Appends copies of the strings from begin_index to end_index (exclusive) of another heap with a single copy of
+  // their characters.
+  void append(const StringHeap& other, const size_t begin_index, const size_t end_index);
+
+  // Returns the string at the given position.
+  std::string_view operator[](const size_t index) const {
+    return std::string_view{_characters.data() + _offsets[index], _offsets[index + 1] - _offsets[index]};
+  }
+
+  // Returns the string at the given position and fails for invalid positions.
+  std::string_view at(const size_t index) const;
+
+  std::string_view front() const;
+  std::string_view back() const;
+
+  // Returns the number of strings.
+  size_t size() const;
+
+  bool empty() const;
+
+  // Reserves space for the given number of strings and, optionally, their total number of characters.
+  void reserve(const size_t string_count, const size_t character_count = 0);
+
+  void shrink_to_fit();
+
+  Iterator begin() const;
+  Iterator end() const;
+  Iterator cbegin() const;
+  Iterator cend() const;
+
+  // Returns the calculated memory usage.
+  size_t estimate_memory_usage() const;
+
+  const MappableVector<char>& characters() const;
+  const MappableVector<size_t>& offsets() const;
+
+ protected:
+  MappableVector<char> _characters{};
+
+  // The string at position i spans the characters from _offsets[i] to _offsets[i + 1], so that _offsets always holds
+  // one entry more than there are strings.
+  MappableVector<size_t> _offsets{std::vector<size_t>{0}};
+};
+
+// Segments store their values in a ValueVector, which is a StringHeap for strings and a std::vector otherwise.
+template <typename T>
+using ValueVector = std::conditional_t<std::is_same_v<T, std::string>, StringHeap, std::vector<T>>;
+
+// Returns the calculated memory usage of a ValueVector.
+template <typename T>
+size_t estimate_value_vector_memory_usage(const ValueVector<T>& values) {
+  if constexpr (std::is_same_v<T, std::string>) {
+    return values.estimate_memory_usage();
+  } else {
+    return values.capacity() * sizeof(T);
+  }
+}
+
+}  // namespace opossum
@@ -1,87 +1,394 @@
 #include "table.hpp"
 
+#include <unistd.h>
+
 #include <algorithm>
+#include <exception>
+#include <filesystem>
+#include <future>
 #include <iomanip>
 #include <limits>
+#include <map>
 #include <memory>
 #include <numeric>
+#include <ostream>
 #include <string>
-#include <thread>
 #include <utility>
 #include <vector>
 
+#include "buffer_manager.hpp"
+#include "chunk_compression_worker.hpp"
 #include "dictionary_segment.hpp"
+#include "encoding_advisor.hpp"
+#include "resolve_segment.hpp"
+#include "segment_encoding_utils.hpp"
+#include "validity_bitmap.hpp"
 #include "value_segment.hpp"
+#include "write_ahead_log.hpp"
+#include "zone_map.hpp"
 
+#include "import_export/binary_parser.hpp"
+#include "import_export/binary_writer.hpp"
 #include "resolve_type.hpp"
+#include "statistics/table_statistics.hpp"
 #include "types.hpp"
 #include "utils/assert.hpp"
+#include "utils/thread_pool.hpp"
 
 namespace opossum {
 
-Table::Table(const ChunkOffset target_chunk_size) : _target_chunk_size{target_chunk_size} { create_new_chunk(); }
+namespace {
+
+// used by tune_target_chunk_size() if the cache size cannot be determined
+constexpr auto DEFAULT_L2_CACHE_SIZE = size_t{1} << 20;
+
+// Scans run on at least this many chunks per core, so that cores that finish early take over remaining chunks.
+constexpr auto CHUNKS_PER_CORE = size_t{4};
+
+// Smaller chunks would be dominated by the per-chunk overhead of operators.
+constexpr auto MIN_TUNED_CHUNK_SIZE = ChunkOffset{4096};
+
+// Rows are appended to the delta in place up to its capacity, which starts at this many rows and then doubles.
+constexpr auto MIN_DELTA_CAPACITY = size_t{1024};
+
+}  // namespace
+
+Table::Table(const ChunkOffset target_chunk_size)
+    : _target_chunk_size{target_chunk_size > 0 ? target_chunk_size : std::numeric_limits<ChunkOffset>::max() - 1},
+      _table_statistics{std::make_shared<TableStatistics>()} {
+  create_new_chunk();
+}
+
+Table::~Table() = default;
 
 void Table::add_column(const std::string& name, const std::string& type) {
+  auto sequence_number = uint64_t{0};
+  auto* write_ahead_log = static_cast<WriteAheadLog*>(nullptr);
+  {
+    auto guard = std::lock_guard<std::mutex>(_chunk_access_mutex);
+    const auto chunks = _chunks.load();
+    Assert((chunks->size() == 1) && (chunks->back()->size() == 0), "You can only add a new column to an empty table.");
+    Assert(!_compression_worker || is_encoding_supported(_auto_compression_encoding_type, type),
+           "The encoding of the auto compression is not supported for the column type.");
+    _column_names.push_back(name);
+    _column_types.push_back(type);
+    _table_statistics->add_column(type);
+    // we can add the column to only the last chunk we know, as it should be the only one
+    // even if there are multiple empty chunks, we would only ever start filling the last one, so ignore all others here
+    resolve_data_type(type, [&](const auto data_type_t) {
+      using ColumnDataType = typename decltype(data_type_t)::type;
+      chunks->back()->add_segment(std::make_shared<ValueSegment<ColumnDataType>>());
+    });
+    write_ahead_log = _write_ahead_log.get();
+    if (write_ahead_log) {
+      sequence_number = write_ahead_log->log_column(static_cast<ColumnID>(_column_types.size() - 1), name, type);
+    }
+  }
+
+  // Other writers add their records while this one waits, so that they share the next sync of the log. The log is
+  // read while holding the lock, as it may be enabled concurrently.
+  if (write_ahead_log) {
+    write_ahead_log->wait_until_durable(sequence_number);
+  }
+}
+
+void Table::add_column_definition(const std::string& name, const std::string& type) {
   auto guard = std::lock_guard<std::mutex>(_chunk_access_mutex);
-  // can't use row_count function here, as it will also get a lock, running us into a deadlock
-  Assert((_chunks.size() == 1) && (_chunks.back()->size() == 0), "You can only add a new column to an empty table.");
+  Assert(_row_count == 0, "You can only add a column definition to an empty table.");
   _column_names.push_back(name);
   _column_types.push_back(type);
-  // we can add the column to only the last chunk we know, as it should be the only one
-  // even if there are multiple empty chunks, we would only ever start filling the last one, so ignore all others here
-  resolve_data_type(type, [&](const auto data_type_t) {
-    using ColumnDataType = typename decltype(data_type_t)::type;
-    _chunks.back()->add_segment(std::make_shared<ValueSegment<ColumnDataType>>());
-  });
+  _table_statistics->add_column(type);
 }
 
-void Table::add_column_definition(const std::string& name, const std::string& type) {
-  // Implementation goes here
+void Table::append(const std::vector<AllTypeVariant>& values) {
+  // The row is appended as a batch of one row, so that it becomes visible in all columns at once.
+  const auto row = _create_chunk();
+  row->append(values);
+  auto batch = std::vector<std::shared_ptr<AbstractSegment>>{};
+  for (auto column_id = ColumnID{0}; column_id < row->column_count(); ++column_id) {
+    batch.push_back(row->get_segment(column_id));
+  }
+
+  auto sequence_number = uint64_t{0};
+  auto sealed_chunks = SealedChunks{};
+  auto guard = std::unique_lock<std::mutex>(_chunk_access_mutex);
+  auto* const write_ahead_log = _write_ahead_log.get();
+  if (write_ahead_log) {
+    sequence_number = write_ahead_log->log_row(_row_count, _column_types, values);
+  }
+  _append_rows_unsafe(batch, 1, sealed_chunks);
+  guard.unlock();
+
+  _summarize_sealed_chunks(sealed_chunks);
+  if (write_ahead_log) {
+    write_ahead_log->wait_until_durable(sequence_number);
+  }
 }
 
-void Table::append(const std::vector<AllTypeVariant>& values) {
-  auto guard = std::lock_guard<std::mutex>(_chunk_access_mutex);
-  // if current chunk size is maxed out, create a new chunk, adding as many segments as we have columns
-  if (_chunks.back()->size() >= target_chunk_size()) {
-    // Since we already hold the lock on the _chunks vector, we call the unsafe function here to avoid deadlock.
-    _create_new_chunk_unsafe();
+void Table::append_batch(const std::vector<std::shared_ptr<AbstractSegment>>& batch) {
+  const auto batch_size = _validate_batch(batch);
+
+  auto sealed_chunks = SealedChunks{};
+  auto guard = std::unique_lock<std::mutex>(_chunk_access_mutex);
+  auto sequence_number = uint64_t{0};
+  auto* const write_ahead_log = _write_ahead_log.get();
+  if (write_ahead_log && batch_size > 0) {
+    sequence_number =
+        write_ahead_log->log_rows(_row_count, _column_types, batch, 0, static_cast<ChunkOffset>(batch_size));
+  }
+  _append_rows_unsafe(batch, batch_size, sealed_chunks);
+  guard.unlock();
+
+  _summarize_sealed_chunks(sealed_chunks);
+  if (write_ahead_log) {
+    write_ahead_log->wait_until_durable(sequence_number);
+  }
+}
+
+void Table::_append_rows_unsafe(const std::vector<std::shared_ptr<AbstractSegment>>& batch, const size_t batch_size,
+                                SealedChunks& sealed_chunks) {
+  auto batch_offset = size_t{0};
+  while (batch_offset < batch_size) {
+    // The target chunk size is read once, as tune_target_chunk_size() may change it concurrently.
+    const auto target_size = target_chunk_size();
+    if (_chunks.load()->back()->size() >= target_size) {
+      _create_new_chunk_unsafe(sealed_chunks);
+    }
+
+    // fill the last chunk up to the target chunk size
+    const auto row_count =
+        std::min(size_t{target_size - _chunks.load()->back()->size()}, batch_size - batch_offset);
+    const auto chunk = _reserve_delta_unsafe(batch, batch_offset, batch_offset + row_count);
+    _append_batch_range(*chunk, batch, batch_offset, batch_offset + row_count);
+    batch_offset += row_count;
+    _row_count += static_cast<ChunkOffset>(row_count);
+  }
+  _trigger_background_merge_unsafe();
+}
+
+std::shared_ptr<Chunk> Table::_reserve_delta_unsafe(const std::vector<std::shared_ptr<AbstractSegment>>& batch,
+                                                    const size_t begin_offset, const size_t end_offset) {
+  const auto chunks = _chunks.load();
+  const auto& delta = chunks->back();
+  Assert(_is_unencoded(*delta), "Rows cannot be appended to a compressed chunk.");
+  const auto begin = static_cast<ChunkOffset>(begin_offset);
+  const auto end = static_cast<ChunkOffset>(end_offset);
+
+  auto has_capacity = true;
+  for (auto column_id = ColumnID{0}; column_id < batch.size() && has_capacity; ++column_id) {
+    resolve_data_type(_column_types[column_id], [&](const auto data_type_t) {
+      using ColumnDataType = typename decltype(data_type_t)::type;
+      const auto& source = static_cast<const ValueSegment<ColumnDataType>&>(*batch[column_id]);
+      const auto& target = static_cast<const ValueSegment<ColumnDataType>&>(*delta->get_segment(column_id));
+      has_capacity = target.has_capacity_for(source, begin, end);
+    });
+  }
+  if (has_capacity) {
+    return delta;
+  }
+
+  // Readers access the delta without the lock, so its values must not move. Instead, it is replaced by a copy with
+  // twice the capacity, while readers of the previous chunk list keep the previous delta.
+  const auto row_count = size_t{delta->size()} + (end_offset - begin_offset);
+  const auto value_capacity = std::max(
+      std::min(std::max(2 * size_t{delta->size()}, MIN_DELTA_CAPACITY), size_t{target_chunk_size()}), row_count);
+  auto grown_delta = std::make_shared<Chunk>();
+  for (auto column_id = ColumnID{0}; column_id < batch.size(); ++column_id) {
+    resolve_data_type(_column_types[column_id], [&](const auto data_type_t) {
+      using ColumnDataType = typename decltype(data_type_t)::type;
+      const auto& source = static_cast<const ValueSegment<ColumnDataType>&>(*batch[column_id]);
+      const auto& target = static_cast<const ValueSegment<ColumnDataType>&>(*delta->get_segment(column_id));
+      grown_delta->add_segment(target.copy_with_capacity(value_capacity, source, begin, end));
+    });
+  }
+  _copy_invalid_rows(*delta, *grown_delta, 0, delta->size(), 0);
+
+  auto grown_chunks = std::make_shared<ChunkVector>(*chunks);
+  grown_chunks->back() = grown_delta;
+  _chunks.store(std::move(grown_chunks));
+  return grown_delta;
+}
+
+size_t Table::_validate_batch(const std::vector<std::shared_ptr<AbstractSegment>>& batch) const {
+  Assert(batch.size() == _column_types.size(), "The batch does not match the number of columns.");
+  const auto batch_size = batch.empty() ? size_t{0} : size_t{batch.front()->size()};
+  for (auto column_id = ColumnID{0}; column_id < batch.size(); ++column_id) {
+    Assert(batch[column_id]->size() == batch_size, "All columns of a batch must have the same size.");
+    resolve_data_type(_column_types[column_id], [&](const auto data_type_t) {
+      using ColumnDataType = typename decltype(data_type_t)::type;
+      Assert(std::dynamic_pointer_cast<ValueSegment<ColumnDataType>>(batch[column_id]),
+             "Batches must consist of value segments of the columns' types.");
+    });
+  }
+  return batch_size;
+}
+
+void Table::_append_batch_range(Chunk& chunk, const std::vector<std::shared_ptr<AbstractSegment>>& batch,
+                                const size_t begin_offset, const size_t end_offset) const {
+  // All columns are written before the rows are published, so that readers see each row in all columns or in none.
+  for (auto column_id = ColumnID{0}; column_id < batch.size(); ++column_id) {
+    resolve_data_type(_column_types[column_id], [&](const auto data_type_t) {
+      using ColumnDataType = typename decltype(data_type_t)::type;
+      const auto& source = static_cast<const ValueSegment<ColumnDataType>&>(*batch[column_id]);
+      auto& target = static_cast<ValueSegment<ColumnDataType>&>(*chunk.get_segment(column_id));
+      target.append_values(source, static_cast<ChunkOffset>(begin_offset), static_cast<ChunkOffset>(end_offset),
+                           false);
+    });
+  }
+  // Chunk::size() is the size of the first segment, so it is published last.
+  for (auto column_id = batch.size(); column_id > 0; --column_id) {
+    resolve_data_type(_column_types[column_id - 1], [&](const auto data_type_t) {
+      using ColumnDataType = typename decltype(data_type_t)::type;
+      static_cast<ValueSegment<ColumnDataType>&>(*chunk.get_segment(static_cast<ColumnID>(column_id - 1))).publish();
+    });
+  }
+}
+
+void Table::append_chunk(const std::shared_ptr<Chunk>& chunk, const bool defer_statistics) {
+  Assert(chunk->column_count() == column_count(), "The chunk does not match the number of columns.");
+  if (chunk->size() == 0) {
+    return;
+  }
+
+  // Zone maps and statistics of the new chunk are created without holding the lock, so that writers publishing
+  // chunks concurrently do not wait for each other.
+  const auto defers_statistics = defer_statistics && !_compression_worker;
+  if (!_compression_worker && !defers_statistics && !chunk->zone_map(ColumnID{0})) {
+    _create_zone_maps(*chunk);
+  }
+
+  auto sequence_number = uint64_t{0};
+  auto* write_ahead_log = static_cast<WriteAheadLog*>(nullptr);
+  auto sealed_chunks = SealedChunks{};
+  {
+    auto guard = std::lock_guard<std::mutex>(_chunk_access_mutex);
+    write_ahead_log = _write_ahead_log.get();
+    if (write_ahead_log) {
+      auto segments = std::vector<std::shared_ptr<AbstractSegment>>{};
+      for (auto column_id = ColumnID{0}; column_id < _column_types.size(); ++column_id) {
+        segments.push_back(chunk->get_segment(column_id));
+      }
+      sequence_number = write_ahead_log->log_rows(_row_count, _column_types, segments, 0, chunk->size());
+    }
+
+    auto chunks = std::make_shared<ChunkVector>(*_chunks.load());
+    // An empty last chunk is replaced. A partially filled one is sealed, as it is no longer the last chunk.
+    if (chunks->back()->size() == 0) {
+      chunks->back() = chunk;
+    } else {
+      _seal_chunk_unsafe(chunks->back(), sealed_chunks);
+      chunks->push_back(chunk);
+    }
+    if (defers_statistics) {
+      _unsummarized_chunks.push_back(chunk);
+    }
+
+    // the appended chunk does not receive any more rows, so append() continues in a new chunk
+    chunks->push_back(_create_chunk());
+    _chunks.store(std::move(chunks));
+    _row_count += chunk->size();
+  }
+
+  if (_compression_worker) {
+    _enqueue_compression(chunk);
+  } else if (!defers_statistics) {
+    _table_statistics->add_chunk(*chunk);
+  }
+  _summarize_sealed_chunks(sealed_chunks);
+
+  if (!_is_unencoded(*chunk)) {
+    BufferManager::get().register_chunk(chunk, _column_types);
+  }
+
+  if (write_ahead_log) {
+    write_ahead_log->wait_until_durable(sequence_number);
   }
+}
 
-  _chunks.back()->append(values);
+void Table::emplace_chunk(const std::shared_ptr<Chunk>& chunk) {
+  Assert(chunk->column_count() == column_count(), "The chunk does not match the number of columns.");
+  auto guard = std::lock_guard<std::mutex>(_chunk_access_mutex);
+  auto chunks = std::make_shared<ChunkVector>(*_chunks.load());
+  if (chunks->back()->size() == 0) {
+    chunks->back() = chunk;
+  } else {
+    chunks->push_back(chunk);
+  }
+  _chunks.store(std::move(chunks));
+  _row_count += chunk->size();
 }
 
-void Table::_create_new_chunk_unsafe() {
-  auto new_chunk = std::make_shared<Chunk>();
+std::shared_ptr<Chunk> Table::_create_chunk() const {
+  auto chunk = std::make_shared<Chunk>();
   for (const auto& column_type : _column_types) {
     resolve_data_type(column_type, [&](const auto data_type_t) {
       using ColumnDataType = typename decltype(data_type_t)::type;
-      new_chunk->add_segment(std::make_shared<ValueSegment<ColumnDataType>>());
+      chunk->add_segment(std::make_shared<ValueSegment<ColumnDataType>>());
     });
   }
-  _chunks.push_back(new_chunk);
+  return chunk;
+}
+
+void Table::_seal_chunk_unsafe(const std::shared_ptr<Chunk>& chunk, SealedChunks& sealed_chunks) {
+  // A sealed chunk will not receive any more rows, so its zone maps and statistics can be created. With auto
+  // compression, this is done together with the compression in the background. Otherwise, it is done once the lock is
+  // released, so that other writers do not wait for it.
+  if (_compression_worker) {
+    _enqueue_compression(chunk);
+  } else {
+    sealed_chunks.push_back(chunk);
+  }
+}
+
+void Table::_summarize_sealed_chunks(const SealedChunks& sealed_chunks) const {
+  for (const auto& chunk : sealed_chunks) {
+    if (!chunk->zone_map(ColumnID{0})) {
+      _create_zone_maps(*chunk);
+    }
+    _table_statistics->add_chunk(*chunk);
+  }
+}
+
+void Table::_create_new_chunk_unsafe(SealedChunks& sealed_chunks) {
+  auto chunks = std::make_shared<ChunkVector>(*_chunks.load());
+  if (!chunks->empty() && chunks->back()->size() > 0) {
+    _seal_chunk_unsafe(chunks->back(), sealed_chunks);
+  }
+  chunks->push_back(_create_chunk());
+  _chunks.store(std::move(chunks));
+}
+
+void Table::_create_zone_maps(Chunk& chunk) const {
+  auto zone_maps = std::vector<std::shared_ptr<BaseZoneMap>>{};
+  zone_maps.reserve(_column_types.size());
+  for (auto column_id = ColumnID{0}; column_id < _column_types.size(); ++column_id) {
+    zone_maps.push_back(create_zone_map(_column_types[column_id], chunk.get_segment(column_id)));
+  }
+  chunk.set_zone_maps(std::move(zone_maps));
 }
 
 void Table::create_new_chunk() {
-  auto guard = std::lock_guard<std::mutex>(_chunk_access_mutex);
-  _create_new_chunk_unsafe();
+  auto sealed_chunks = SealedChunks{};
+  {
+    auto guard = std::lock_guard<std::mutex>(_chunk_access_mutex);
+    _create_new_chunk_unsafe(sealed_chunks);
+  }
+  _summarize_sealed_chunks(sealed_chunks);
 }
 
 ColumnCount Table::column_count() const { return static_cast<ColumnCount>(_column_names.size()); }
 
-ChunkOffset Table::row_count() const {
-  auto total_rows = ChunkOffset{0};
-  auto guard = std::lock_guard<std::mutex>(_chunk_access_mutex);
+ChunkOffset Table::row_count() const { return _row_count; }
 
-  for (const auto& chunk : _chunks) {
-    total_rows += chunk->size();
+ChunkOffset Table::approx_valid_row_count() const {
+  auto valid_row_count = ChunkOffset{0};
+  for (const auto& chunk : *_chunks.load()) {
+    valid_row_count += chunk->size() - chunk->invalid_row_count();
   }
-  return total_rows;
+  return valid_row_count;
 }
 
-ChunkID Table::chunk_count() const {
-  auto guard = std::lock_guard<std::mutex>(_chunk_access_mutex);
-  return static_cast<ChunkID>(_chunks.size());
-}
+ChunkID Table::chunk_count() const { return static_cast<ChunkID>(_chunks.load()->size()); }
 
 ColumnID Table::column_id_by_name(const std::string& column_name) const {
   auto column_name_location = std::find(column_names().begin(), column_names().end(), column_name);
@@ -97,43 +404,648 @@ const std::string& Table::column_name(const ColumnID column_id) const { return _
 
 const std::string& Table::column_type(const ColumnID column_id) const { return _column_types.at(column_id); }
 
-std::shared_ptr<Chunk> Table::get_chunk(ChunkID chunk_id) {
+std::shared_ptr<Chunk> Table::get_chunk(ChunkID chunk_id) { return _chunks.load()->at(chunk_id); }
+
+std::shared_ptr<const Chunk> Table::get_chunk(ChunkID chunk_id) const { return _chunks.load()->at(chunk_id); }
+
+std::shared_ptr<const Table::ChunkVector> Table::chunks() const { return _chunks.load(); }
+
+uint64_t Table::layout_version() const { return _layout_version; }
+
+void Table::enable_auto_compression(const EncodingType encoding_type) {
   auto guard = std::lock_guard<std::mutex>(_chunk_access_mutex);
-  return _chunks.at(chunk_id);
+  Assert(!_compression_worker, "Auto compression is already enabled.");
+  for (const auto& column_type : _column_types) {
+    Assert(is_encoding_supported(encoding_type, column_type),
+           "The encoding of the auto compression is not supported for the column type.");
+  }
+  _auto_compression_encoding_type = encoding_type;
+  _compression_worker = std::make_unique<ChunkCompressionWorker>(
+      [this](const std::shared_ptr<Chunk>& chunk) { _compress_sealed_chunk(chunk); });
+}
+
+void Table::wait_for_auto_compression() {
+  if (_compression_worker) {
+    _compression_worker->wait_until_idle();
+  }
+}
+
+void Table::_compress_sealed_chunk(const std::shared_ptr<Chunk>& chunk) {
+  // Each sealed chunk is added to the statistics exactly once, here. If the chunk was replaced in the meantime (e.g.,
+  // by compress_chunk), its replacement holds the same values, so the chunk itself is added.
+  auto summarized_chunk = chunk;
+  auto failure = std::exception_ptr{};
+  if (_is_unencoded(*chunk)) {
+    try {
+      if (auto compressed_chunk = _compress(chunk, _auto_compression_encoding_type)) {
+        summarized_chunk = std::move(compressed_chunk);
+      }
+    } catch (...) {
+      failure = std::current_exception();
+    }
+  }
+  if (!summarized_chunk->zone_map(ColumnID{0})) {
+    // Chunks that were appended in compressed form or failed to compress only lack their zone maps and statistics.
+    _create_zone_maps(*summarized_chunk);
+  }
+  _table_statistics->add_chunk(*summarized_chunk);
+
+  // A chunk whose compression failed stays unencoded, but is no longer kept from being compacted or coalesced.
+  {
+    auto guard = std::lock_guard<std::mutex>(_pending_compression_mutex);
+    _pending_compressions.erase(chunk.get());
+  }
+  if (failure) {
+    std::rethrow_exception(failure);
+  }
+}
+
+void Table::_enqueue_compression(const std::shared_ptr<Chunk>& chunk) {
+  {
+    auto guard = std::lock_guard<std::mutex>(_pending_compression_mutex);
+    _pending_compressions.insert(chunk.get());
+  }
+  _compression_worker->enqueue(chunk);
+}
+
+bool Table::_awaits_compression(const Chunk& chunk) const {
+  auto guard = std::lock_guard<std::mutex>(_pending_compression_mutex);
+  return _pending_compressions.contains(&chunk);
+}
+
+bool Table::_is_unencoded(const Chunk& chunk) const {
+  if (chunk.column_count() == 0) {
+    return true;
+  }
+  // only compressed chunks are evicted, so they are not restored to check
+  if (!chunk.is_resident()) {
+    return false;
+  }
+
+  auto is_unencoded = true;
+  resolve_data_type(_column_types.front(), [&](const auto data_type_t) {
+    using ColumnDataType = typename decltype(data_type_t)::type;
+    const auto& segment = chunk.get_segment(ColumnID{0});
+    is_unencoded = static_cast<bool>(std::dynamic_pointer_cast<ValueSegment<ColumnDataType>>(segment));
+  });
+  return is_unencoded;
+}
+
+bool Table::_is_dictionary_encoded(const Chunk& chunk) const {
+  auto is_dictionary_encoded = true;
+  for (auto column_id = ColumnID{0}; column_id < _column_types.size(); ++column_id) {
+    resolve_data_type(_column_types[column_id], [&](const auto data_type_t) {
+      using ColumnDataType = typename decltype(data_type_t)::type;
+      is_dictionary_encoded &=
+          static_cast<bool>(std::dynamic_pointer_cast<DictionarySegment<ColumnDataType>>(chunk.get_segment(column_id)));
+    });
+  }
+  return is_dictionary_encoded;
 }
 
-std::shared_ptr<const Chunk> Table::get_chunk(ChunkID chunk_id) const {
+void Table::merge_delta() {
+  auto merge_guard = std::lock_guard<std::mutex>(_merge_mutex);
+  _is_merge_pending = false;
+
+  // The rows of the delta are copied while holding the lock, as further rows are appended to it in place.
+  auto delta = std::shared_ptr<Chunk>{};
+  auto main_chunk = std::shared_ptr<Chunk>{};
+  auto delta_segments = std::vector<std::shared_ptr<AbstractSegment>>{};
+  auto merged_rows = _create_chunk();
+  {
+    auto guard = std::lock_guard<std::mutex>(_chunk_access_mutex);
+    const auto chunks = _chunks.load();
+    delta = chunks->back();
+    if (delta->size() == 0 || !_is_unencoded(*delta)) {
+      return;
+    }
+    if (chunks->size() > 1) {
+      const auto& last_main_chunk = (*chunks)[chunks->size() - 2];
+      if (last_main_chunk->size() + delta->size() <= _target_chunk_size && _is_dictionary_encoded(*last_main_chunk)) {
+        main_chunk = last_main_chunk;
+      }
+    }
+    for (auto column_id = ColumnID{0}; column_id < _column_types.size(); ++column_id) {
+      delta_segments.push_back(delta->get_segment(column_id));
+    }
+    _append_batch_range(*merged_rows, delta_segments, 0, delta->size());
+  }
+
+  // Encode the copied rows and merge them into the last chunk of the main, if it has room.
+  auto merged_chunk = std::make_shared<Chunk>();
+  for (auto column_id = ColumnID{0}; column_id < _column_types.size(); ++column_id) {
+    resolve_data_type(_column_types[column_id], [&](const auto data_type_t) {
+      using ColumnDataType = typename decltype(data_type_t)::type;
+      auto segment = std::make_shared<DictionarySegment<ColumnDataType>>(merged_rows->get_segment(column_id));
+      if (main_chunk) {
+        const auto main_segment =
+            std::static_pointer_cast<const DictionarySegment<ColumnDataType>>(main_chunk->get_segment(column_id));
+        segment = DictionarySegment<ColumnDataType>::merge({main_segment, segment});
+      }
+      merged_chunk->add_segment(segment);
+    });
+  }
+  _create_zone_maps(*merged_chunk);
+
+  {
+    auto guard = std::lock_guard<std::mutex>(_chunk_access_mutex);
+    auto chunks = std::make_shared<ChunkVector>(*_chunks.load());
+    // The merge is dropped if the delta became full and was sealed, was replaced by a copy with more capacity, or the
+    // main chunk was replaced in the meantime. A later trigger merges the delta again.
+    const auto main_chunk_id = static_cast<ChunkID>(chunks->size() - 2);
+    if (chunks->back() != delta || (main_chunk && (*chunks)[main_chunk_id] != main_chunk)) {
+      return;
+    }
+
+    // Rows that were appended during the merge form the new delta. Rows that were deleted before the chunks are
+    // replaced stay deleted.
+    auto new_delta = _create_chunk();
+    _append_batch_range(*new_delta, delta_segments, merged_rows->size(), delta->size());
+    const auto main_size = main_chunk ? main_chunk->size() : ChunkOffset{0};
+    if (main_chunk) {
+      _copy_invalid_rows(*main_chunk, *merged_chunk, 0, main_size, 0);
+    }
+    _copy_invalid_rows(*delta, *merged_chunk, 0, merged_rows->size(), main_size);
+    _copy_invalid_rows(*delta, *new_delta, merged_rows->size(), delta->size(), 0);
+    if (main_chunk) {
+      (*chunks)[main_chunk_id] = merged_chunk;
+      chunks->back() = new_delta;
+    } else {
+      chunks->back() = merged_chunk;
+      chunks->push_back(new_delta);
+    }
+    _chunks.store(std::move(chunks));
+    ++_layout_version;
+  }
+
+  // The rows of the main chunk were added to the statistics already.
+  _table_statistics->add_chunk(main_chunk ? *merged_rows : *merged_chunk);
+  BufferManager::get().register_chunk(merged_chunk, _column_types);
+}
+
+void Table::enable_background_merge(const ChunkOffset delta_row_threshold) {
+  auto guard = std::lock_guard<std::mutex>(_chunk_access_mutex);
+  Assert(!_merge_worker, "The background merge is already enabled.");
+  Assert(delta_row_threshold > 0, "The delta must hold rows to be merged.");
+  _merge_threshold = delta_row_threshold;
+  _merge_worker = std::make_unique<ChunkCompressionWorker>([this](const std::shared_ptr<Chunk>&) { merge_delta(); });
+}
+
+void Table::wait_for_background_merge() {
+  if (_merge_worker) {
+    _merge_worker->wait_until_idle();
+  }
+}
+
+void Table::_trigger_background_merge_unsafe() {
+  if (!_merge_worker) {
+    return;
+  }
+  const auto chunks = _chunks.load();
+  if (chunks->back()->size() >= _merge_threshold && !_is_merge_pending.exchange(true)) {
+    _merge_worker->enqueue(chunks->back());
+  }
+}
+
+size_t Table::delete_rows(const PosList& positions, const std::optional<uint64_t> layout_version) {
+  Assert(!_write_ahead_log, "Deletes are not logged to the write-ahead log.");
+
+  // Positions are grouped by chunk, so that each chunk is invalidated once. The lock keeps chunks from being replaced
+  // (e.g., by compress_chunk) between looking them up and invalidating their rows.
+  auto chunk_offsets = std::map<ChunkID, std::vector<ChunkOffset>>{};
+  for (const auto& row_id : positions) {
+    chunk_offsets[row_id.chunk_id].push_back(row_id.chunk_offset);
+  }
+
   auto guard = std::lock_guard<std::mutex>(_chunk_access_mutex);
-  return _chunks.at(chunk_id);
+  Assert(!layout_version || *layout_version == _layout_version,
+         "Rows were moved since the positions were obtained, e.g., by compact().");
+  const auto chunks = _chunks.load();
+  auto deleted_row_count = size_t{0};
+  for (const auto& [chunk_id, offsets] : chunk_offsets) {
+    deleted_row_count += chunks->at(chunk_id)->invalidate_rows(offsets);
+  }
+  return deleted_row_count;
+}
+
+size_t Table::compact(const float invalid_row_share) {
+  Assert(!_write_ahead_log, "Compacted rows cannot be replayed from the write-ahead log.");
+  Assert(invalid_row_share > 0.0f, "Only chunks with invalid rows can be compacted.");
+
+  auto& thread_pool = ThreadPool::get();
+  auto tasks = std::vector<std::future<size_t>>{};
+  const auto chunks = _chunks.load();
+  for (auto chunk_id = ChunkID{0}; chunk_id + 1 < chunks->size(); ++chunk_id) {
+    // The chunk is passed by pointer, as its id shifts if chunks before it are coalesced meanwhile.
+    const auto& chunk = (*chunks)[chunk_id];
+    const auto invalid_row_count = chunk->invalid_row_count();
+    if (invalid_row_count > 0 && static_cast<float>(invalid_row_count) >= invalid_row_share * chunk->size() &&
+        !_awaits_compression(*chunk)) {
+      tasks.push_back(thread_pool.submit([this, chunk]() { return _compact_chunk(chunk); }));
+    }
+  }
+
+  for (const auto& task : tasks) {
+    thread_pool.wait(task);
+  }
+  auto removed_row_count = size_t{0};
+  for (auto& task : tasks) {
+    removed_row_count += task.get();
+  }
+  return removed_row_count;
+}
+
+size_t Table::_compact_chunk(const std::shared_ptr<Chunk>& chunk) {
+  auto valid_offsets = std::vector<ChunkOffset>{};
+  chunk->validity()->for_each_valid(0, chunk->size(),
+                                    [&](const ChunkOffset chunk_offset) { valid_offsets.push_back(chunk_offset); });
+
+  // An empty chunk keeps ValueSegments, as the encodings expect at least one row.
+  auto compacted_chunk = valid_offsets.empty() ? _create_chunk() : std::make_shared<Chunk>();
+  for (auto column_id = ColumnID{0}; column_id < _column_types.size() && !valid_offsets.empty(); ++column_id) {
+    const auto& column_type = _column_types[column_id];
+    const auto segment = chunk->get_segment(column_id);
+    resolve_data_type(column_type, [&](const auto data_type_t) {
+      using ColumnDataType = typename decltype(data_type_t)::type;
+      auto values = ValueVector<ColumnDataType>{};
+      resolve_segment<ColumnDataType>(*segment, [&](const auto& typed_segment) {
+        for (const auto chunk_offset : valid_offsets) {
+          values.push_back(typed_segment.get(chunk_offset));
+        }
+      });
+      const auto value_segment = std::make_shared<ValueSegment<ColumnDataType>>(std::move(values));
+      compacted_chunk->add_segment(
+          encode_segment(segment_encoding_type(column_type, *segment), column_type, value_segment));
+    });
+  }
+  if (!valid_offsets.empty()) {
+    _create_zone_maps(*compacted_chunk);
+  }
+
+  {
+    auto guard = std::lock_guard<std::mutex>(_chunk_access_mutex);
+    auto chunks = std::make_shared<ChunkVector>(*_chunks.load());
+    const auto chunk_position = std::find(chunks->begin(), chunks->end(), chunk);
+    if (chunk_position == chunks->end()) {
+      return 0;
+    }
+
+    // Rows that were deleted during the rewrite are invalidated at their new positions.
+    const auto validity = chunk->validity();
+    auto late_deletes = std::vector<ChunkOffset>{};
+    for (auto new_offset = ChunkOffset{0}; new_offset < valid_offsets.size(); ++new_offset) {
+      if (!validity->is_valid(valid_offsets[new_offset])) {
+        late_deletes.push_back(new_offset);
+      }
+    }
+    if (!late_deletes.empty()) {
+      compacted_chunk->invalidate_rows(late_deletes);
+    }
+
+    *chunk_position = compacted_chunk;
+    _chunks.store(std::move(chunks));
+    ++_layout_version;
+    _row_count -= chunk->size() - compacted_chunk->size();
+  }
+
+  if (!_is_unencoded(*compacted_chunk)) {
+    BufferManager::get().register_chunk(compacted_chunk, _column_types);
+  }
+  return chunk->size() - compacted_chunk->size();
+}
+
+ChunkID Table::coalesce_chunks(const ChunkOffset min_chunk_size) {
+  // Chunks that wait for auto compression are not coalesced, as the worker replaces them. Pending compressions are
+  // finished first, so that the chunks sealed so far can be coalesced.
+  wait_for_auto_compression();
+
+  // Runs of small chunks are formed greedily. The delta is never part of a run, as it still receives rows.
+  const auto chunks = _chunks.load();
+  auto runs = std::vector<ChunkVector>{};
+  auto run_size = size_t{0};
+  for (auto chunk_id = ChunkID{0}; chunk_id + 1 < chunks->size(); ++chunk_id) {
+    const auto& chunk = (*chunks)[chunk_id];
+    if (chunk->size() >= min_chunk_size || _awaits_compression(*chunk)) {
+      run_size = 0;
+      continue;
+    }
+
+    if (run_size > 0 && run_size + chunk->size() <= _target_chunk_size &&
+        _can_coalesce(*runs.back().back(), *chunk)) {
+      runs.back().push_back(chunk);
+      run_size += chunk->size();
+      continue;
+    }
+    if (!runs.empty() && runs.back().size() == 1) {
+      runs.pop_back();
+    }
+    runs.push_back(ChunkVector{chunk});
+    run_size = chunk->size();
+  }
+  if (!runs.empty() && runs.back().size() == 1) {
+    runs.pop_back();
+  }
+
+  auto& thread_pool = ThreadPool::get();
+  auto tasks = std::vector<std::future<std::shared_ptr<Chunk>>>{};
+  for (const auto& run : runs) {
+    tasks.push_back(thread_pool.submit([this, &run]() { return _coalesce(run); }));
+  }
+  for (const auto& task : tasks) {
+    thread_pool.wait(task);
+  }
+  auto coalesced_chunks = ChunkVector{};
+  for (auto& task : tasks) {
+    coalesced_chunks.push_back(task.get());
+  }
+
+  auto removed_chunk_count = ChunkID{0};
+  {
+    auto guard = std::lock_guard<std::mutex>(_chunk_access_mutex);
+    auto chunks = std::make_shared<ChunkVector>(*_chunks.load());
+    // Runs are found by pointer, as other reorganizations (e.g., a concurrent coalesce_chunks()) may have shifted
+    // their ids. A run is dropped if one of its chunks was replaced in the meantime, e.g., by compact().
+    for (auto run_index = size_t{0}; run_index < runs.size(); ++run_index) {
+      const auto& run = runs[run_index];
+      const auto first_position = std::find(chunks->begin(), chunks->end(), run.front());
+      if (static_cast<size_t>(std::distance(first_position, chunks->end())) < run.size() ||
+          !std::equal(run.cbegin(), run.cend(), first_position)) {
+        continue;
+      }
+
+      // Rows that were deleted during the merge are carried over as well.
+      auto coalesced_chunk = coalesced_chunks[run_index];
+      auto target_offset = ChunkOffset{0};
+      for (const auto& chunk : run) {
+        _copy_invalid_rows(*chunk, *coalesced_chunk, 0, chunk->size(), target_offset);
+        target_offset += chunk->size();
+      }
+
+      *first_position = coalesced_chunk;
+      chunks->erase(first_position + 1, first_position + run.size());
+      removed_chunk_count += static_cast<ChunkID>(run.size() - 1);
+    }
+    _chunks.store(std::move(chunks));
+    if (removed_chunk_count > 0) {
+      ++_layout_version;
+    }
+  }
+
+  for (const auto& coalesced_chunk : coalesced_chunks) {
+    if (!_is_unencoded(*coalesced_chunk)) {
+      BufferManager::get().register_chunk(coalesced_chunk, _column_types);
+    }
+  }
+  return removed_chunk_count;
 }
 
-void Table::compress_chunk(const ChunkID chunk_id) {
-  auto threads = std::vector<std::thread>{_column_types.size()};
-  const auto& raw_chunk = get_chunk(chunk_id);  // get_chunk performs range check, so we are safe
+bool Table::_can_coalesce(const Chunk& chunk, const Chunk& next_chunk) const {
+  auto can_coalesce = true;
+  for (auto column_id = ColumnID{0}; column_id < _column_types.size() && can_coalesce; ++column_id) {
+    const auto& column_type = _column_types[column_id];
+    const auto encoding_type = segment_encoding_type(column_type, *chunk.get_segment(column_id));
+    can_coalesce = (encoding_type == EncodingType::Unencoded || encoding_type == EncodingType::Dictionary) &&
+                   encoding_type == segment_encoding_type(column_type, *next_chunk.get_segment(column_id));
+  }
+  return can_coalesce;
+}
+
+std::shared_ptr<Chunk> Table::_coalesce(const ChunkVector& chunks) const {
+  auto coalesced_chunk = std::make_shared<Chunk>();
+  for (auto column_id = ColumnID{0}; column_id < _column_types.size(); ++column_id) {
+    resolve_data_type(_column_types[column_id], [&](const auto data_type_t) {
+      using ColumnDataType = typename decltype(data_type_t)::type;
+      const auto first_segment = chunks.front()->get_segment(column_id);
+      if (std::dynamic_pointer_cast<ValueSegment<ColumnDataType>>(first_segment)) {
+        auto segment = std::make_shared<ValueSegment<ColumnDataType>>();
+        for (const auto& chunk : chunks) {
+          const auto& source = static_cast<const ValueSegment<ColumnDataType>&>(*chunk->get_segment(column_id));
+          segment->append_values(source, 0, source.size());
+        }
+        coalesced_chunk->add_segment(segment);
+        return;
+      }
+
+      auto segments = std::vector<std::shared_ptr<const DictionarySegment<ColumnDataType>>>{};
+      for (const auto& chunk : chunks) {
+        segments.push_back(std::static_pointer_cast<const DictionarySegment<ColumnDataType>>(
+            chunk->get_segment(column_id)));
+      }
+      coalesced_chunk->add_segment(DictionarySegment<ColumnDataType>::merge(segments));
+    });
+  }
+  _create_zone_maps(*coalesced_chunk);
+  return coalesced_chunk;
+}
+
+ChunkOffset Table::recommend_target_chunk_size(const size_t row_count, const size_t bytes_per_value,
+                                               const size_t cache_size, const size_t core_count) {
+  auto chunk_size = cache_size / std::max(bytes_per_value, size_t{1});
+  if (row_count > 0) {
+    const auto chunk_count = std::max(core_count, size_t{1}) * CHUNKS_PER_CORE;
+    chunk_size = std::min(chunk_size, (row_count + chunk_count - 1) / chunk_count);
+  }
+
+  // Chunk sizes are multiples of a word of the validity bitmap, so that no word spans two chunks.
+  const auto max_chunk_size = size_t{std::numeric_limits<ChunkOffset>::max() - 1};
+  chunk_size = std::clamp(chunk_size, size_t{MIN_TUNED_CHUNK_SIZE}, max_chunk_size);
+  return static_cast<ChunkOffset>(chunk_size - chunk_size % ValidityBitmap::WORD_BITS);
+}
+
+ChunkOffset Table::tune_target_chunk_size() {
+  auto cache_size = DEFAULT_L2_CACHE_SIZE;
+#ifdef _SC_LEVEL2_CACHE_SIZE
+  const auto l2_cache_size = sysconf(_SC_LEVEL2_CACHE_SIZE);
+  if (l2_cache_size > 0) {
+    cache_size = static_cast<size_t>(l2_cache_size);
+  }
+#endif
+
+  const auto target_chunk_size =
+      recommend_target_chunk_size(row_count(), _max_bytes_per_value(), cache_size, ThreadPool::get().worker_count());
+  auto guard = std::lock_guard<std::mutex>(_chunk_access_mutex);
+  _target_chunk_size = target_chunk_size;
+  return target_chunk_size;
+}
+
+size_t Table::_max_bytes_per_value() const {
+  auto max_bytes_per_value = size_t{0};
+  const auto chunks = _chunks.load();
+  for (auto column_id = ColumnID{0}; column_id < _column_types.size(); ++column_id) {
+    auto memory_usage = size_t{0};
+    auto value_count = size_t{0};
+    for (const auto& chunk : *chunks) {
+      // evicted chunks are not restored for an estimate
+      if (chunk->is_resident() && chunk->size() > 0) {
+        memory_usage += chunk->get_segment(column_id)->estimate_memory_usage();
+        value_count += chunk->size();
+      }
+    }
+
+    if (value_count > 0) {
+      max_bytes_per_value = std::max(max_bytes_per_value, memory_usage / value_count);
+    } else {
+      resolve_data_type(_column_types[column_id], [&](const auto data_type_t) {
+        using ColumnDataType = typename decltype(data_type_t)::type;
+        max_bytes_per_value = std::max(max_bytes_per_value, sizeof(ColumnDataType));
+      });
+    }
+  }
+  return max_bytes_per_value;
+}
+
+void Table::_copy_invalid_rows(const Chunk& source, Chunk& target, const ChunkOffset source_begin,
+                               const ChunkOffset source_end, const ChunkOffset target_begin) {
+  const auto validity = source.validity();
+  if (!validity) {
+    return;
+  }
+
+  auto invalid_offsets = std::vector<ChunkOffset>{};
+  for (auto chunk_offset = source_begin; chunk_offset < std::min(source_end, validity->size()); ++chunk_offset) {
+    if (!validity->is_valid(chunk_offset)) {
+      invalid_offsets.push_back(target_begin + chunk_offset - source_begin);
+    }
+  }
+  if (!invalid_offsets.empty()) {
+    target.invalidate_rows(invalid_offsets);
+  }
+}
+
+void Table::compress_all_chunks(const EncodingType encoding_type) {
+  // The last chunk is sealed first, so that rows appended during the compression go to a new chunk instead of being
+  // lost when the compressed chunk replaces it.
+  auto sealed_chunks = SealedChunks{};
+  auto chunk_count = ChunkID{};
+  {
+    auto guard = std::lock_guard<std::mutex>(_chunk_access_mutex);
+    if (_chunks.load()->back()->size() > 0) {
+      _create_new_chunk_unsafe(sealed_chunks);
+    }
+    chunk_count = static_cast<ChunkID>(_chunks.load()->size() - 1);
+  }
+  _summarize_sealed_chunks(sealed_chunks);
+
+  auto& thread_pool = ThreadPool::get();
+  auto tasks = std::vector<std::future<void>>{};
+  for (auto chunk_id = ChunkID{0}; chunk_id < chunk_count; ++chunk_id) {
+    const auto chunk = get_chunk(chunk_id);
+    if (chunk->size() == 0 || !_is_unencoded(*chunk)) {
+      continue;
+    }
+    // The pool bounds the number of chunks that are compressed concurrently. Each chunk task submits its columns as
+    // tasks of their own and helps to execute them while waiting.
+    tasks.push_back(thread_pool.submit([this, chunk_id, encoding_type]() { compress_chunk(chunk_id, encoding_type); }));
+  }
+
+  for (const auto& task : tasks) {
+    thread_pool.wait(task);
+  }
+  for (auto& task : tasks) {
+    task.get();
+  }
+}
+
+std::shared_ptr<const TableStatistics> Table::table_statistics() const {
+  // Chunks whose statistics were deferred by append_chunk are summarized by the first caller, while later callers wait
+  // for it to finish.
+  auto summary_guard = std::lock_guard<std::mutex>(_summary_mutex);
+  auto unsummarized_chunks = SealedChunks{};
+  {
+    auto guard = std::lock_guard<std::mutex>(_chunk_access_mutex);
+    std::swap(unsummarized_chunks, _unsummarized_chunks);
+  }
+  _summarize_sealed_chunks(unsummarized_chunks);
+  return _table_statistics;
+}
+
+void Table::enable_write_ahead_log(const std::string& file_name) {
+  auto sequence_number = uint64_t{0};
+  {
+    auto guard = std::lock_guard<std::mutex>(_chunk_access_mutex);
+    Assert(!_write_ahead_log, "The write-ahead log is already enabled.");
+    _write_ahead_log = std::make_unique<WriteAheadLog>(file_name, _target_chunk_size);
+    // The columns are logged, so that the table can be recovered without a checkpoint. Replaying them again on top of
+    // a table that has them already has no effect.
+    for (auto column_id = ColumnID{0}; column_id < _column_types.size(); ++column_id) {
+      sequence_number = _write_ahead_log->log_column(column_id, _column_names[column_id], _column_types[column_id]);
+    }
+  }
+  _write_ahead_log->wait_until_durable(sequence_number);
+}
+
+void Table::checkpoint(const std::string& file_name) {
+  auto guard = std::lock_guard<std::mutex>(_chunk_access_mutex);
+  BinaryWriter::write(*this, file_name);
+  if (_write_ahead_log) {
+    _write_ahead_log->truncate();
+  }
+}
+
+std::shared_ptr<Table> Table::recover(const std::string& checkpoint_file_name, const std::string& log_file_name) {
+  auto table = std::shared_ptr<Table>{};
+  if (std::filesystem::exists(checkpoint_file_name)) {
+    table = BinaryParser::parse(checkpoint_file_name);
+  } else {
+    table = std::make_shared<Table>(WriteAheadLog::read_target_chunk_size(log_file_name));
+  }
+  WriteAheadLog::replay(log_file_name, *table);
+  table->enable_write_ahead_log(log_file_name);
+  return table;
+}
+
+void Table::set_encoding_log(std::ostream* encoding_log) { _encoding_log = encoding_log; }
+
+void Table::compress_chunk(const ChunkID chunk_id, const EncodingType encoding_type) {
+  // The last chunk is sealed first, as rows appended to it during the compression would be lost.
+  auto sealed_chunks = SealedChunks{};
+  {
+    auto guard = std::lock_guard<std::mutex>(_chunk_access_mutex);
+    if (chunk_id + 1 == _chunks.load()->size()) {
+      _create_new_chunk_unsafe(sealed_chunks);
+    }
+  }
+  _summarize_sealed_chunks(sealed_chunks);
+
+  // get_chunk performs range check, so we are safe. The statistics already cover the chunk, as it is sealed.
+  _compress(get_chunk(chunk_id), encoding_type);
+}
+
+std::shared_ptr<Chunk> Table::_compress(const std::shared_ptr<Chunk>& raw_chunk, const EncodingType encoding_type) {
+  auto workers = std::vector<std::future<void>>{_column_types.size()};
   auto compressed_chunk = std::make_shared<Chunk>();
   auto compressed_segments = std::vector<std::shared_ptr<AbstractSegment>>{_column_types.size()};
   auto segments_vec_mutex = std::mutex{};
 
-  auto compress_segment = [&raw_chunk, &compressed_segments, &segments_vec_mutex](const auto segment_type,
-                                                                                  const auto column_index) {
-    resolve_data_type(segment_type, [&](const auto data_type_t) {
-      // figure out the type of the segment
-      using ColumnDataType = typename decltype(data_type_t)::type;
-      auto guard = std::lock_guard<std::mutex>(segments_vec_mutex);
-      // add compressed segment to the map of segment (column) name to segment to later add to chunk in correct order
-      compressed_segments[column_index] =
-          std::make_shared<DictionarySegment<ColumnDataType>>(raw_chunk->get_segment(column_index));
-    });
+  auto chosen_encodings = std::vector<EncodingType>(_column_types.size(), encoding_type);
+
+  auto compress_segment = [&raw_chunk, &compressed_segments, &chosen_encodings, &segments_vec_mutex, encoding_type](
+                              const auto segment_type, const auto column_index) {
+    const auto& raw_segment = raw_chunk->get_segment(column_index);
+    auto segment_encoding = encoding_type;
+    if (segment_encoding == EncodingType::Automatic) {
+      segment_encoding = advise_encoding(segment_type, raw_segment).encoding_type;
+    }
+    auto compressed_segment = encode_segment(segment_encoding, segment_type, raw_segment);
+    auto guard = std::lock_guard<std::mutex>(segments_vec_mutex);
+    // add compressed segment to the map of segment (column) name to segment to later add to chunk in correct order
+    compressed_segments[column_index] = compressed_segment;
+    chosen_encodings[column_index] = segment_encoding;
   };
 
-  // create one worker per segment, they will start running the moment they are created
+  // compress the segments as tasks of the shared thread pool
+  auto& thread_pool = ThreadPool::get();
   for (auto column_index = ColumnID{0}; column_index < _column_types.size(); ++column_index) {
-    threads[column_index] = std::thread(compress_segment, _column_types[column_index], column_index);
+    workers[column_index] = thread_pool.submit(
+        [&compress_segment, this, column_index]() { compress_segment(_column_types[column_index], column_index); });
   }
 
-  // wait for all threads to finish execution
-  for (auto&& thread : threads) {
-    thread.join();
+  // wait for all workers to finish execution, get() rethrows failures of the encoding (e.g., unsupported encodings)
+  for (const auto& worker : workers) {
+    thread_pool.wait(worker);
+  }
+  for (auto& worker : workers) {
+    worker.get();
   }
 
   // add the compressed segments to the chunk in correct order
@@ -141,18 +1053,40 @@ void Table::compress_chunk(const ChunkID chunk_id) {
     compressed_chunk->add_segment(compressed_segments[column_index]);
   }
 
-  auto guard = std::lock_guard<std::mutex>(_chunk_access_mutex);
-  // replace existing chunk with the new, compressed one
-  _chunks[chunk_id] = compressed_chunk;
+  _create_zone_maps(*compressed_chunk);
+
+  auto guard = std::unique_lock<std::mutex>(_chunk_access_mutex);
+  // replace existing chunk with the new, compressed one, unless it was compacted in the meantime. The chunk is looked
+  // up by pointer, as its id shifts if chunks before it are coalesced.
+  auto chunks = std::make_shared<ChunkVector>(*_chunks.load());
+  const auto chunk_position = std::find(chunks->begin(), chunks->end(), raw_chunk);
+  if (chunk_position == chunks->end()) {
+    return nullptr;
+  }
+  const auto chunk_id = static_cast<ChunkID>(std::distance(chunks->begin(), chunk_position));
+  _copy_invalid_rows(*raw_chunk, *compressed_chunk, 0, raw_chunk->size(), 0);
+  (*chunks)[chunk_id] = compressed_chunk;
+  _chunks.store(std::move(chunks));
   /*
-   * We currently believe the following is the case:
-   * The chunk at chunk_id is guaranteed to be full and therefore already immutable.
-   * Anyone who still has an old pointer to the uncompressed chunk still gets the same information as someone with a pointer to the compressed chunk.
-   * We ensure noone is trying to get this chunk while we exchange the pointer through the _chunk_access_mutex.
-   *
-   * Therefore, simply setting the pointer new and letting the shared_pointer do the cleanup once nobody is looking at
-   * the old, uncompressed chunk anymore should be safe.
+   * The chunk at chunk_id is sealed and therefore already immutable. Anyone who still has an old pointer to the
+   * uncompressed chunk (or an older snapshot of the chunk list) still gets the same information as someone with a
+   * pointer to the compressed chunk. The shared_ptr cleans up the uncompressed chunk once nobody references it.
    */
+
+  // the log is written while holding the lock, as chunks may be compressed concurrently
+  if (_encoding_log) {
+    for (auto column_index = ColumnID{0}; column_index < _column_types.size(); ++column_index) {
+      *_encoding_log << "Chunk " << chunk_id << ", column " << _column_names[column_index] << " ("
+                     << _column_types[column_index] << "): " << chosen_encodings[column_index] << ", "
+                     << raw_chunk->get_segment(column_index)->estimate_memory_usage() << " -> "
+                     << compressed_segments[column_index]->estimate_memory_usage() << " bytes" << std::endl;
+    }
+  }
+  guard.unlock();
+
+  // The buffer manager only learns about the compressed chunk once it is part of the table.
+  BufferManager::get().register_chunk(compressed_chunk, _column_types);
+  return compressed_chunk;
 }
 
 }  // namespace opossum
@@ -1,10 +1,14 @@
 #pragma once
 
+#include <atomic>
 #include <limits>
 #include <map>
 #include <memory>
 #include <mutex>
+#include <optional>
+#include <ostream>
 #include <string>
+#include <unordered_set>
 #include <utility>
 #include <vector>
 
@@ -17,22 +21,36 @@
 
 namespace opossum {
 
+class ChunkCompressionWorker;
 class TableStatistics;
+class WriteAheadLog;
 
 // A table is partitioned horizontally into a number of chunks
 class Table : private Noncopyable {
+  friend class TableAppender;
+
  public:
+  using ChunkVector = std::vector<std::shared_ptr<Chunk>>;
+
   // Creates a table. The parameter specifies the maximum chunk size, i.e., partition size default is the maximum chunk
-  // size minus 1. A table holds always at least one chunk.
+  // size minus 1, which is also used for a size of 0. A table holds always at least one chunk.
   explicit Table(const ChunkOffset target_chunk_size = std::numeric_limits<ChunkOffset>::max() - 1);
 
+  // Stops the background compression, if enabled.
+  ~Table();
+
   // Returns the number of columns (cannot exceed ColumnID (uint16_t)).
   ColumnCount column_count() const;
 
   // Returns the number of rows. This number includes invalidated (deleted) rows. Use approx_valid_row_count() for an
-  // approximate count of valid rows instead.
+  // approximate count of valid rows instead. The count is maintained on append, so this does not take a lock. It is
+  // not synchronized with chunks(), i.e., a snapshot taken before or after may hold fewer or more rows.
   ChunkOffset row_count() const;
 
+  // Returns the number of rows that are not invalidated. The count is approximate, as rows may be deleted while the
+  // chunks are visited.
+  ChunkOffset approx_valid_row_count() const;
+
   // Returns the number of chunks (cannot exceed ChunkID (uint32_t)).
   ChunkID chunk_count() const;
 
@@ -40,6 +58,17 @@ class Table : private Noncopyable {
   std::shared_ptr<Chunk> get_chunk(const ChunkID chunk_id);
   std::shared_ptr<const Chunk> get_chunk(const ChunkID chunk_id) const;
 
+  // Returns a snapshot of all chunks without blocking. Chunks that are appended or replaced (e.g., by compress_chunk)
+  // afterwards are not reflected in the snapshot, which keeps referencing the previous chunks. Rows that are appended
+  // to the last chunk of the snapshot afterwards may still become visible in it, but only once they are completely
+  // written, so readers must bound their accesses by the chunk's size().
+  std::shared_ptr<const ChunkVector> chunks() const;
+
+  // Returns a number that changes whenever rows move to other positions, i.e., when compact(), coalesce_chunks() or
+  // merge_delta() replace chunks. Positions obtained from a snapshot of chunks() that was taken after reading the
+  // version stay valid as long as the version does not change.
+  uint64_t layout_version() const;
+
   // Returns a list of all column names.
   const std::vector<std::string>& column_names() const;
 
@@ -64,24 +93,233 @@ class Table : private Noncopyable {
   // entries, because we would otherwise have to deal with default values.
   void add_column(const std::string& name, const std::string& type);
 
-  // Inserts a row at the end of the table. Note this is slow and not thread-safe and should be used for testing
-  // purposes only.
+  // Inserts a row at the end of the table. Note this is slow and should be used for testing purposes only.
   void append(const std::vector<AllTypeVariant>& values);
 
+  // Appends a batch of rows, given as one ValueSegment per column, which must all have the same size. Values are copied
+  // column by column, and the batch is split into as many chunks as needed. In contrast to append(), the lock is only
+  // taken once per batch and values are not converted from AllTypeVariant.
+  void append_batch(const std::vector<std::shared_ptr<AbstractSegment>>& batch);
+
+  // Appends a chunk that was filled elsewhere, e.g., by a TableAppender. The chunk is sealed, i.e., it does not receive
+  // further rows. Its rows become visible at once. Zone maps that the chunk already has are kept. With
+  // defer_statistics, the statistics (and missing zone maps) of the chunk are only created by the first call of
+  // table_statistics(), so that appending the chunk does not read its values, e.g., when a table file is opened.
+  void append_chunk(const std::shared_ptr<Chunk>& chunk, const bool defer_statistics = false);
+
+  // Adds a chunk whose segments reference other tables, e.g., as the output of an operator. An empty last chunk is
+  // replaced. In contrast to append_chunk(), no zone maps, statistics or log records are created, as the referenced
+  // tables hold the data.
+  void emplace_chunk(const std::shared_ptr<Chunk>& chunk);
+
   // Creates a new chunk and appends it.
   void create_new_chunk();
 
-  // Compresses a ValueColumn into a DictionaryColumn.
-  void compress_chunk(const ChunkID chunk_id);
+  // Compresses the ValueSegments of a chunk with the given encoding, replacing the chunk. EncodingType::Automatic
+  // chooses the encoding with the smallest estimated memory usage per column. If the chunk is the last one, it is
+  // sealed first, i.e., further rows are appended to a new chunk.
+  void compress_chunk(const ChunkID chunk_id, const EncodingType encoding_type = EncodingType::Dictionary);
+
+  // Compresses chunks in the background as soon as they are full, i.e., once append() starts a new chunk. This keeps
+  // the latency of append() independent of the compression. Chunks that are already full are not compressed. The
+  // encoding must be supported by all columns (see is_encoding_supported()).
+  void enable_auto_compression(const EncodingType encoding_type = EncodingType::Automatic);
+
+  // Blocks until all full chunks handed to the background compression are compressed. If the compression of a chunk
+  // failed, e.g., because its values exceed the range of frame-of-reference encoding, the chunk is left as it is and
+  // the failure is rethrown here.
+  void wait_for_auto_compression();
+
+  // Folds the last chunk, which receives appended rows and thus serves as a write-optimized delta, into the
+  // dictionary-encoded chunks, which form the read-optimized main. If the chunk before the delta is dictionary-encoded
+  // and has room for the delta's rows, their sorted dictionaries are merged (see DictionarySegment::merge). Otherwise,
+  // the delta becomes a new dictionary-encoded chunk. Rows appended during the merge remain in the delta. The order of
+  // the rows is unchanged, but merged rows move to another chunk.
+  void merge_delta();
+
+  // Merges the delta in the background (see merge_delta()) whenever it holds at least the given number of rows.
+  void enable_background_merge(const ChunkOffset delta_row_threshold);
+
+  // Blocks until all background merges that were triggered so far are done. Rethrows the failure of a merge, if any.
+  void wait_for_background_merge();
+
+  // Deletes the rows at the given positions by invalidating them in the validity bitmaps of their chunks (see
+  // ValidityBitmap). The rows remain in the segments until the chunk is compacted. Returns the number of rows that were
+  // valid before. Deletes are not logged, so they cannot be combined with a write-ahead log. If the positions were
+  // obtained at a layout version (see layout_version() and ReferenceSegment), the delete fails if rows have moved
+  // since, as the positions would denote other rows.
+  size_t delete_rows(const PosList& positions, const std::optional<uint64_t> layout_version = std::nullopt);
+
+  // Rewrites the chunks in which at least the given share of rows is invalid without these rows, keeping the encoding
+  // of each segment. Chunks are compacted in parallel on the ThreadPool. The delta, i.e., the last chunk, is skipped as
+  // it still receives rows, as are chunks that wait for auto compression. Rows deleted during the compaction remain
+  // deleted. As the valid rows move to other positions, positions obtained before the compaction become stale. Returns
+  // the number of removed rows.
+  size_t compact(const float invalid_row_share);
+
+  // Merges runs of adjacent chunks that hold fewer than min_chunk_size rows each into chunks of up to
+  // target_chunk_size() rows, e.g., after operators emitted many small chunks. A run is merged if all of its chunks are
+  // dictionary-encoded, whose dictionaries are merged without decoding the rows (see DictionarySegment::merge), or
+  // unencoded. Other chunks, the delta, and chunks that wait for auto compression are left as they are. Runs are merged
+  // in parallel on the ThreadPool, and deleted rows stay deleted. As the ids of later chunks shift down, positions
+  // obtained before become stale. Returns the number of removed chunks.
+  ChunkID coalesce_chunks(const ChunkOffset min_chunk_size);
+
+  // Returns a target chunk size for which a segment of the widest column, given in bytes per value, fits into the
+  // given cache size, and for which the given number of rows is split into enough chunks to balance parallel scans
+  // across the given number of cores.
+  static ChunkOffset recommend_target_chunk_size(const size_t row_count, const size_t bytes_per_value,
+                                                 const size_t cache_size, const size_t core_count);
+
+  // Sets the target chunk size from the L2 cache size of the machine, the workers of the ThreadPool, the rows of the
+  // table, and the memory usage of its columns (see recommend_target_chunk_size()). The size applies to new chunks,
+  // while existing ones keep their size unless they are coalesced. Returns the new target chunk size.
+  ChunkOffset tune_target_chunk_size();
+
+  // Returns the statistics of the table, which cover all sealed or compressed chunks. Chunks whose statistics were
+  // deferred (see append_chunk()) are summarized first. Deleted rows remain counted (see TableStatistics).
+  std::shared_ptr<const TableStatistics> table_statistics() const;
+
+  // Compresses all chunks that are not compressed yet. Chunks and their columns are compressed in parallel on the
+  // ThreadPool. The last chunk is sealed first, so that rows appended in the meantime go to a new chunk.
+  void compress_all_chunks(const EncodingType encoding_type = EncodingType::Dictionary);
+
+  // Logs all following changes to a write-ahead log at the given file, which is created if it does not exist. Then,
+  // add_column() and the append methods return once their changes are durable. Rows that the table already contains
+  // are only durable once a checkpoint is written.
+  //
+  // A change is applied to the table before it becomes durable, so if writing the log fails, the append method throws
+  // although its rows are already visible and counted. They must not be appended again. The failure is permanent (see
+  // WriteAheadLog): all later changes that are logged throw as well, so the table should be recovered from its
+  // checkpoint and log.
+  void enable_write_ahead_log(const std::string& file_name);
+
+  // Writes the table to the given file in the binary table format and truncates the write-ahead log, whose records are
+  // covered by the checkpoint. The log is only truncated once the checkpoint is durable. Rows are not appended while
+  // the checkpoint is written.
+  void checkpoint(const std::string& file_name);
+
+  // Restores a table from its last checkpoint, if one exists, and replays its write-ahead log. The restored table
+  // continues to log to the same file.
+  static std::shared_ptr<Table> recover(const std::string& checkpoint_file_name, const std::string& log_file_name);
+
+  // Sets a stream to which compress_chunk writes the chosen encoding and the memory usage before and after the
+  // compression for each segment. Pass nullptr to disable logging.
+  void set_encoding_log(std::ostream* encoding_log);
 
  protected:
-  std::vector<std::shared_ptr<Chunk>> _chunks{};
-  ChunkOffset _target_chunk_size{};
+  // Chunks that were sealed while holding _chunk_access_mutex and whose zone maps and statistics are created after
+  // releasing it.
+  using SealedChunks = std::vector<std::shared_ptr<Chunk>>;
+
+  // The chunk list is copied on write: writers create a modified copy while holding _chunk_access_mutex and publish it
+  // atomically, so readers never take the mutex. Rows are appended to the last chunk in place as long as its segments
+  // have the capacity, and published through ValueSegment::size() once all columns are written. Otherwise, the last
+  // chunk is replaced by a copy with more capacity (see _reserve_delta_unsafe()).
+  std::atomic<std::shared_ptr<const ChunkVector>> _chunks{std::make_shared<const ChunkVector>()};
+  std::atomic<ChunkOffset> _row_count{0};
+  // incremented after the chunk list is published, so that readers who read it before the chunk list never see a
+  // version that is newer than their snapshot
+  std::atomic<uint64_t> _layout_version{0};
+  // may be changed by tune_target_chunk_size() while rows are appended
+  std::atomic<ChunkOffset> _target_chunk_size{};
   std::vector<std::string> _column_names{};
   std::vector<std::string> _column_types{};
+  // serializes writers of the chunk list
   mutable std::mutex _chunk_access_mutex{};
+  std::ostream* _encoding_log{nullptr};
+  std::shared_ptr<TableStatistics> _table_statistics;
+  // Chunks whose statistics are created by the next call of table_statistics(). Guarded by _chunk_access_mutex, while
+  // _summary_mutex serializes their summarization.
+  mutable SealedChunks _unsummarized_chunks{};
+  mutable std::mutex _summary_mutex{};
+  EncodingType _auto_compression_encoding_type{};
+  // Chunks that auto compression has not finished yet, whether it succeeds or fails. Their pointers are unique, as the
+  // queue keeps them alive.
+  std::unordered_set<const Chunk*> _pending_compressions{};
+  mutable std::mutex _pending_compression_mutex{};
+  std::unique_ptr<WriteAheadLog> _write_ahead_log{};
+  ChunkOffset _merge_threshold{};
+  std::atomic<bool> _is_merge_pending{false};
+  // serializes merges of the delta
+  std::mutex _merge_mutex{};
+  // declared last, so that the workers are stopped before any other member is destroyed
+  std::unique_ptr<ChunkCompressionWorker> _merge_worker{};
+  std::unique_ptr<ChunkCompressionWorker> _compression_worker{};
+
+  void _create_new_chunk_unsafe(SealedChunks& sealed_chunks);
+
+  // Returns an empty chunk with a ValueSegment per column.
+  std::shared_ptr<Chunk> _create_chunk() const;
+
+  // Hands a chunk that will not receive more rows to auto compression or, without it, adds it to sealed_chunks.
+  void _seal_chunk_unsafe(const std::shared_ptr<Chunk>& chunk, SealedChunks& sealed_chunks);
+
+  // Creates the zone maps and statistics of sealed chunks. Expects _chunk_access_mutex not to be held.
+  void _summarize_sealed_chunks(const SealedChunks& sealed_chunks) const;
+
+  // Checks that a batch matches the columns of the table and returns its number of rows.
+  size_t _validate_batch(const std::vector<std::shared_ptr<AbstractSegment>>& batch) const;
+
+  // Appends the rows of a batch to the last chunk, creating new chunks as it fills up. Expects _chunk_access_mutex to
+  // be held.
+  void _append_rows_unsafe(const std::vector<std::shared_ptr<AbstractSegment>>& batch, const size_t batch_size,
+                           SealedChunks& sealed_chunks);
+
+  // Returns the last chunk after making sure that the rows from begin_offset to end_offset (exclusive) of a batch fit
+  // into its capacity, replacing it by a larger copy otherwise. Expects _chunk_access_mutex to be held.
+  std::shared_ptr<Chunk> _reserve_delta_unsafe(const std::vector<std::shared_ptr<AbstractSegment>>& batch,
+                                               const size_t begin_offset, const size_t end_offset);
+
+  // Appends the rows from begin_offset to end_offset (exclusive) of a batch to a chunk of this table.
+  void _append_batch_range(Chunk& chunk, const std::vector<std::shared_ptr<AbstractSegment>>& batch,
+                           const size_t begin_offset, const size_t end_offset) const;
+
+  // Compresses a full chunk in the background unless it was already replaced, e.g., by compress_chunk, and adds it to
+  // the statistics. If the compression fails, the chunk stays unencoded and is summarized nonetheless.
+  void _compress_sealed_chunk(const std::shared_ptr<Chunk>& chunk);
+
+  // Encodes a chunk and replaces it, wherever it is in the chunk list, by the result. Returns the compressed chunk, or
+  // nullptr if the chunk was replaced in the meantime.
+  std::shared_ptr<Chunk> _compress(const std::shared_ptr<Chunk>& raw_chunk, const EncodingType encoding_type);
+
+  // Hands a sealed chunk to auto compression.
+  void _enqueue_compression(const std::shared_ptr<Chunk>& chunk);
+
+  // Returns whether a chunk is still to be compressed by auto compression, which replaces it.
+  bool _awaits_compression(const Chunk& chunk) const;
+
+  // Returns whether a chunk still consists of ValueSegments.
+  bool _is_unencoded(const Chunk& chunk) const;
+
+  // Returns whether all segments of a chunk are DictionarySegments.
+  bool _is_dictionary_encoded(const Chunk& chunk) const;
+
+  // Hands the delta to the background merge if it reached the threshold. Expects _chunk_access_mutex to be held.
+  void _trigger_background_merge_unsafe();
+
+  // Rewrites a chunk without its invalid rows and returns the number of removed rows. The compaction is dropped if
+  // the chunk was replaced in the meantime.
+  size_t _compact_chunk(const std::shared_ptr<Chunk>& chunk);
+
+  // Returns whether two chunks can be coalesced, i.e., each of their columns is either unencoded or
+  // dictionary-encoded in both.
+  bool _can_coalesce(const Chunk& chunk, const Chunk& next_chunk) const;
+
+  // Merges the given chunks, which can be coalesced, into one.
+  std::shared_ptr<Chunk> _coalesce(const ChunkVector& chunks) const;
+
+  // Returns the largest memory usage per value among the columns, estimated from the resident chunks or, if the table
+  // has no rows, from the column types.
+  size_t _max_bytes_per_value() const;
+
+  // Invalidates the rows of the target chunk, starting at target_begin, whose counterparts from source_begin to
+  // source_end (exclusive) are invalid in the source chunk. Used to carry deletes over when a chunk is rewritten.
+  static void _copy_invalid_rows(const Chunk& source, Chunk& target, const ChunkOffset source_begin,
+                                 const ChunkOffset source_end, const ChunkOffset target_begin);
 
-  void _create_new_chunk_unsafe();
+  // Creates the zone maps of all segments of a sealed or compressed chunk.
+  void _create_zone_maps(Chunk& chunk) const;
 };
 
 }  // namespace opossum
@@ -0,0 +1,60 @@
+#include "table_appender.hpp"
+
+#include <algorithm>
+#include <memory>
+#include <vector>
+
+#include "chunk.hpp"
+#include "table.hpp"
+
+namespace opossum {
+
+TableAppender::TableAppender(const std::shared_ptr<Table>& table) : _table{table}, _chunk{table->_create_chunk()} {}
+
+TableAppender::~TableAppender() {
+  // Throwing during stack unwinding, e.g., after a failed append, would terminate the process.
+  try {
+    flush();
+  } catch (...) {
+  }
+}
+
+void TableAppender::append(const std::vector<AllTypeVariant>& values) {
+  _chunk->append(values);
+  _publish_if_full();
+}
+
+void TableAppender::append_batch(const std::vector<std::shared_ptr<AbstractSegment>>& batch) {
+  const auto batch_size = _table->_validate_batch(batch);
+
+  auto batch_offset = size_t{0};
+  while (batch_offset < batch_size) {
+    // tune_target_chunk_size() may change the target meanwhile, so a chunk that reached a lowered target is published
+    // before rows are added to it.
+    const auto target_chunk_size = size_t{_table->target_chunk_size()};
+    if (_chunk->size() >= target_chunk_size) {
+      flush();
+      continue;
+    }
+    const auto row_count = std::min(target_chunk_size - _chunk->size(), batch_size - batch_offset);
+    _table->_append_batch_range(*_chunk, batch, batch_offset, batch_offset + row_count);
+    batch_offset += row_count;
+  }
+  _publish_if_full();
+}
+
+void TableAppender::flush() {
+  if (_chunk->size() == 0) {
+    return;
+  }
+  _table->append_chunk(_chunk);
+  _chunk = _table->_create_chunk();
+}
+
+void TableAppender::_publish_if_full() {
+  if (_chunk->size() >= _table->target_chunk_size()) {
+    flush();
+  }
+}
+
+}  // namespace opossum
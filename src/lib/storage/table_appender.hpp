@@ -0,0 +1,46 @@
+#pragma once
+
+#include <memory>
+#include <vector>
+
+#include "all_type_variant.hpp"
+#include "types.hpp"
+
+namespace opossum {
+
+class AbstractSegment;
+class Chunk;
+class Table;
+
+// A TableAppender lets one of several concurrent writers append rows to a table. Each appender fills a chunk of its
+// own without any synchronization and publishes it with Table::append_chunk once it reaches the target chunk size.
+// Thus, writers only synchronize once per chunk, and readers only see chunks whose rows are completely written.
+//
+// An appender must only be used by a single thread. Rows that do not fill a complete chunk are published by flush()
+// or when the appender is destroyed. As a destructor must not throw, failures to publish them there (e.g., a chunk
+// that does not match the table) are ignored. Call flush() before to handle them.
+class TableAppender : private Noncopyable {
+ public:
+  explicit TableAppender(const std::shared_ptr<Table>& table);
+
+  // Publishes the remaining rows, ignoring failures.
+  ~TableAppender();
+
+  // Appends a row.
+  void append(const std::vector<AllTypeVariant>& values);
+
+  // Appends a batch of rows, given as one ValueSegment per column (see Table::append_batch).
+  void append_batch(const std::vector<std::shared_ptr<AbstractSegment>>& batch);
+
+  // Publishes the rows appended so far, even if they do not fill a complete chunk.
+  void flush();
+
+ protected:
+  // Publishes the current chunk if it is full.
+  void _publish_if_full();
+
+  const std::shared_ptr<Table> _table;
+  std::shared_ptr<Chunk> _chunk;
+};
+
+}  // namespace opossum
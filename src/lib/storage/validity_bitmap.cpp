@@ -0,0 +1,61 @@
+#include "validity_bitmap.hpp"
+
+#include <algorithm>
+#include <limits>
+
+#include "utils/assert.hpp"
+
+namespace opossum {
+
+ValidityBitmap::ValidityBitmap(const ChunkOffset size) : _size{size}, _words((size + WORD_BITS - 1) / WORD_BITS) {}
+
+ValidityBitmap::ValidityBitmap(const ValidityBitmap& other, const ChunkOffset size) : ValidityBitmap{size} {
+  Assert(size >= other._size, "A validity bitmap cannot shrink.");
+  for (auto word_index = size_t{0}; word_index < other._words.size(); ++word_index) {
+    _words[word_index].store(other._words[word_index].load());
+  }
+  _invalid_count.store(other._invalid_count.load());
+}
+
+ChunkOffset ValidityBitmap::size() const { return _size; }
+
+bool ValidityBitmap::is_valid(const ChunkOffset chunk_offset) const {
+  if (chunk_offset >= _size) {
+    return true;
+  }
+  const auto bit = uint64_t{1} << (chunk_offset % WORD_BITS);
+  return (_words[chunk_offset / WORD_BITS].load(std::memory_order_relaxed) & bit) == 0;
+}
+
+bool ValidityBitmap::invalidate(const ChunkOffset chunk_offset) {
+  Assert(chunk_offset < _size, "The row is not covered by the validity bitmap.");
+  const auto bit = uint64_t{1} << (chunk_offset % WORD_BITS);
+  const auto previous_word = _words[chunk_offset / WORD_BITS].fetch_or(bit, std::memory_order_relaxed);
+  if (previous_word & bit) {
+    return false;
+  }
+  ++_invalid_count;
+  return true;
+}
+
+ChunkOffset ValidityBitmap::invalid_count() const { return _invalid_count; }
+
+void ValidityBitmap::remove_invalid(PosList& matches, const size_t begin_index) const {
+  // The word of the previous match is kept, so that sorted positions load each word only once, and matches in words
+  // without invalid rows are kept without testing their bit.
+  auto word_index = std::numeric_limits<size_t>::max();
+  auto invalid_bits = uint64_t{0};
+  const auto end = std::remove_if(matches.begin() + begin_index, matches.end(), [&](const RowID& row_id) {
+    if (row_id.chunk_offset >= _size) {
+      return false;
+    }
+    if (row_id.chunk_offset / WORD_BITS != word_index) {
+      word_index = row_id.chunk_offset / WORD_BITS;
+      invalid_bits = _words[word_index].load(std::memory_order_relaxed);
+    }
+    return invalid_bits != 0 && (invalid_bits >> (row_id.chunk_offset % WORD_BITS) & 1) != 0;
+  });
+  matches.erase(end, matches.end());
+}
+
+}  // namespace opossum
@@ -0,0 +1,85 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <bit>
+#include <cstdint>
+#include <vector>
+
+#include "types.hpp"
+
+namespace opossum {
+
+// ValidityBitmap marks rows of a chunk as invalid, e.g., because they were deleted. It holds one bit per row, which
+// is set for invalid rows. Rows beyond its size are valid, so that rows can be appended to a chunk without growing the
+// bitmap.
+//
+// Rows are invalidated atomically, so a concurrent reader sees each row either as valid or as invalid. Readers skip
+// invalid rows a word, i.e., 64 rows, at a time: words without invalid rows are processed without testing single bits
+// and words of invalid rows are skipped entirely.
+class ValidityBitmap : private Noncopyable {
+ public:
+  static constexpr auto WORD_BITS = ChunkOffset{64};
+
+  explicit ValidityBitmap(const ChunkOffset size);
+
+  // Creates a copy of the given bitmap, extended to the given size.
+  ValidityBitmap(const ValidityBitmap& other, const ChunkOffset size);
+
+  // Returns the number of rows covered by the bitmap.
+  ChunkOffset size() const;
+
+  bool is_valid(const ChunkOffset chunk_offset) const;
+
+  // Marks a row as invalid. Returns false if it was already invalid.
+  bool invalidate(const ChunkOffset chunk_offset);
+
+  // Returns the number of invalid rows.
+  ChunkOffset invalid_count() const;
+
+  // Calls the functor with each valid position in [begin_offset, end_offset).
+  template <typename Functor>
+  void for_each_valid(const ChunkOffset begin_offset, const ChunkOffset end_offset, const Functor& functor) const {
+    const auto covered_end = std::min(end_offset, std::max(begin_offset, _size));
+    auto chunk_offset = begin_offset;
+    while (chunk_offset < covered_end) {
+      const auto word_index = chunk_offset / WORD_BITS;
+      const auto word_end = std::min(static_cast<ChunkOffset>((word_index + 1) * WORD_BITS), covered_end);
+      const auto invalid_bits = _words[word_index].load(std::memory_order_relaxed);
+      if (invalid_bits == 0) {
+        for (; chunk_offset < word_end; ++chunk_offset) {
+          functor(chunk_offset);
+        }
+        continue;
+      }
+
+      // Visit the valid rows of the word by their set bits in the inverted word.
+      auto valid_bits = ~invalid_bits >> (chunk_offset % WORD_BITS);
+      const auto word_begin = chunk_offset;
+      while (valid_bits != 0) {
+        const auto valid_offset = static_cast<ChunkOffset>(word_begin + std::countr_zero(valid_bits));
+        if (valid_offset >= word_end) {
+          break;
+        }
+        functor(valid_offset);
+        valid_bits &= valid_bits - 1;
+      }
+      chunk_offset = word_end;
+    }
+
+    for (chunk_offset = covered_end; chunk_offset < end_offset; ++chunk_offset) {
+      functor(chunk_offset);
+    }
+  }
+
+  // Removes the positions of invalid rows from matches, starting at the given index. The positions must refer to the
+  // chunk of this bitmap and be sorted, as produced by a scan of the chunk.
+  void remove_invalid(PosList& matches, const size_t begin_index = 0) const;
+
+ protected:
+  const ChunkOffset _size;
+  std::vector<std::atomic<uint64_t>> _words;
+  std::atomic<ChunkOffset> _invalid_count{0};
+};
+
+}  // namespace opossum
@@ -4,6 +4,7 @@
 #include <memory>
 #include <sstream>
 #include <string>
+#include <type_traits>
 #include <utility>
 #include <vector>
 
@@ -12,29 +13,96 @@
 
 namespace opossum {
 
+template <typename T>
+ValueSegment<T>::ValueSegment(ValueVector<T> values)
+    : _stored_values{std::move(values)}, _size{static_cast<ChunkOffset>(_stored_values.size())} {}
+
 template <typename T>
 AllTypeVariant ValueSegment<T>::operator[](const ChunkOffset chunk_offset) const {
-  return _stored_values[chunk_offset];
+  return T{_stored_values[chunk_offset]};
+}
+
+template <typename T>
+T ValueSegment<T>::get(const ChunkOffset chunk_offset) const {
+  Assert(chunk_offset < size(), "Index is out of bounds.");
+  return T{_stored_values[chunk_offset]};
 }
 
 template <typename T>
 void ValueSegment<T>::append(const AllTypeVariant& val) {
   _stored_values.push_back(type_cast<T>(val));
+  publish();
+}
+
+template <typename T>
+void ValueSegment<T>::append_values(const ValueSegment<T>& source, const ChunkOffset begin_offset,
+                                    const ChunkOffset end_offset, const bool publish) {
+  const auto& source_values = source.values();
+  DebugAssert(begin_offset <= end_offset && end_offset <= source.size(), "Invalid range of values.");
+
+  if constexpr (std::is_same_v<T, std::string>) {
+    _stored_values.append(source_values, begin_offset, end_offset);
+  } else {
+    _stored_values.insert(_stored_values.end(), source_values.cbegin() + begin_offset,
+                          source_values.cbegin() + end_offset);
+  }
+
+  if (publish) {
+    this->publish();
+  }
+}
+
+template <typename T>
+void ValueSegment<T>::publish() {
+  _size.store(static_cast<ChunkOffset>(_stored_values.size()), std::memory_order_release);
+}
+
+template <typename T>
+bool ValueSegment<T>::has_capacity_for(const ValueSegment<T>& source, const ChunkOffset begin_offset,
+                                       const ChunkOffset end_offset) const {
+  if constexpr (std::is_same_v<T, std::string>) {
+    const auto& characters = _stored_values.characters();
+    const auto& offsets = _stored_values.offsets();
+    const auto& source_offsets = source.values().offsets();
+    return !characters.is_mapped() && !offsets.is_mapped() &&
+           offsets.capacity() - offsets.size() >= end_offset - begin_offset &&
+           characters.capacity() - characters.size() >= source_offsets[end_offset] - source_offsets[begin_offset];
+  } else {
+    return _stored_values.capacity() - _stored_values.size() >= end_offset - begin_offset;
+  }
+}
+
+template <typename T>
+std::shared_ptr<ValueSegment<T>> ValueSegment<T>::copy_with_capacity(const size_t value_capacity,
+                                                                     const ValueSegment<T>& source,
+                                                                     const ChunkOffset begin_offset,
+                                                                     const ChunkOffset end_offset) const {
+  auto copy = std::make_shared<ValueSegment<T>>();
+  if constexpr (std::is_same_v<T, std::string>) {
+    const auto& source_offsets = source.values().offsets();
+    const auto character_count =
+        _stored_values.characters().size() + (source_offsets[end_offset] - source_offsets[begin_offset]);
+    copy->_stored_values.reserve(value_capacity, 2 * character_count);
+  } else {
+    copy->_stored_values.reserve(value_capacity);
+  }
+  copy->append_values(*this, ChunkOffset{0}, size());
+  return copy;
 }
 
 template <typename T>
 ChunkOffset ValueSegment<T>::size() const {
-  return _stored_values.size();
+  return _size.load(std::memory_order_acquire);
 }
 
 template <typename T>
-const std::vector<T>& ValueSegment<T>::values() const {
+const ValueVector<T>& ValueSegment<T>::values() const {
   return _stored_values;
 }
 
 template <typename T>
 size_t ValueSegment<T>::estimate_memory_usage() const {
-  return _stored_values.capacity() * sizeof(T);
+  return estimate_value_vector_memory_usage<T>(_stored_values);
 }
 
 // Macro to instantiate the following classes:
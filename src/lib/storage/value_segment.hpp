@@ -1,37 +1,73 @@
 #pragma once
 
+#include <atomic>
 #include <memory>
 #include <string>
 #include <utility>
 #include <vector>
 
 #include "abstract_segment.hpp"
+#include "string_heap.hpp"
 
 namespace opossum {
 
-// ValueSegment is a segment type that stores all its values in a vector.
+// ValueSegment is a segment type that stores all its values in a vector. Strings are stored in a StringHeap.
 template <typename T>
 class ValueSegment : public AbstractSegment {
  public:
+  // Creates an empty segment.
+  ValueSegment() = default;
+
+  // Creates a segment that takes over the given values, e.g., to hand over a column of a batch to Table::append_batch.
+  explicit ValueSegment(ValueVector<T> values);
+
   // Return the value at a certain position. If you want to write efficient operators, back off!
   AllTypeVariant operator[](const ChunkOffset chunk_offset) const final;
 
+  // Return the value at a certain position.
+  T get(const ChunkOffset chunk_offset) const;
+
   // Add a value to the end.
   void append(const AllTypeVariant& val) final;
 
-  // Return the number of entries.
+  // Appends the values from begin_offset to end_offset (exclusive) of another segment. For all types but strings,
+  // this is a single memcpy. With publish set to false, the values are not included in size() until publish() is
+  // called, so that a row can be written to all segments of a chunk before it becomes visible in any of them.
+  void append_values(const ValueSegment<T>& source, const ChunkOffset begin_offset, const ChunkOffset end_offset,
+                     const bool publish = true);
+
+  // Includes all appended values in size().
+  void publish();
+
+  // Returns whether the values from begin_offset to end_offset (exclusive) of another segment can be appended without
+  // reallocating, i.e., without moving the values that concurrent readers may access.
+  bool has_capacity_for(const ValueSegment<T>& source, const ChunkOffset begin_offset,
+                        const ChunkOffset end_offset) const;
+
+  // Returns a copy of the segment with room for value_capacity values. For strings, room for twice the characters of
+  // the copied values and the values from begin_offset to end_offset of another segment is reserved.
+  std::shared_ptr<ValueSegment<T>> copy_with_capacity(const size_t value_capacity, const ValueSegment<T>& source,
+                                                      const ChunkOffset begin_offset,
+                                                      const ChunkOffset end_offset) const;
+
+  // Return the number of entries. Values that are appended within the capacity while the segment is read become
+  // visible only after they are completely written, so readers must not access values at or beyond this size.
   ChunkOffset size() const final;
 
   // Return all values. This is the preferred method to check a value at a certain index. Usually you need to
   // access more than a single value anyway.
   // e.g. const auto& values = value_segment.values(); and then: values[i]; in your loop.
-  const std::vector<T>& values() const;
+  // For a segment that is appended to concurrently, only the first size() values may be accessed.
+  const ValueVector<T>& values() const;
 
   // Returns the calculated memory usage.
   size_t estimate_memory_usage() const final;
 
  protected:
-  std::vector<T> _stored_values{};
+  ValueVector<T> _stored_values{};
+
+  // The number of published values, which is written after the values themselves, see append_values().
+  std::atomic<ChunkOffset> _size{0};
 };
 
 }  // namespace opossum
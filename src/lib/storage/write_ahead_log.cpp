@@ -0,0 +1,336 @@
+#include "write_ahead_log.hpp"
+
+#include <fcntl.h>
+#include <unistd.h>
+
+#include <array>
+#include <cstring>
+#include <filesystem>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "resolve_type.hpp"
+#include "storage/table.hpp"
+#include "storage/value_segment.hpp"
+#include "type_cast.hpp"
+#include "utils/assert.hpp"
+#include "utils/mapped_file.hpp"
+
+namespace opossum {
+
+namespace {
+
+constexpr auto LOG_MAGIC = std::array<char, 8>{'O', 'P', 'O', 'S', 'S', 'U', 'M', 'W'};
+constexpr auto LOG_VERSION = uint32_t{1};
+constexpr auto LOG_HEADER_SIZE = sizeof(LOG_MAGIC) + sizeof(LOG_VERSION) + sizeof(ChunkOffset);
+constexpr auto RECORD_HEADER_SIZE = sizeof(uint8_t) + 2 * sizeof(uint32_t);
+
+constexpr auto COLUMN_RECORD = uint8_t{1};
+constexpr auto ROWS_RECORD = uint8_t{2};
+
+// FNV-1a, which detects records that were only partially written.
+uint32_t checksum(const std::string_view data) {
+  auto hash = uint32_t{2166136261u};
+  for (const auto character : data) {
+    hash = (hash ^ static_cast<uint8_t>(character)) * 16777619u;
+  }
+  return hash;
+}
+
+class LogWriter {
+ public:
+  template <typename T>
+  void write_value(const T& value) {
+    if constexpr (std::is_same_v<T, std::string> || std::is_same_v<T, std::string_view>) {
+      write_value(static_cast<uint32_t>(value.size()));
+      data.append(value.data(), value.size());
+    } else {
+      static_assert(std::is_trivially_copyable_v<T>, "Only trivially copyable values can be written.");
+      data.append(reinterpret_cast<const char*>(&value), sizeof(T));
+    }
+  }
+
+  std::string data{};
+};
+
+class LogReader {
+ public:
+  explicit LogReader(const std::string_view init_data) : data{init_data} {}
+
+  template <typename T>
+  T read_value() {
+    if constexpr (std::is_same_v<T, std::string>) {
+      const auto size = read_value<uint32_t>();
+      return std::string{_read_bytes(size), size};
+    } else {
+      auto value = T{};
+      std::memcpy(&value, _read_bytes(sizeof(T)), sizeof(T));
+      return value;
+    }
+  }
+
+  bool has_bytes(const size_t size) const { return size <= data.size() - offset; }
+
+  std::string_view data;
+  size_t offset{0};
+
+ protected:
+  const char* _read_bytes(const size_t size) {
+    Assert(has_bytes(size), "The write-ahead log contains a malformed record.");
+    const auto* bytes = data.data() + offset;
+    offset += size;
+    return bytes;
+  }
+};
+
+// Calls the callback with the type and payload of each valid record and returns the size of the valid log.
+template <typename Callback>
+size_t for_each_record(const std::string_view log, const Callback& callback) {
+  using LogMagic = std::remove_const_t<decltype(LOG_MAGIC)>;
+  auto reader = LogReader{log};
+  if (!reader.has_bytes(LOG_HEADER_SIZE) || reader.read_value<LogMagic>() != LOG_MAGIC) {
+    return 0;
+  }
+  Assert(reader.read_value<uint32_t>() == LOG_VERSION, "The write-ahead log has an unsupported format version.");
+  reader.read_value<ChunkOffset>();
+
+  while (reader.has_bytes(RECORD_HEADER_SIZE)) {
+    const auto record_begin = reader.offset;
+    const auto record_type = reader.read_value<uint8_t>();
+    const auto payload_size = reader.read_value<uint32_t>();
+    const auto payload_checksum = reader.read_value<uint32_t>();
+    if (!reader.has_bytes(payload_size)) {
+      return record_begin;
+    }
+    const auto payload = log.substr(reader.offset, payload_size);
+    if (checksum(payload) != payload_checksum) {
+      return record_begin;
+    }
+    callback(record_type, payload);
+    reader.offset += payload_size;
+  }
+  return reader.offset;
+}
+
+void write_all(const int file_descriptor, const std::string_view data) {
+  auto remaining = data;
+  while (!remaining.empty()) {
+    const auto written = write(file_descriptor, remaining.data(), remaining.size());
+    Assert(written > 0, "Could not write to the write-ahead log.");
+    remaining.remove_prefix(static_cast<size_t>(written));
+  }
+}
+
+template <typename T>
+void replay_column(LogReader& reader, const ChunkOffset row_count, std::shared_ptr<AbstractSegment>& segment) {
+  auto values = ValueVector<T>{};
+  for (auto row_id = ChunkOffset{0}; row_id < row_count; ++row_id) {
+    values.push_back(reader.read_value<T>());
+  }
+  segment = std::make_shared<ValueSegment<T>>(std::move(values));
+}
+
+void replay_rows(LogReader& reader, Table& table) {
+  const auto first_row_id = reader.read_value<uint64_t>();
+  const auto row_count = reader.read_value<ChunkOffset>();
+  Assert(first_row_id <= table.row_count(), "The write-ahead log misses rows that precede its records.");
+  if (first_row_id + row_count <= table.row_count()) {
+    return;
+  }
+
+  auto batch = std::vector<std::shared_ptr<AbstractSegment>>(table.column_count());
+  for (auto column_id = ColumnID{0}; column_id < table.column_count(); ++column_id) {
+    resolve_data_type(table.column_type(column_id), [&](const auto data_type_t) {
+      using ColumnDataType = typename decltype(data_type_t)::type;
+      replay_column<ColumnDataType>(reader, row_count, batch[column_id]);
+    });
+  }
+
+  // Rows that were part of the checkpoint are skipped.
+  const auto skipped_row_count = static_cast<ChunkOffset>(table.row_count() - first_row_id);
+  if (skipped_row_count > 0) {
+    for (auto column_id = ColumnID{0}; column_id < table.column_count(); ++column_id) {
+      resolve_data_type(table.column_type(column_id), [&](const auto data_type_t) {
+        using ColumnDataType = typename decltype(data_type_t)::type;
+        const auto& rows = static_cast<const ValueSegment<ColumnDataType>&>(*batch[column_id]);
+        auto remaining_rows = std::make_shared<ValueSegment<ColumnDataType>>();
+        remaining_rows->append_values(rows, skipped_row_count, row_count);
+        batch[column_id] = remaining_rows;
+      });
+    }
+  }
+  table.append_batch(batch);
+}
+
+}  // namespace
+
+WriteAheadLog::WriteAheadLog(const std::string& file_name, const ChunkOffset target_chunk_size)
+    : _file_name{file_name} {
+  auto valid_size = size_t{0};
+  if (std::filesystem::exists(file_name) && std::filesystem::file_size(file_name) > 0) {
+    const auto file = MappedFile{file_name};
+    valid_size = for_each_record(file.contents(), [](const auto, const auto) {});
+  }
+
+  _file_descriptor = open(file_name.c_str(), O_WRONLY | O_CREAT, 0644);
+  Assert(_file_descriptor >= 0, "Could not open the write-ahead log " + file_name);
+  Assert(ftruncate(_file_descriptor, static_cast<off_t>(valid_size)) == 0, "Could not truncate " + file_name);
+  lseek(_file_descriptor, 0, SEEK_END);
+
+  if (valid_size == 0) {
+    auto header = LogWriter{};
+    header.write_value(LOG_MAGIC);
+    header.write_value(LOG_VERSION);
+    header.write_value(target_chunk_size);
+    write_all(_file_descriptor, header.data);
+  }
+  Assert(fdatasync(_file_descriptor) == 0, "Could not sync the write-ahead log " + file_name);
+}
+
+WriteAheadLog::~WriteAheadLog() {
+  // Records that no writer waited for are lost, as they were never reported as durable.
+  close(_file_descriptor);
+}
+
+uint64_t WriteAheadLog::log_column(const ColumnID column_id, const std::string& name, const std::string& type) {
+  auto payload = LogWriter{};
+  payload.write_value(static_cast<uint16_t>(column_id));
+  payload.write_value(name);
+  payload.write_value(type);
+  return _add_record(COLUMN_RECORD, payload.data);
+}
+
+uint64_t WriteAheadLog::log_row(const uint64_t row_id, const std::vector<std::string>& column_types,
+                                const std::vector<AllTypeVariant>& values) {
+  auto payload = LogWriter{};
+  payload.write_value(row_id);
+  payload.write_value(ChunkOffset{1});
+  for (auto column_id = ColumnID{0}; column_id < column_types.size(); ++column_id) {
+    resolve_data_type(column_types[column_id], [&](const auto data_type_t) {
+      using ColumnDataType = typename decltype(data_type_t)::type;
+      payload.write_value(type_cast<ColumnDataType>(values[column_id]));
+    });
+  }
+  return _add_record(ROWS_RECORD, payload.data);
+}
+
+uint64_t WriteAheadLog::log_rows(const uint64_t first_row_id, const std::vector<std::string>& column_types,
+                                 const std::vector<std::shared_ptr<AbstractSegment>>& segments,
+                                 const ChunkOffset begin_offset, const ChunkOffset end_offset) {
+  auto payload = LogWriter{};
+  payload.write_value(first_row_id);
+  payload.write_value(static_cast<ChunkOffset>(end_offset - begin_offset));
+  for (auto column_id = ColumnID{0}; column_id < column_types.size(); ++column_id) {
+    resolve_data_type(column_types[column_id], [&](const auto data_type_t) {
+      using ColumnDataType = typename decltype(data_type_t)::type;
+      // Batches consist of value segments, whose values are written without converting them to AllTypeVariant.
+      if (const auto* value_segment = dynamic_cast<const ValueSegment<ColumnDataType>*>(segments[column_id].get())) {
+        const auto& values = value_segment->values();
+        for (auto chunk_offset = begin_offset; chunk_offset < end_offset; ++chunk_offset) {
+          payload.write_value(values[chunk_offset]);
+        }
+      } else {
+        const auto& segment = *segments[column_id];
+        for (auto chunk_offset = begin_offset; chunk_offset < end_offset; ++chunk_offset) {
+          payload.write_value(type_cast<ColumnDataType>(segment[chunk_offset]));
+        }
+      }
+    });
+  }
+  return _add_record(ROWS_RECORD, payload.data);
+}
+
+uint64_t WriteAheadLog::_add_record(const uint8_t record_type, const std::string& payload) {
+  auto record = LogWriter{};
+  record.write_value(record_type);
+  record.write_value(static_cast<uint32_t>(payload.size()));
+  record.write_value(checksum(payload));
+
+  auto lock = std::lock_guard<std::mutex>{_mutex};
+  _buffer += record.data;
+  _buffer += payload;
+  return ++_last_sequence_number;
+}
+
+void WriteAheadLog::wait_until_durable(const uint64_t sequence_number) {
+  auto lock = std::unique_lock<std::mutex>{_mutex};
+  while (_durable_sequence_number < sequence_number) {
+    Assert(!_has_failed, "The write-ahead log " + _file_name + " failed, so its records are not durable.");
+    if (_is_flushing) {
+      _flushed.wait(lock);
+      continue;
+    }
+
+    // This writer flushes all buffered records, including those of other writers. Records that are added during the
+    // flush are written by the next one.
+    _is_flushing = true;
+    const auto buffer = std::move(_buffer);
+    _buffer.clear();
+    const auto flushed_sequence_number = _last_sequence_number;
+    lock.unlock();
+
+    auto is_durable = true;
+    try {
+      write_all(_file_descriptor, buffer);
+      is_durable = fdatasync(_file_descriptor) == 0;
+    } catch (...) {
+      is_durable = false;
+    }
+
+    lock.lock();
+    _is_flushing = false;
+    _has_failed = _has_failed || !is_durable;
+    _flushed.notify_all();
+    Assert(is_durable, "Could not write the write-ahead log " + _file_name);
+    _durable_sequence_number = flushed_sequence_number;
+  }
+}
+
+void WriteAheadLog::truncate() {
+  wait_until_durable(_last_sequence_number);
+  auto lock = std::lock_guard<std::mutex>{_mutex};
+  const auto is_truncated = ftruncate(_file_descriptor, static_cast<off_t>(LOG_HEADER_SIZE)) == 0 &&
+                            lseek(_file_descriptor, 0, SEEK_END) >= 0 && fdatasync(_file_descriptor) == 0;
+  _has_failed = _has_failed || !is_truncated;
+  Assert(is_truncated, "Could not truncate the write-ahead log " + _file_name);
+}
+
+bool WriteAheadLog::replay(const std::string& file_name, Table& table) {
+  if (!std::filesystem::exists(file_name) || std::filesystem::file_size(file_name) == 0) {
+    return false;
+  }
+
+  const auto file = MappedFile{file_name};
+  file.advise_sequential_access();
+  for_each_record(file.contents(), [&](const uint8_t record_type, const std::string_view payload) {
+    auto reader = LogReader{payload};
+    if (record_type == COLUMN_RECORD) {
+      const auto column_id = reader.read_value<uint16_t>();
+      auto name = reader.read_value<std::string>();
+      auto type = reader.read_value<std::string>();
+      // Columns of the checkpoint are already defined.
+      if (column_id == table.column_count()) {
+        table.add_column(name, type);
+      }
+    } else {
+      Assert(record_type == ROWS_RECORD, "The write-ahead log contains an unknown record type.");
+      replay_rows(reader, table);
+    }
+  });
+  return true;
+}
+
+ChunkOffset WriteAheadLog::read_target_chunk_size(const std::string& file_name) {
+  const auto file = MappedFile{file_name};
+  auto reader = LogReader{file.contents()};
+  Assert(reader.read_value<std::remove_const_t<decltype(LOG_MAGIC)>>() == LOG_MAGIC,
+         file_name + " is not a write-ahead log.");
+  reader.read_value<uint32_t>();
+  return reader.read_value<ChunkOffset>();
+}
+
+}  // namespace opossum
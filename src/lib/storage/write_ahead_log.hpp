@@ -0,0 +1,85 @@
+#pragma once
+
+#include <condition_variable>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include "all_type_variant.hpp"
+#include "types.hpp"
+
+namespace opossum {
+
+class AbstractSegment;
+class Table;
+
+// A WriteAheadLog is a redo log of the rows and columns added to a table (see Table::enable_write_ahead_log). After a
+// crash, Table::recover restores the table from its last checkpoint (see Table::checkpoint) and replays the log on
+// top of it.
+//
+// Records are added to a buffer in the order of the changes to the table. Writers then wait until their record is
+// durable. The first waiting writer writes the whole buffer and syncs the file, while writers that add records in the
+// meantime wait for the next sync, which covers all of them (group commit). Thus, concurrent writers share a sync
+// instead of syncing the file once per record.
+//
+// Log format (integers in the byte order of the machine):
+//   file:    magic, version (uint32), target chunk size (uint32), record per record
+//   record:  type (uint8), payload size (uint32), checksum of the payload (uint32), payload
+//   column:  column id (uint16), name (string), type (string)
+//   rows:    id of the first row in the table (uint64), row count (uint32), values of each column, where strings are
+//            written as length (uint32) and characters
+// A record that is incomplete or does not match its checksum, e.g., because of a crash while it was written, ends the
+// log.
+class WriteAheadLog : private Noncopyable {
+ public:
+  // Opens the log at the given file, creating it if it does not exist. An incomplete record at the end of an existing
+  // log is removed. The target chunk size is stored for tables that are recovered without a checkpoint.
+  WriteAheadLog(const std::string& file_name, const ChunkOffset target_chunk_size);
+
+  ~WriteAheadLog();
+
+  // The following methods add a record to the buffer and return its sequence number, which is passed to
+  // wait_until_durable(). They must be called in the order in which the changes are applied to the table.
+  uint64_t log_column(const ColumnID column_id, const std::string& name, const std::string& type);
+  uint64_t log_row(const uint64_t row_id, const std::vector<std::string>& column_types,
+                   const std::vector<AllTypeVariant>& values);
+  uint64_t log_rows(const uint64_t first_row_id, const std::vector<std::string>& column_types,
+                    const std::vector<std::shared_ptr<AbstractSegment>>& segments, const ChunkOffset begin_offset,
+                    const ChunkOffset end_offset);
+
+  // Blocks until the record with the given sequence number and all records before it are written and synced. Once a
+  // write or sync failed, this fails for all records that were not durable before, including those of concurrent
+  // and later writers. The sync is not retried, as a sync that succeeds after a failed one does not guarantee that the
+  // data of the failed write reached the disk.
+  void wait_until_durable(const uint64_t sequence_number);
+
+  // Removes all records, e.g., once they are covered by a checkpoint. Records must not be added concurrently. Fails if
+  // the log failed before.
+  void truncate();
+
+  // Applies the records of the log at the given file to a table. Rows that the table already contains, e.g., because
+  // they were part of its checkpoint, are skipped. Returns false if the file does not exist.
+  static bool replay(const std::string& file_name, Table& table);
+
+  // Returns the target chunk size that is stored in the log at the given file.
+  static ChunkOffset read_target_chunk_size(const std::string& file_name);
+
+ protected:
+  uint64_t _add_record(const uint8_t record_type, const std::string& payload);
+
+  const std::string _file_name;
+  int _file_descriptor{-1};
+
+  std::string _buffer{};
+  uint64_t _last_sequence_number{0};
+  uint64_t _durable_sequence_number{0};
+  bool _is_flushing{false};
+  // set once a write, sync or truncation failed, after which no record is reported as durable anymore
+  bool _has_failed{false};
+  std::mutex _mutex{};
+  std::condition_variable _flushed{};
+};
+
+}  // namespace opossum
@@ -0,0 +1,133 @@
+#include "zone_map.hpp"
+
+#include <algorithm>
+#include <memory>
+#include <optional>
+#include <string>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "bit_packed_integer_vector.hpp"
+#include "dictionary_segment.hpp"
+#include "frame_of_reference_segment.hpp"
+#include "resolve_type.hpp"
+#include "run_length_segment.hpp"
+#include "type_cast.hpp"
+#include "value_segment.hpp"
+#include "utils/assert.hpp"
+
+namespace opossum {
+
+template <typename T>
+ZoneMap<T>::ZoneMap(const T min, const T max, const std::optional<size_t> distinct_count)
+    : _min{min}, _max{max}, _distinct_count{distinct_count} {
+  DebugAssert(!(max < min), "The minimum of a zone map must not be larger than its maximum.");
+}
+
+template <typename T>
+bool ZoneMap<T>::can_prune(const ScanType scan_type, const AllTypeVariant& search_value) const {
+  const auto value = type_cast<T>(search_value);
+
+  switch (scan_type) {
+    case ScanType::OpEquals:
+      return value < _min || _max < value;
+    case ScanType::OpNotEquals:
+      return _min == value && _max == value;
+    case ScanType::OpLessThan:
+      return !(_min < value);
+    case ScanType::OpLessThanEquals:
+      return value < _min;
+    case ScanType::OpGreaterThan:
+      return !(value < _max);
+    case ScanType::OpGreaterThanEquals:
+      return _max < value;
+  }
+  Fail("Unknown scan type.");
+}
+
+template <typename T>
+AllTypeVariant ZoneMap<T>::min() const {
+  return _min;
+}
+
+template <typename T>
+AllTypeVariant ZoneMap<T>::max() const {
+  return _max;
+}
+
+template <typename T>
+std::optional<size_t> ZoneMap<T>::distinct_count() const {
+  return _distinct_count;
+}
+
+template <typename T>
+const T& ZoneMap<T>::typed_min() const {
+  return _min;
+}
+
+template <typename T>
+const T& ZoneMap<T>::typed_max() const {
+  return _max;
+}
+
+EXPLICITLY_INSTANTIATE_DATA_TYPES(ZoneMap);
+
+std::shared_ptr<BaseZoneMap> create_zone_map(const std::string& column_type,
+                                             const std::shared_ptr<AbstractSegment>& segment) {
+  if (segment->size() == 0) {
+    return nullptr;
+  }
+
+  auto zone_map = std::shared_ptr<BaseZoneMap>{};
+  resolve_data_type(column_type, [&](const auto data_type_t) {
+    using ColumnDataType = typename decltype(data_type_t)::type;
+
+    // Dictionaries are sorted and run-length encoded segments store each run only once, so both are cheap to
+    // summarize. Other segments are summarized value by value.
+    if (const auto dictionary_segment = std::dynamic_pointer_cast<DictionarySegment<ColumnDataType>>(segment)) {
+      const auto& dictionary = dictionary_segment->dictionary();
+      zone_map = std::make_shared<ZoneMap<ColumnDataType>>(ColumnDataType{dictionary.front()},
+                                                           ColumnDataType{dictionary.back()}, dictionary.size());
+    } else if (const auto run_length_segment = std::dynamic_pointer_cast<RunLengthSegment<ColumnDataType>>(segment)) {
+      const auto& values = run_length_segment->values();
+      const auto [min_it, max_it] = std::minmax_element(values.cbegin(), values.cend());
+      zone_map = std::make_shared<ZoneMap<ColumnDataType>>(*min_it, *max_it);
+    } else if (const auto value_segment = std::dynamic_pointer_cast<ValueSegment<ColumnDataType>>(segment)) {
+      const auto& values = value_segment->values();
+      const auto [min_it, max_it] = std::minmax_element(values.cbegin(), values.cend());
+      zone_map = std::make_shared<ZoneMap<ColumnDataType>>(ColumnDataType{*min_it}, ColumnDataType{*max_it});
+    } else {
+      if constexpr (std::is_integral_v<ColumnDataType>) {
+        if (const auto frame_of_reference_segment =
+                std::dynamic_pointer_cast<FrameOfReferenceSegment<ColumnDataType>>(segment)) {
+          // The minimum of each block is stored. The maximum of a block is its minimum plus its largest offset, which
+          // is found by decoding the offsets block by block.
+          using UnsignedT = std::make_unsigned_t<ColumnDataType>;
+          constexpr auto block_size = FrameOfReferenceSegment<ColumnDataType>::BLOCK_SIZE;
+          const auto& block_minima = frame_of_reference_segment->block_minima();
+          const auto offsets = frame_of_reference_segment->offsets();
+          auto block_offsets = std::vector<ValueID>(block_size);
+          auto max = block_minima.front();
+          for (auto block_index = size_t{0}; block_index < block_minima.size(); ++block_index) {
+            const auto block_begin = block_index * block_size;
+            const auto block_end = std::min(block_begin + block_size, size_t{segment->size()});
+            offsets->decode(block_begin, block_end, block_offsets.data());
+            const auto max_offset = *std::max_element(block_offsets.cbegin(),
+                                                      block_offsets.cbegin() + (block_end - block_begin));
+            const auto block_max = static_cast<ColumnDataType>(static_cast<UnsignedT>(block_minima[block_index]) +
+                                                               static_cast<ValueID::base_type>(max_offset));
+            max = std::max(max, block_max);
+          }
+          const auto min = *std::min_element(block_minima.cbegin(), block_minima.cend());
+          zone_map = std::make_shared<ZoneMap<ColumnDataType>>(min, max);
+        }
+      }
+    }
+  });
+
+  Assert(zone_map, "Zone maps are not supported for this segment type.");
+  return zone_map;
+}
+
+}  // namespace opossum
@@ -0,0 +1,54 @@
+#pragma once
+
+#include <memory>
+#include <optional>
+#include <string>
+
+#include "all_type_variant.hpp"
+#include "types.hpp"
+
+namespace opossum {
+
+class AbstractSegment;
+
+// A zone map summarizes the values of a segment by their minimum and maximum. Scans use it to skip chunks in which no
+// value can match the predicate. As segments do not hold NULL values, no NULL count is kept.
+class BaseZoneMap : private Noncopyable {
+ public:
+  virtual ~BaseZoneMap() = default;
+
+  // Returns true if no value of the segment can satisfy "value <scan_type> search_value".
+  virtual bool can_prune(const ScanType scan_type, const AllTypeVariant& search_value) const = 0;
+
+  virtual AllTypeVariant min() const = 0;
+  virtual AllTypeVariant max() const = 0;
+
+  // Returns the number of distinct values if it was cheap to determine, e.g., for dictionary segments.
+  virtual std::optional<size_t> distinct_count() const = 0;
+};
+
+template <typename T>
+class ZoneMap : public BaseZoneMap {
+ public:
+  ZoneMap(const T min, const T max, const std::optional<size_t> distinct_count = std::nullopt);
+
+  bool can_prune(const ScanType scan_type, const AllTypeVariant& search_value) const final;
+
+  AllTypeVariant min() const final;
+  AllTypeVariant max() const final;
+  std::optional<size_t> distinct_count() const final;
+
+  const T& typed_min() const;
+  const T& typed_max() const;
+
+ protected:
+  const T _min;
+  const T _max;
+  const std::optional<size_t> _distinct_count;
+};
+
+// Creates the zone map of a segment of the given column type. Returns nullptr for empty segments.
+std::shared_ptr<BaseZoneMap> create_zone_map(const std::string& column_type,
+                                             const std::shared_ptr<AbstractSegment>& segment);
+
+}  // namespace opossum
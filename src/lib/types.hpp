@@ -54,6 +54,10 @@ struct RowID {
 
 enum class ScanType { OpEquals, OpNotEquals, OpLessThan, OpLessThanEquals, OpGreaterThan, OpGreaterThanEquals };
 
+// Unencoded keeps the ValueSegment, FrameOfReference is only available for integer columns. Automatic chooses one of
+// the other encodings per segment (see encoding_advisor.hpp).
+enum class EncodingType { Unencoded, Dictionary, RunLength, FrameOfReference, Automatic };
+
 using PosList = std::vector<RowID>;
 
 // Prevents unnecessary, potentially expensive, copies by deleting copy constructor and copy assignment operator.
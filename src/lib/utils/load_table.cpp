@@ -1,34 +1,273 @@
 #include "load_table.hpp"
 
-#include <fstream>
+#include <algorithm>
+#include <charconv>
+#include <chrono>
+#include <future>
 #include <memory>
+#include <mutex>
 #include <string>
+#include <string_view>
+#include <utility>
 #include <vector>
 
+#include "resolve_type.hpp"
+#include "storage/chunk.hpp"
+#include "storage/segment_encoding_utils.hpp"
 #include "storage/table.hpp"
+#include "storage/value_segment.hpp"
+#include "utils/assert.hpp"
+#include "utils/mapped_file.hpp"
+#include "utils/string_utils.hpp"
+#include "utils/thread_pool.hpp"
 
 namespace opossum {
 
-std::shared_ptr<Table> load_table(const std::string& file_name, size_t chunk_size) {
-  std::ifstream infile(file_name);
-  Assert(infile.is_open(), "load_table: Could not find file " + file_name);
+namespace {
 
-  std::string line;
-  std::getline(infile, line);
-  std::vector<std::string> column_names = _split<std::string>(line, '|');
-  std::getline(infile, line);
-  std::vector<std::string> column_types = _split<std::string>(line, '|');
+// Ranges are not split further than this, as the tasks would not amortize their scheduling.
+constexpr auto MIN_RANGE_SIZE = size_t{1} << 20;
 
-  std::shared_ptr<Table> test_table = std::make_shared<Table>(chunk_size);
+// Returns the line at the beginning of text without its line break and removes it, including the line break, from
+// text.
+std::string_view pop_line(std::string_view& text) {
+  const auto line_end = std::min(text.find('\n'), text.size());
+  auto line = text.substr(0, line_end);
+  text.remove_prefix(std::min(line_end + 1, text.size()));
+  if (!line.empty() && line.back() == '\r') {
+    line.remove_suffix(1);
+  }
+  return line;
+}
+
+// Returns the position after the line break that follows position, or the end of text.
+size_t next_line_begin(const std::string_view text, const size_t position) {
+  const auto line_break = text.find('\n', position);
+  return line_break == std::string_view::npos ? text.size() : line_break + 1;
+}
+
+// Returns the number of lines in text, counting a last line without a line break.
+size_t count_lines(const std::string_view text) {
+  const auto line_breaks = static_cast<size_t>(std::count(text.cbegin(), text.cend(), '\n'));
+  return (text.empty() || text.back() == '\n') ? line_breaks : line_breaks + 1;
+}
+
+// Parses the fields of a single column into a ValueSegment. The type of the column is resolved once per chunk, not
+// once per field.
+class BaseColumnParser {
+ public:
+  virtual ~BaseColumnParser() = default;
+
+  virtual void parse(const std::string_view field) = 0;
+
+  virtual std::shared_ptr<AbstractSegment> finish() = 0;
+};
+
+template <typename T>
+class ColumnParser final : public BaseColumnParser {
+ public:
+  ColumnParser(const size_t row_count, const size_t character_count) {
+    if constexpr (std::is_same_v<T, std::string>) {
+      _values.reserve(row_count, character_count);
+    } else {
+      _values.reserve(row_count);
+    }
+  }
+
+  void parse(const std::string_view field) final {
+    if constexpr (std::is_same_v<T, std::string>) {
+      _values.push_back(field);
+    } else {
+      auto value = T{};
+      const auto [end, error] = std::from_chars(field.data(), field.data() + field.size(), value);
+      Assert(error == std::errc{} && end == field.data() + field.size(),
+             "load_table: Could not parse '" + std::string{field} + "'.");
+      _values.push_back(value);
+    }
+  }
+
+  std::shared_ptr<AbstractSegment> finish() final {
+    // The characters were reserved from an estimate, so the unused part is released.
+    if constexpr (std::is_same_v<T, std::string>) {
+      _values.shrink_to_fit();
+    }
+    return std::make_shared<ValueSegment<T>>(std::move(_values));
+  }
+
+ protected:
+  ValueVector<T> _values{};
+};
+
+// Parses the given lines into a chunk and encodes its segments.
+std::shared_ptr<Chunk> parse_chunk(std::string_view text, const size_t row_count,
+                                   const std::vector<std::string>& column_types, const EncodingType encoding_type) {
+  const auto column_count = column_types.size();
+  Assert(column_count > 0, "load_table: Rows cannot be loaded into a table without columns.");
+  // Each string column is expected to take an equal share of the text's characters, excluding the delimiters and line
+  // breaks. Columns with longer strings grow their heaps as needed.
+  const auto character_count = text.size() > row_count * column_count ? text.size() / column_count - row_count : 0;
+  auto parsers = std::vector<std::unique_ptr<BaseColumnParser>>{};
+  parsers.reserve(column_count);
+  for (const auto& column_type : column_types) {
+    resolve_data_type(column_type, [&](const auto data_type_t) {
+      using ColumnDataType = typename decltype(data_type_t)::type;
+      parsers.push_back(std::make_unique<ColumnParser<ColumnDataType>>(row_count, character_count));
+    });
+  }
+
+  for (auto row_id = size_t{0}; row_id < row_count; ++row_id) {
+    auto line = pop_line(text);
+    for (auto column_id = size_t{0}; column_id + 1 < column_count; ++column_id) {
+      const auto delimiter = line.find('|');
+      Assert(delimiter != std::string_view::npos, "load_table: Row has too few fields: " + std::string{line});
+      parsers[column_id]->parse(line.substr(0, delimiter));
+      line.remove_prefix(delimiter + 1);
+    }
+    Assert(line.find('|') == std::string_view::npos, "load_table: Row has too many fields: " + std::string{line});
+    parsers.back()->parse(line);
+  }
+
+  auto chunk = std::make_shared<Chunk>();
+  for (auto column_id = size_t{0}; column_id < column_count; ++column_id) {
+    chunk->add_segment(encode_segment(encoding_type, column_types[column_id], parsers[column_id]->finish()));
+  }
+  return chunk;
+}
+
+// Appends parsed chunks to the table in file order. Chunks may be parsed in any order: whichever thread finds the
+// next chunk in order ready appends it and all following ready chunks, while the other threads continue parsing.
+class ChunkPublisher {
+ public:
+  ChunkPublisher(const std::shared_ptr<Table>& table, const size_t chunk_count)
+      : _table{table}, _parsed_chunks(chunk_count) {}
+
+  void publish(const size_t chunk_index, std::shared_ptr<Chunk> chunk) {
+    {
+      auto guard = std::lock_guard<std::mutex>(_mutex);
+      _parsed_chunks[chunk_index] = std::move(chunk);
+      if (_is_publishing) {
+        return;
+      }
+      _is_publishing = true;
+    }
+
+    while (true) {
+      auto next_chunk = std::shared_ptr<Chunk>{};
+      {
+        auto guard = std::lock_guard<std::mutex>(_mutex);
+        if (_next_chunk_index == _parsed_chunks.size() || !_parsed_chunks[_next_chunk_index]) {
+          _is_publishing = false;
+          return;
+        }
+        next_chunk = std::move(_parsed_chunks[_next_chunk_index++]);
+      }
+      _table->append_chunk(next_chunk);
+    }
+  }
+
+ protected:
+  const std::shared_ptr<Table> _table;
+  std::vector<std::shared_ptr<Chunk>> _parsed_chunks;
+  size_t _next_chunk_index{0};
+  bool _is_publishing{false};
+  std::mutex _mutex{};
+};
+
+}  // namespace
+
+std::shared_ptr<Table> load_table(const std::string& file_name, size_t chunk_size, const EncodingType encoding_type,
+                                  std::ostream* log) {
+  Assert(chunk_size > 0, "load_table: The chunk size must be positive.");
+  const auto start_time = std::chrono::steady_clock::now();
+
+  const auto file = MappedFile{file_name};
+  file.advise_sequential_access();
+  auto data = file.contents();
+
+  const auto column_names = split_string_by_delimiter(std::string{pop_line(data)}, '|');
+  const auto column_types = split_string_by_delimiter(std::string{pop_line(data)}, '|');
+  Assert(column_names.size() == column_types.size(), "load_table: The header of " + file_name + " is malformed.");
+
+  auto table = std::make_shared<Table>(static_cast<ChunkOffset>(chunk_size));
   for (auto column_id = ColumnID{0}; column_id < column_names.size(); column_id++) {
-    test_table->add_column(column_names[column_id], column_types[column_id]);
+    table->add_column(column_names[column_id], column_types[column_id]);
+  }
+
+  // Split the rows into ranges of complete lines and count the lines of each range in parallel.
+  auto& thread_pool = ThreadPool::get();
+  const auto range_count = std::clamp(data.size() / MIN_RANGE_SIZE, size_t{1}, thread_pool.worker_count() * 4);
+  auto range_begins = std::vector<size_t>{0};
+  for (auto range_index = size_t{1}; range_index < range_count; ++range_index) {
+    const auto range_begin = next_line_begin(data, data.size() * range_index / range_count - 1);
+    if (range_begin > range_begins.back() && range_begin < data.size()) {
+      range_begins.push_back(range_begin);
+    }
   }
+  range_begins.push_back(data.size());
 
-  while (std::getline(infile, line)) {
-    std::vector<AllTypeVariant> values = _split<AllTypeVariant>(line, '|');
-    test_table->append(values);
+  auto line_count_tasks = std::vector<std::future<size_t>>{};
+  for (auto range_index = size_t{0}; range_index + 1 < range_begins.size(); ++range_index) {
+    const auto range_begin = range_begins[range_index];
+    const auto range = data.substr(range_begin, range_begins[range_index + 1] - range_begin);
+    line_count_tasks.push_back(thread_pool.submit([range]() { return count_lines(range); }));
   }
-  return test_table;
+  auto range_first_rows = std::vector<size_t>{0};
+  for (auto& task : line_count_tasks) {
+    thread_pool.wait(task);
+    range_first_rows.push_back(range_first_rows.back() + task.get());
+  }
+  const auto row_count = range_first_rows.back();
+  const auto chunk_count = (row_count + chunk_size - 1) / chunk_size;
+
+  // Find the first line of each chunk. Each range locates the chunk boundaries that fall into it.
+  auto chunk_begins = std::vector<size_t>(chunk_count + 1, data.size());
+  auto boundary_tasks = std::vector<std::future<void>>{};
+  for (auto range_index = size_t{0}; range_index + 1 < range_begins.size(); ++range_index) {
+    boundary_tasks.push_back(thread_pool.submit([&, range_index]() {
+      const auto first_row = range_first_rows[range_index];
+      const auto end_row = range_first_rows[range_index + 1];
+      auto position = range_begins[range_index];
+      auto row = first_row;
+      for (auto chunk_index = (first_row + chunk_size - 1) / chunk_size; chunk_index * chunk_size < end_row;
+           ++chunk_index) {
+        for (; row < chunk_index * chunk_size; ++row) {
+          position = next_line_begin(data, position);
+        }
+        chunk_begins[chunk_index] = position;
+      }
+    }));
+  }
+  for (auto& task : boundary_tasks) {
+    thread_pool.wait(task);
+    task.get();
+  }
+
+  // Parse and encode the chunks in parallel.
+  auto publisher = ChunkPublisher{table, chunk_count};
+  auto chunk_tasks = std::vector<std::future<void>>{};
+  for (auto chunk_index = size_t{0}; chunk_index < chunk_count; ++chunk_index) {
+    chunk_tasks.push_back(thread_pool.submit([&, chunk_index]() {
+      const auto chunk_begin = chunk_begins[chunk_index];
+      const auto text = data.substr(chunk_begin, chunk_begins[chunk_index + 1] - chunk_begin);
+      const auto chunk_row_count = std::min(chunk_size, row_count - chunk_index * chunk_size);
+      publisher.publish(chunk_index, parse_chunk(text, chunk_row_count, column_types, encoding_type));
+    }));
+  }
+  for (const auto& task : chunk_tasks) {
+    thread_pool.wait(task);
+  }
+  for (auto& task : chunk_tasks) {
+    task.get();
+  }
+
+  if (log) {
+    const auto duration = std::chrono::duration<double>(std::chrono::steady_clock::now() - start_time).count();
+    const auto megabytes = static_cast<double>(file.contents().size()) / (1024 * 1024);
+    *log << "Loaded " << row_count << " rows (" << megabytes << " MB) from " << file_name << " in " << duration * 1000
+         << " ms: " << (duration > 0 ? megabytes / duration : 0.0) << " MB/s" << std::endl;
+  }
+
+  return table;
 }
 
 }  // namespace opossum
@@ -1,10 +1,13 @@
 #pragma once
 
 #include <memory>
+#include <ostream>
 #include <sstream>
 #include <string>
 #include <vector>
 
+#include "types.hpp"
+
 namespace opossum {
 
 class Table;
@@ -22,7 +25,14 @@ std::vector<T> _split(const std::string& str, char delimiter) {
   return internal;
 }
 
-// This is a helper method which is heavily used in our test suite
-std::shared_ptr<Table> load_table(const std::string& file_name, size_t chunk_size);
+// This is a helper method which is heavily used in our test suite. It loads a .tbl file, i.e., a file whose first two
+// lines hold the '|'-separated column names and types, followed by one line per row.
+//
+// The file is memory-mapped and split into ranges of complete lines, which are parsed in parallel on the ThreadPool
+// directly into the ValueSegments of chunks with chunk_size rows. Each chunk is encoded with the given encoding as
+// soon as it is parsed and appended to the table in file order. If a log is given, the throughput is written to it.
+std::shared_ptr<Table> load_table(const std::string& file_name, size_t chunk_size,
+                                  const EncodingType encoding_type = EncodingType::Unencoded,
+                                  std::ostream* log = nullptr);
 
 }  // namespace opossum
@@ -0,0 +1,46 @@
+#include "mapped_file.hpp"
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <string>
+#include <string_view>
+
+#include "utils/assert.hpp"
+
+namespace opossum {
+
+MappedFile::MappedFile(const std::string& file_name) {
+  const auto file_descriptor = open(file_name.c_str(), O_RDONLY);
+  Assert(file_descriptor >= 0, "Could not find file " + file_name);
+
+  struct stat file_status {};
+  const auto stat_result = fstat(file_descriptor, &file_status);
+  _size = stat_result == 0 ? static_cast<size_t>(file_status.st_size) : size_t{0};
+  if (stat_result == 0 && _size > 0) {
+    _data = mmap(nullptr, _size, PROT_READ, MAP_PRIVATE, file_descriptor, 0);
+  }
+  close(file_descriptor);
+
+  Assert(stat_result == 0 && _data != MAP_FAILED, "Could not map file " + file_name);
+}
+
+MappedFile::~MappedFile() {
+  if (_data && _data != MAP_FAILED) {
+    munmap(_data, _size);
+  }
+}
+
+std::string_view MappedFile::contents() const {
+  return _data ? std::string_view{static_cast<const char*>(_data), _size} : std::string_view{};
+}
+
+void MappedFile::advise_sequential_access() const {
+  if (_data) {
+    madvise(_data, _size, MADV_SEQUENTIAL);
+  }
+}
+
+}  // namespace opossum
@@ -0,0 +1,29 @@
+#pragma once
+
+#include <string>
+#include <string_view>
+
+#include "types.hpp"
+
+namespace opossum {
+
+// MappedFile maps a file read-only into memory for the lifetime of the object. The mapping is backed by the page
+// cache, so its pages are only read when they are accessed and can be evicted by the operating system at any time.
+class MappedFile : private Noncopyable {
+ public:
+  explicit MappedFile(const std::string& file_name);
+
+  ~MappedFile();
+
+  // Returns the contents of the file. The view is valid as long as the object exists.
+  std::string_view contents() const;
+
+  // Hints that the file will be read sequentially, so that the operating system reads ahead aggressively.
+  void advise_sequential_access() const;
+
+ protected:
+  void* _data{nullptr};
+  size_t _size{0};
+};
+
+}  // namespace opossum
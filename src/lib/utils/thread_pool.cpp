@@ -0,0 +1,139 @@
+#include "thread_pool.hpp"
+
+#include <algorithm>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <thread>
+#include <utility>
+
+#include "utils/assert.hpp"
+
+namespace opossum {
+
+namespace {
+
+// identifies the pool and queue of the current thread if it is a worker
+thread_local const ThreadPool* current_pool = nullptr;
+thread_local size_t current_worker_id = 0;
+
+}  // namespace
+
+ThreadPool& ThreadPool::get() {
+  static auto instance = ThreadPool{std::max(size_t{std::thread::hardware_concurrency()}, size_t{1})};
+  return instance;
+}
+
+ThreadPool::ThreadPool(const size_t worker_count) {
+  Assert(worker_count > 0, "A thread pool needs at least one worker.");
+  for (auto worker_id = size_t{0}; worker_id < worker_count; ++worker_id) {
+    _queues.push_back(std::make_unique<TaskQueue>());
+  }
+  for (auto worker_id = size_t{0}; worker_id < worker_count; ++worker_id) {
+    _workers.emplace_back(&ThreadPool::_run_worker, this, worker_id);
+  }
+}
+
+ThreadPool::~ThreadPool() {
+  {
+    auto lock = std::lock_guard<std::mutex>{_sleep_mutex};
+    _shutdown = true;
+  }
+  _sleep_condition.notify_all();
+  for (auto& worker : _workers) {
+    worker.join();
+  }
+}
+
+size_t ThreadPool::worker_count() const { return _workers.size(); }
+
+void ThreadPool::_push_task(Task task) {
+  // Workers add tasks to their own queue, other threads distribute them round robin.
+  // The task is counted before it is queued, so that the count never drops below zero when it is taken immediately.
+  {
+    auto lock = std::lock_guard<std::mutex>{_sleep_mutex};
+    ++_pending_task_count;
+  }
+
+  // Workers add tasks to their own queue, other threads distribute them round robin.
+  const auto queue_id =
+      current_pool == this ? current_worker_id : _next_queue.fetch_add(1, std::memory_order_relaxed) % _queues.size();
+  {
+    auto& queue = *_queues[queue_id];
+    auto lock = std::lock_guard<std::mutex>{queue.mutex};
+    queue.tasks.push_back(std::move(task));
+  }
+  _sleep_condition.notify_one();
+  // Waiting threads execute the task as well, as all workers may be waiting for other tasks.
+  _progress_condition.notify_all();
+}
+
+std::optional<ThreadPool::Task> ThreadPool::_pop_task() {
+  const auto queue_count = _queues.size();
+  const auto own_queue_id = current_pool == this ? current_worker_id : size_t{0};
+
+  // The own queue is used as a stack, the queues of other workers are stolen from at the opposite end.
+  for (auto offset = size_t{0}; offset < queue_count; ++offset) {
+    const auto queue_id = (own_queue_id + offset) % queue_count;
+    auto& queue = *_queues[queue_id];
+    auto lock = std::lock_guard<std::mutex>{queue.mutex};
+    if (queue.tasks.empty()) {
+      continue;
+    }
+
+    auto task = std::optional<Task>{};
+    if (current_pool == this && offset == 0) {
+      task = std::move(queue.tasks.back());
+      queue.tasks.pop_back();
+    } else {
+      task = std::move(queue.tasks.front());
+      queue.tasks.pop_front();
+    }
+    --_pending_task_count;
+    return task;
+  }
+
+  return std::nullopt;
+}
+
+bool ThreadPool::_try_run_pending_task() {
+  auto task = _pop_task();
+  if (!task) {
+    return false;
+  }
+  (*task)();
+
+  // A thread in wait() checks its future while holding _sleep_mutex, so it either sees the completed task or is
+  // already sleeping when it is notified.
+  {
+    auto lock = std::lock_guard<std::mutex>{_sleep_mutex};
+  }
+  _progress_condition.notify_all();
+  return true;
+}
+
+void ThreadPool::_wait_for_progress(const std::function<bool()>& is_done) {
+  auto lock = std::unique_lock<std::mutex>{_sleep_mutex};
+  _progress_condition.wait(lock, [&] { return _pending_task_count > 0 || is_done(); });
+}
+
+void ThreadPool::_run_worker(const size_t worker_id) {
+  current_pool = this;
+  current_worker_id = worker_id;
+
+  while (true) {
+    if (_try_run_pending_task()) {
+      continue;
+    }
+
+    auto lock = std::unique_lock<std::mutex>{_sleep_mutex};
+    _sleep_condition.wait(lock, [&] { return _shutdown || _pending_task_count > 0; });
+    // remaining tasks are executed before shutting down, so that no future is left without a result
+    if (_shutdown && _pending_task_count == 0) {
+      return;
+    }
+  }
+}
+
+}  // namespace opossum
@@ -0,0 +1,97 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "types.hpp"
+
+namespace opossum {
+
+// The ThreadPool is a process-wide singleton that executes tasks on one worker thread per hardware thread. Each
+// worker has its own task queue. Tasks submitted by a worker are added to its own queue and executed last in, first
+// out, which keeps their data in the worker's caches. Idle workers steal the oldest tasks of other workers.
+//
+// Tasks may submit further tasks and wait for them with wait(). Waiting threads execute pending tasks in the
+// meantime, so that nested parallelism (e.g., over chunks and over the columns of each chunk) cannot run out of
+// workers.
+class ThreadPool : private Noncopyable {
+ public:
+  static ThreadPool& get();
+
+  // Creates a pool with the given number of workers. Use get() unless a separate pool is required, e.g., in tests.
+  explicit ThreadPool(const size_t worker_count);
+
+  // Executes all remaining tasks and stops the workers.
+  ~ThreadPool();
+
+  size_t worker_count() const;
+
+  // Schedules a task. The returned future holds the task's result or rethrows its exception.
+  template <typename Functor>
+  std::future<std::invoke_result_t<std::decay_t<Functor>>> submit(Functor&& functor) {
+    using Result = std::invoke_result_t<std::decay_t<Functor>>;
+    // std::function requires copyable functors, but packaged tasks can only be moved
+    auto task = std::make_shared<std::packaged_task<Result()>>(std::forward<Functor>(functor));
+    auto future = task->get_future();
+    _push_task([task]() { (*task)(); });
+    return future;
+  }
+
+  // Blocks until the future is ready and executes pending tasks in the meantime. Without pending tasks, the thread
+  // sleeps until a task is submitted or completed.
+  template <typename T>
+  void wait(const std::future<T>& future) {
+    const auto is_ready = [&]() { return future.wait_for(std::chrono::seconds{0}) == std::future_status::ready; };
+    while (!is_ready()) {
+      if (!_try_run_pending_task()) {
+        _wait_for_progress(is_ready);
+      }
+    }
+  }
+
+ protected:
+  using Task = std::function<void()>;
+
+  struct TaskQueue {
+    std::deque<Task> tasks{};
+    std::mutex mutex{};
+  };
+
+  void _push_task(Task task);
+
+  // Takes a task from the queue of the calling worker or steals one from another queue.
+  std::optional<Task> _pop_task();
+
+  // Executes a single pending task. Returns false if there was none.
+  bool _try_run_pending_task();
+
+  // Sleeps until a task is pending or is_done() returns true, which is checked whenever a task completes.
+  void _wait_for_progress(const std::function<bool()>& is_done);
+
+  void _run_worker(const size_t worker_id);
+
+  std::vector<std::unique_ptr<TaskQueue>> _queues{};
+  std::vector<std::thread> _workers{};
+  std::atomic<size_t> _next_queue{0};
+
+  // Idle workers sleep until a task is pushed or the pool shuts down.
+  std::atomic<size_t> _pending_task_count{0};
+  bool _shutdown{false};
+  std::mutex _sleep_mutex{};
+  std::condition_variable _sleep_condition{};
+  // Threads in wait() sleep until a task is pushed or completed.
+  std::condition_variable _progress_condition{};
+};
+
+}  // namespace opossum
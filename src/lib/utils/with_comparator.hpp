@@ -0,0 +1,43 @@
+#pragma once
+
+#include <functional>
+
+#include "types.hpp"
+#include "utils/assert.hpp"
+
+namespace opossum {
+
+// Passes the comparison function object that corresponds to the given scan type on to a generic lambda, e.g.,
+// std::less<>{} for ScanType::OpLessThan. This way, the comparison is resolved once instead of once per value:
+//
+//   with_comparator(scan_type, [&](auto comparator) {
+//     for (...) {
+//       if (comparator(value, search_value)) { ... }
+//     }
+//   });
+template <typename Functor>
+void with_comparator(const ScanType scan_type, const Functor& func) {
+  switch (scan_type) {
+    case ScanType::OpEquals:
+      func(std::equal_to<>{});
+      return;
+    case ScanType::OpNotEquals:
+      func(std::not_equal_to<>{});
+      return;
+    case ScanType::OpLessThan:
+      func(std::less<>{});
+      return;
+    case ScanType::OpLessThanEquals:
+      func(std::less_equal<>{});
+      return;
+    case ScanType::OpGreaterThan:
+      func(std::greater<>{});
+      return;
+    case ScanType::OpGreaterThanEquals:
+      func(std::greater_equal<>{});
+      return;
+  }
+  Fail("Unsupported scan type.");
+}
+
+}  // namespace opossum
@@ -6,6 +6,7 @@
 #include <utility>
 #include <vector>
 
+#include "storage/buffer_manager.hpp"
 #include "storage/storage_manager.hpp"
 #include "storage/table.hpp"
 #include "type_cast.hpp"
@@ -158,6 +159,9 @@ void BaseTest::_print_matrix(const BaseTest::Matrix& matrix) {
   return ::testing::AssertionSuccess();
 }
 
-BaseTest::~BaseTest() { StorageManager::get().reset(); }
+BaseTest::~BaseTest() {
+  StorageManager::get().reset();
+  BufferManager::get().reset();
+}
 
 }  // namespace opossum
@@ -0,0 +1,195 @@
+#include <filesystem>
+#include <fstream>
+#include <memory>
+#include <string>
+#include <typeinfo>
+
+#include "base_test.hpp"
+
+#include "import_export/binary_parser.hpp"
+#include "import_export/binary_writer.hpp"
+#include "statistics/table_statistics.hpp"
+#include "storage/bit_packed_integer_vector.hpp"
+#include "storage/dictionary_segment.hpp"
+#include "storage/frame_of_reference_segment.hpp"
+#include "storage/run_length_segment.hpp"
+#include "storage/storage_manager.hpp"
+#include "storage/table.hpp"
+#include "storage/validity_bitmap.hpp"
+#include "storage/value_segment.hpp"
+#include "storage/zone_map.hpp"
+
+namespace opossum {
+
+class ImportExportBinaryTest : public BaseTest {
+ protected:
+  void SetUp() override {
+    _table = std::make_shared<Table>(100);
+    _table->add_column("a", "int");
+    _table->add_column("b", "long");
+    _table->add_column("c", "float");
+    _table->add_column("d", "double");
+    _table->add_column("e", "string");
+    for (auto row_id = 0; row_id < 450; ++row_id) {
+      _table->append({row_id % 7, int64_t{row_id} * 1000, row_id * 0.5f, row_id / 3 * 1.5,
+                      "https://example.com/" + std::to_string(row_id % 40)});
+    }
+  }
+
+  void TearDown() override { std::filesystem::remove_all(_directory); }
+
+  std::shared_ptr<Table> _table;
+  const std::filesystem::path _directory = std::filesystem::temp_directory_path() / "opossum_binary_test";
+};
+
+TEST_F(ImportExportBinaryTest, WriteAndParseAllEncodings) {
+  _table->compress_chunk(ChunkID{0}, EncodingType::Dictionary);
+  _table->compress_chunk(ChunkID{1}, EncodingType::RunLength);
+  _table->compress_chunk(ChunkID{2}, EncodingType::Automatic);
+
+  std::filesystem::create_directories(_directory);
+  const auto file_name = (_directory / "table.bin").string();
+  BinaryWriter::write(*_table, file_name);
+  EXPECT_FALSE(std::filesystem::exists(file_name + ".tmp"));
+
+  const auto parsed_table = BinaryParser::parse(file_name);
+  EXPECT_EQ(parsed_table->target_chunk_size(), 100u);
+  EXPECT_TABLE_EQ(*parsed_table, *_table, true);
+
+  // segments keep their encoding
+  for (auto chunk_id = ChunkID{0}; chunk_id < 5; ++chunk_id) {
+    for (auto column_id = ColumnID{0}; column_id < _table->column_count(); ++column_id) {
+      const auto& segment = *_table->get_chunk(chunk_id)->get_segment(column_id);
+      const auto& parsed_segment = *parsed_table->get_chunk(chunk_id)->get_segment(column_id);
+      EXPECT_EQ(typeid(parsed_segment), typeid(segment));
+    }
+  }
+  EXPECT_TRUE(std::dynamic_pointer_cast<DictionarySegment<std::string>>(
+      parsed_table->get_chunk(ChunkID{0})->get_segment(ColumnID{4})));
+  EXPECT_TRUE(std::dynamic_pointer_cast<RunLengthSegment<std::string>>(
+      parsed_table->get_chunk(ChunkID{1})->get_segment(ColumnID{4})));
+
+  // rows can still be appended
+  parsed_table->append({1, int64_t{2}, 3.0f, 4.0, "five"});
+  EXPECT_EQ(parsed_table->row_count(), 451u);
+}
+
+TEST_F(ImportExportBinaryTest, WriteAndParseFrameOfReference) {
+  auto table = Table{3};
+  table.add_column("a", "int");
+  table.add_column("b", "long");
+  for (auto row_id = 0; row_id < 5; ++row_id) {
+    table.append({row_id * 11, (int64_t{1} << 40) + row_id});
+  }
+  table.compress_all_chunks(EncodingType::FrameOfReference);
+
+  std::filesystem::create_directories(_directory);
+  const auto file_name = (_directory / "table.bin").string();
+  BinaryWriter::write(table, file_name);
+  const auto parsed_table = BinaryParser::parse(file_name);
+  EXPECT_TABLE_EQ(*parsed_table, table, true);
+  EXPECT_TRUE(std::dynamic_pointer_cast<FrameOfReferenceSegment<int64_t>>(
+      parsed_table->get_chunk(ChunkID{1})->get_segment(ColumnID{1})));
+}
+
+TEST_F(ImportExportBinaryTest, ReferenceMappedFile) {
+  _table->compress_all_chunks();
+  std::filesystem::create_directories(_directory);
+  const auto file_name = (_directory / "table.bin").string();
+  BinaryWriter::write(*_table, file_name);
+  auto parsed_table = BinaryParser::parse(file_name);
+
+  const auto int_segment = std::dynamic_pointer_cast<DictionarySegment<int32_t>>(
+      parsed_table->get_chunk(ChunkID{0})->get_segment(ColumnID{0}));
+  const auto string_segment = std::dynamic_pointer_cast<DictionarySegment<std::string>>(
+      parsed_table->get_chunk(ChunkID{0})->get_segment(ColumnID{4}));
+  ASSERT_TRUE(int_segment && string_segment);
+  EXPECT_TRUE(int_segment->dictionary().is_mapped());
+  EXPECT_TRUE(string_segment->dictionary().prefix_lengths().is_mapped());
+  EXPECT_TRUE(string_segment->dictionary().entries().characters().is_mapped());
+  // seven distinct values are bit-packed with three bits
+  const auto& attribute_vector = dynamic_cast<const BitPackedIntegerVector&>(*int_segment->attribute_vector());
+  EXPECT_TRUE(attribute_vector.words().is_mapped());
+
+  // the mapping remains valid after the file is removed and the table is dropped
+  std::filesystem::remove(file_name);
+  parsed_table = nullptr;
+  EXPECT_EQ(int_segment->get(6), 6);
+  EXPECT_EQ(string_segment->get(39), "https://example.com/39");
+
+  // a mapped table can be written again
+  BinaryWriter::write(*_table, file_name);
+  const auto copy_file_name = (_directory / "copy.bin").string();
+  BinaryWriter::write(*BinaryParser::parse(file_name), copy_file_name);
+  EXPECT_TABLE_EQ(*BinaryParser::parse(copy_file_name), *_table, true);
+}
+
+TEST_F(ImportExportBinaryTest, RestoreZoneMapsAndDeferStatistics) {
+  std::filesystem::create_directories(_directory);
+  const auto file_name = (_directory / "table.bin").string();
+  BinaryWriter::write(*_table, file_name);
+  const auto parsed_table = BinaryParser::parse(file_name);
+
+  // the zone maps of the four full chunks are read from the file, while the last chunk was still being filled
+  const auto zone_map = parsed_table->get_chunk(ChunkID{1})->zone_map(ColumnID{4});
+  ASSERT_TRUE(zone_map);
+  EXPECT_EQ(zone_map->min(), AllTypeVariant{"https://example.com/0"});
+  EXPECT_EQ(zone_map->max(), AllTypeVariant{"https://example.com/9"});
+  EXPECT_TRUE(parsed_table->get_chunk(ChunkID{1})->can_prune(ColumnID{1}, ScanType::OpLessThan, int64_t{100'000}));
+  EXPECT_FALSE(parsed_table->get_chunk(ChunkID{4})->zone_map(ColumnID{0}));
+
+  // statistics are created on first use and cover all chunks of the file
+  EXPECT_EQ(parsed_table->table_statistics()->row_count(), 450u);
+  EXPECT_TRUE(parsed_table->get_chunk(ChunkID{4})->zone_map(ColumnID{0}));
+  EXPECT_EQ(parsed_table->table_statistics()->row_count(), 450u);
+}
+
+TEST_F(ImportExportBinaryTest, KeepDeletedRows) {
+  _table->compress_chunk(ChunkID{1});
+  _table->delete_rows({RowID{ChunkID{0}, ChunkOffset{3}}, RowID{ChunkID{1}, ChunkOffset{99}},
+                       RowID{ChunkID{4}, ChunkOffset{0}}});
+
+  std::filesystem::create_directories(_directory);
+  const auto file_name = (_directory / "table.bin").string();
+  BinaryWriter::write(*_table, file_name);
+  const auto parsed_table = BinaryParser::parse(file_name);
+
+  EXPECT_EQ(parsed_table->approx_valid_row_count(), 447u);
+  EXPECT_FALSE(parsed_table->get_chunk(ChunkID{0})->validity()->is_valid(ChunkOffset{3}));
+  EXPECT_TRUE(parsed_table->get_chunk(ChunkID{0})->validity()->is_valid(ChunkOffset{4}));
+  EXPECT_FALSE(parsed_table->get_chunk(ChunkID{1})->validity()->is_valid(ChunkOffset{99}));
+  EXPECT_FALSE(parsed_table->get_chunk(ChunkID{4})->validity()->is_valid(ChunkOffset{0}));
+  EXPECT_FALSE(parsed_table->get_chunk(ChunkID{2})->validity());
+}
+
+TEST_F(ImportExportBinaryTest, RejectInvalidFiles) {
+  std::filesystem::create_directories(_directory);
+  const auto file_name = (_directory / "invalid.bin").string();
+  {
+    auto file = std::ofstream{file_name};
+    file << "not a table";
+  }
+  EXPECT_THROW(BinaryParser::parse(file_name), std::logic_error);
+
+  // truncated file
+  BinaryWriter::write(*_table, file_name);
+  std::filesystem::resize_file(file_name, std::filesystem::file_size(file_name) / 2);
+  EXPECT_THROW(BinaryParser::parse(file_name), std::logic_error);
+
+  EXPECT_THROW(BinaryParser::parse((_directory / "missing.bin").string()), std::logic_error);
+}
+
+TEST_F(ImportExportBinaryTest, SaveAndLoadStorageManager) {
+  auto& storage_manager = StorageManager::get();
+  _table->compress_all_chunks();
+  storage_manager.add_table("first_table", _table);
+  storage_manager.add_table("second_table", std::make_shared<Table>());
+  storage_manager.save(_directory.string());
+
+  storage_manager.reset();
+  storage_manager.load(_directory.string());
+  EXPECT_TRUE(storage_manager.has_table("second_table"));
+  EXPECT_TABLE_EQ(*storage_manager.get_table("first_table"), *_table, true);
+}
+
+}  // namespace opossum
@@ -13,8 +13,10 @@
 #include "operators/print.hpp"
 #include "operators/table_scan.hpp"
 #include "operators/table_wrapper.hpp"
+#include "storage/chunk.hpp"
 #include "storage/reference_segment.hpp"
 #include "storage/table.hpp"
+#include "storage/value_segment.hpp"
 #include "types.hpp"
 #include "utils/load_table.hpp"
 
@@ -269,4 +271,86 @@ TEST_F(OperatorsTableScanTest, ScanOnWideDictionarySegment) {
   EXPECT_EQ(scan_2->get_output()->row_count(), static_cast<size_t>(37));
 }
 
+TEST_F(OperatorsTableScanTest, ScanEncodedSegments) {
+  // 1000 rows with values 0 to 99 and deleted rows, which a scan skips, in each encoding and in a referencing scan
+  for (const auto encoding_type : {EncodingType::Unencoded, EncodingType::Dictionary, EncodingType::RunLength,
+                                   EncodingType::Automatic}) {
+    auto table = std::make_shared<Table>(300);
+    table->add_column("a", "int");
+    table->add_column("b", "string");
+    for (auto index = int32_t{0}; index < 1000; ++index) {
+      table->append({index / 10, "value " + std::to_string(index % 100)});
+    }
+    for (auto chunk_id = ChunkID{0}; chunk_id < 3; ++chunk_id) {
+      table->compress_chunk(chunk_id, encoding_type);
+    }
+    auto deleted_positions = PosList{};
+    for (auto chunk_offset = ChunkOffset{0}; chunk_offset < 300; chunk_offset += 3) {
+      deleted_positions.push_back(RowID{ChunkID{1}, chunk_offset});
+    }
+    table->delete_rows(deleted_positions);
+
+    auto table_wrapper = std::make_shared<TableWrapper>(table);
+    table_wrapper->execute();
+
+    // values 30 to 59 are in chunk 1, a third of whose rows are deleted
+    auto scan_1 = std::make_shared<TableScan>(table_wrapper, ColumnID{0}, ScanType::OpLessThan, 45);
+    scan_1->execute();
+    EXPECT_EQ(scan_1->get_output()->row_count(), 400u);
+
+    auto scan_2 = std::make_shared<TableScan>(scan_1, ColumnID{0}, ScanType::OpGreaterThanEquals, 40);
+    scan_2->execute();
+    EXPECT_EQ(scan_2->get_output()->row_count(), 34u);
+
+    auto scan_3 = std::make_shared<TableScan>(table_wrapper, ColumnID{0}, ScanType::OpNotEquals, 95);
+    scan_3->execute();
+    EXPECT_EQ(scan_3->get_output()->row_count(), 890u);
+
+    // the zone maps prune all chunks
+    auto scan_4 = std::make_shared<TableScan>(table_wrapper, ColumnID{0}, ScanType::OpGreaterThan, 99);
+    scan_4->execute();
+    EXPECT_EQ(scan_4->get_output()->row_count(), 0u);
+
+    auto scan_5 = std::make_shared<TableScan>(table_wrapper, ColumnID{1}, ScanType::OpEquals, "value 7");
+    scan_5->execute();
+    EXPECT_EQ(scan_5->get_output()->row_count(), 9u);
+
+    auto scan_6 = std::make_shared<TableScan>(scan_1, ColumnID{1}, ScanType::OpLessThanEquals, "value 1");
+    scan_6->execute();
+    ASSERT_COLUMN_EQ(scan_6->get_output(), ColumnID{0}, {0, 0, 10, 10, 20, 20, 30, 40, 40});
+  }
+}
+
+TEST_F(OperatorsTableScanTest, KeepPositionsAcrossReorganization) {
+  auto table = std::make_shared<Table>(10);
+  table->add_column("a", "int");
+  for (auto chunk_index = 0; chunk_index < 4; ++chunk_index) {
+    auto chunk = std::make_shared<Chunk>();
+    chunk->add_segment(std::make_shared<ValueSegment<int32_t>>());
+    for (auto value = chunk_index * 3; value < chunk_index * 3 + 3; ++value) {
+      chunk->append({value});
+    }
+    table->append_chunk(chunk);
+  }
+  auto table_wrapper = std::make_shared<TableWrapper>(table);
+  table_wrapper->execute();
+
+  auto scan_1 = std::make_shared<TableScan>(table_wrapper, ColumnID{0}, ScanType::OpGreaterThanEquals, 7);
+  scan_1->execute();
+  const auto& output_segment =
+      static_cast<const ReferenceSegment&>(*scan_1->get_output()->get_chunk(ChunkID{0})->get_segment(ColumnID{0}));
+
+  // Coalescing moves the rows to other positions, while the output still reads the chunks it was computed on.
+  EXPECT_EQ(table->coalesce_chunks(5), 2u);
+  ASSERT_COLUMN_EQ(scan_1->get_output(), ColumnID{0}, {7, 8, 9, 10, 11});
+  auto scan_2 = std::make_shared<TableScan>(scan_1, ColumnID{0}, ScanType::OpLessThan, 10);
+  scan_2->execute();
+  ASSERT_COLUMN_EQ(scan_2->get_output(), ColumnID{0}, {7, 8, 9});
+
+  // the outdated positions cannot be used to delete rows
+  EXPECT_NE(output_segment.layout_version(), table->layout_version());
+  EXPECT_THROW(table->delete_rows(*output_segment.pos_list(), output_segment.layout_version()), std::logic_error);
+  EXPECT_EQ(table->approx_valid_row_count(), 12u);
+}
+
 }  // namespace opossum
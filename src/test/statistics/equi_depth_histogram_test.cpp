@@ -0,0 +1,65 @@
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "base_test.hpp"
+
+#include "statistics/equi_depth_histogram.hpp"
+
+namespace opossum {
+
+class StatisticsEquiDepthHistogramTest : public BaseTest {};
+
+TEST_F(StatisticsEquiDepthHistogramTest, FromSortedValues) {
+  const auto histogram = EquiDepthHistogram<int32_t>::from_sorted_values({1, 2, 3, 3, 3, 3, 4, 5, 6, 7}, 3);
+
+  // the bin with the threes is extended, as equal values are not split
+  ASSERT_EQ(histogram->bin_count(), 2u);
+  EXPECT_EQ(histogram->bin_minimum(0), 1);
+  EXPECT_EQ(histogram->bin_maximum(0), 3);
+  EXPECT_EQ(histogram->bin_height(0), 6u);
+  EXPECT_EQ(histogram->bin_minimum(1), 4);
+  EXPECT_EQ(histogram->bin_maximum(1), 7);
+  EXPECT_EQ(histogram->bin_height(1), 4u);
+  EXPECT_EQ(histogram->total_count(), 10u);
+
+  EXPECT_EQ(EquiDepthHistogram<int32_t>::from_sorted_values({}, 3)->bin_count(), 0u);
+}
+
+TEST_F(StatisticsEquiDepthHistogramTest, Merge) {
+  auto values = std::vector<int32_t>(100);
+  for (auto index = 0; index < 100; ++index) {
+    values[index] = index;
+  }
+  const auto first = EquiDepthHistogram<int32_t>::from_sorted_values({values.begin(), values.begin() + 50}, 10);
+  const auto second = EquiDepthHistogram<int32_t>::from_sorted_values({values.begin() + 50, values.end()}, 10);
+
+  const auto merged = EquiDepthHistogram<int32_t>::merge({first, second}, 4);
+  EXPECT_EQ(merged->bin_count(), 4u);
+  EXPECT_EQ(merged->total_count(), 100u);
+  EXPECT_EQ(merged->bin_minimum(0), 0);
+  EXPECT_EQ(merged->bin_maximum(3), 99);
+  EXPECT_EQ(merged->bin_height(0), 25u);
+}
+
+TEST_F(StatisticsEquiDepthHistogramTest, EstimateCardinality) {
+  auto values = std::vector<double>(1000);
+  for (auto index = 0; index < 1000; ++index) {
+    values[index] = index / 10;
+  }
+  const auto histogram = EquiDepthHistogram<double>::from_sorted_values(values, 10);
+
+  EXPECT_NEAR(histogram->estimate_cardinality(ScanType::OpLessThan, 25.0, 100), 250.0f, 10.0f);
+  EXPECT_NEAR(histogram->estimate_cardinality(ScanType::OpGreaterThanEquals, 25.0, 100), 750.0f, 10.0f);
+  EXPECT_FLOAT_EQ(histogram->estimate_cardinality(ScanType::OpEquals, 25.0, 100), 10.0f);
+  EXPECT_FLOAT_EQ(histogram->estimate_cardinality(ScanType::OpEquals, 200.0, 100), 0.0f);
+  EXPECT_FLOAT_EQ(histogram->estimate_cardinality(ScanType::OpNotEquals, 200.0, 100), 1000.0f);
+  EXPECT_FLOAT_EQ(histogram->estimate_cardinality(ScanType::OpLessThanEquals, 100.0, 100), 1000.0f);
+  EXPECT_FLOAT_EQ(histogram->estimate_cardinality(ScanType::OpGreaterThan, -1.0, 100), 1000.0f);
+
+  const auto string_histogram = EquiDepthHistogram<std::string>::from_sorted_values({"a", "b", "c", "d"}, 2);
+  EXPECT_FLOAT_EQ(string_histogram->estimate_cardinality(ScanType::OpLessThan, "c", 4), 2.0f);
+  EXPECT_FLOAT_EQ(string_histogram->estimate_cardinality(ScanType::OpLessThan, "aa", 4), 1.0f);
+}
+
+}  // namespace opossum
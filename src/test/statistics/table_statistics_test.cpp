@@ -0,0 +1,72 @@
+#include <memory>
+#include <string>
+
+#include "base_test.hpp"
+
+#include "statistics/distinct_count_sketch.hpp"
+#include "statistics/table_statistics.hpp"
+#include "storage/table.hpp"
+
+namespace opossum {
+
+class StatisticsTableStatisticsTest : public BaseTest {
+ protected:
+  void SetUp() override {
+    table.add_column("a", "int");
+    table.add_column("b", "string");
+    for (auto index = 0; index < 2'500; ++index) {
+      table.append({index, std::string{index % 2 == 0 ? "even" : "odd"}});
+    }
+  }
+
+  Table table{1'000};
+};
+
+TEST_F(StatisticsTableStatisticsTest, DistinctCountSketch) {
+  auto sketch = DistinctCountSketch{};
+  for (auto value = 0; value < 500; ++value) {
+    sketch.add(value);
+    sketch.add(value);
+  }
+  EXPECT_EQ(sketch.estimate(), 500u);
+
+  auto other_sketch = DistinctCountSketch{};
+  for (auto value = 0; value < 100'000; ++value) {
+    other_sketch.add(value);
+  }
+  sketch.merge(other_sketch);
+  EXPECT_NEAR(static_cast<double>(sketch.estimate()), 100'000.0, 10'000.0);
+}
+
+TEST_F(StatisticsTableStatisticsTest, CoverSealedChunks) {
+  const auto statistics = table.table_statistics();
+
+  // the third chunk is still open
+  EXPECT_EQ(statistics->row_count(), 2'000u);
+  EXPECT_EQ(statistics->column_statistics(ColumnID{0})->row_count(), 2'000u);
+  EXPECT_NEAR(static_cast<double>(statistics->column_statistics(ColumnID{0})->distinct_count()), 2'000.0, 100.0);
+  EXPECT_EQ(statistics->column_statistics(ColumnID{1})->distinct_count(), 2u);
+  EXPECT_FLOAT_EQ(statistics->column_statistics(ColumnID{1})->null_fraction(), 0.0f);
+
+  // compressing the open chunk seals it, compressing a sealed chunk does not add it again
+  table.compress_chunk(ChunkID{2});
+  table.compress_chunk(ChunkID{0});
+  EXPECT_EQ(statistics->row_count(), 2'500u);
+
+  // deleted and compacted rows remain counted
+  table.delete_rows({{ChunkID{0}, 0}, {ChunkID{0}, 1}});
+  table.compact(0.001f);
+  EXPECT_EQ(table.row_count(), 2'498u);
+  EXPECT_EQ(statistics->row_count(), 2'500u);
+}
+
+TEST_F(StatisticsTableStatisticsTest, EstimateSelectivity) {
+  const auto statistics = table.table_statistics();
+
+  EXPECT_NEAR(statistics->estimate_selectivity(ColumnID{0}, ScanType::OpLessThan, 500), 0.25f, 0.02f);
+  EXPECT_NEAR(statistics->estimate_selectivity(ColumnID{0}, ScanType::OpGreaterThanEquals, 1'500), 0.25f, 0.02f);
+  EXPECT_FLOAT_EQ(statistics->estimate_selectivity(ColumnID{0}, ScanType::OpEquals, 5'000), 0.0f);
+  EXPECT_FLOAT_EQ(statistics->estimate_selectivity(ColumnID{1}, ScanType::OpEquals, "odd"), 0.5f);
+}
+
+}  // namespace opossum
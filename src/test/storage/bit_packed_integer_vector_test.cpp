@@ -0,0 +1,85 @@
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "../base_test.hpp"
+
+#include "storage/bit_packed_integer_vector.hpp"
+
+namespace opossum {
+
+class BitPackedIntegerVectorTest : public BaseTest {};
+
+TEST_F(BitPackedIntegerVectorTest, SetOverwriteExisting) {
+  auto vec = BitPackedIntegerVector{3};
+
+  vec.set(0, ValueID{1});
+  vec.set(1, ValueID{2});
+  vec.set(2, ValueID{1});
+
+  vec.set(1, ValueID{7});
+
+  EXPECT_EQ(vec.size(), 3u);
+  EXPECT_EQ(vec.get(0), ValueID{1});
+  EXPECT_EQ(vec.get(1), ValueID{7});
+  EXPECT_EQ(vec.get(2), ValueID{1});
+}
+
+TEST_F(BitPackedIntegerVectorTest, ValuesSpanningWords) {
+  // With 9 bits, the eighth value (bits 63 to 71) is split across the first two words.
+  auto vec = BitPackedIntegerVector{9};
+  for (auto index = uint32_t{0}; index < 100; ++index) {
+    vec.set(index, ValueID{(index * 37) % 512});
+  }
+
+  for (auto index = uint32_t{0}; index < 100; ++index) {
+    EXPECT_EQ(vec.get(index), ValueID{(index * 37) % 512});
+  }
+
+  vec.set(7, ValueID{511});
+  EXPECT_EQ(vec.get(6), ValueID{(6 * 37) % 512});
+  EXPECT_EQ(vec.get(7), ValueID{511});
+  EXPECT_EQ(vec.get(8), ValueID{(8 * 37) % 512});
+}
+
+TEST_F(BitPackedIntegerVectorTest, WidthAndMemoryUsage) {
+  auto vec = BitPackedIntegerVector{9};
+  for (auto index = uint32_t{0}; index < 300; ++index) {
+    vec.set(index, ValueID{index});
+  }
+
+  EXPECT_EQ(vec.bit_width(), 9u);
+  EXPECT_EQ(vec.width(), 2u);
+  // 300 * 9 bits = 2700 bits, which need 43 words of 64 bits
+  EXPECT_EQ(vec.estimate_memory_usage(), 43u * 8u);
+}
+
+TEST_F(BitPackedIntegerVectorTest, DecodeRange) {
+  for (const auto bit_width : {uint8_t{1}, uint8_t{5}, uint8_t{17}, uint8_t{32}}) {
+    auto vec = BitPackedIntegerVector{bit_width};
+    const auto max_value = bit_width == 32 ? uint64_t{0xFFFFFFFF} : (uint64_t{1} << bit_width) - 1;
+    for (auto index = uint32_t{0}; index < 500; ++index) {
+      vec.set(index, ValueID{static_cast<uint32_t>((uint64_t{index} * 2654435761u) & max_value)});
+    }
+
+    // Ranges that start and end inside groups of 64 values, cover full groups, or are empty.
+    for (const auto& [begin_index, end_index] : std::vector<std::pair<size_t, size_t>>{
+             {0, 500}, {3, 61}, {13, 200}, {64, 128}, {70, 70}, {450, 500}}) {
+      auto decoded = std::vector<ValueID>(end_index - begin_index);
+      vec.decode(begin_index, end_index, decoded.data());
+
+      for (auto index = begin_index; index < end_index; ++index) {
+        EXPECT_EQ(decoded[index - begin_index], vec.get(index));
+      }
+    }
+
+    EXPECT_THROW(vec.decode(10, 501, nullptr), std::logic_error);
+  }
+}
+
+TEST_F(BitPackedIntegerVectorTest, InvalidBitWidth) {
+  EXPECT_THROW(BitPackedIntegerVector{0}, std::logic_error);
+  EXPECT_THROW(BitPackedIntegerVector{33}, std::logic_error);
+}
+
+}  // namespace opossum
@@ -0,0 +1,168 @@
+#include <filesystem>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "base_test.hpp"
+
+#include "resolve_type.hpp"
+#include "storage/buffer_manager.hpp"
+#include "storage/chunk.hpp"
+#include "storage/table.hpp"
+
+namespace opossum {
+
+class StorageBufferManagerTest : public BaseTest {
+ protected:
+  void SetUp() override {
+    _spill_directory = std::filesystem::temp_directory_path() / "opossum_buffer_manager_test";
+    std::filesystem::remove_all(_spill_directory);
+    BufferManager::get().set_spill_directory(_spill_directory.string());
+
+    _table = _create_table();
+    _table->compress_all_chunks(EncodingType::Dictionary);
+    _reference_table = _create_table();
+  }
+
+  void TearDown() override { std::filesystem::remove_all(_spill_directory); }
+
+  static std::shared_ptr<Table> _create_table() {
+    auto table = std::make_shared<Table>(100);
+    table->add_column("a", "int");
+    table->add_column("b", "string");
+    for (auto row_id = 0; row_id < 400; ++row_id) {
+      table->append({row_id % 70, "value " + std::to_string(row_id % 30)});
+    }
+    return table;
+  }
+
+  size_t _spill_file_count() const {
+    return static_cast<size_t>(std::distance(std::filesystem::directory_iterator{_spill_directory},
+                                             std::filesystem::directory_iterator{}));
+  }
+
+  std::filesystem::path _spill_directory;
+  std::shared_ptr<Table> _table;
+  std::shared_ptr<Table> _reference_table;
+};
+
+TEST_F(StorageBufferManagerTest, TracksCompressedChunks) {
+  auto& buffer_manager = BufferManager::get();
+  EXPECT_GT(buffer_manager.resident_memory_usage(), 0u);
+  EXPECT_EQ(buffer_manager.evicted_chunk_count(), 0u);
+
+  // chunks that are not compressed are not tracked
+  const auto memory_usage = buffer_manager.resident_memory_usage();
+  _reference_table->append({1, "value"});
+  EXPECT_EQ(buffer_manager.resident_memory_usage(), memory_usage);
+}
+
+TEST_F(StorageBufferManagerTest, EvictAndRestore) {
+  auto& buffer_manager = BufferManager::get();
+  buffer_manager.set_memory_budget(0);
+  EXPECT_EQ(buffer_manager.evicted_chunk_count(), 4u);
+  EXPECT_EQ(buffer_manager.resident_memory_usage(), 0u);
+  EXPECT_EQ(_spill_file_count(), 4u);
+
+  const auto chunk = _table->get_chunk(ChunkID{1});
+  EXPECT_FALSE(chunk->is_resident());
+  EXPECT_EQ(chunk->size(), 100u);
+  EXPECT_EQ(chunk->column_count(), 2u);
+  EXPECT_EQ(_table->row_count(), 400u);
+  EXPECT_NE(chunk->zone_map(ColumnID{0}), nullptr);
+
+  // accessing a segment restores the chunk
+  EXPECT_EQ(type_cast<int32_t>((*chunk->get_segment(ColumnID{0}))[5]), 105 % 70);
+  EXPECT_TRUE(chunk->is_resident());
+  EXPECT_EQ(buffer_manager.evicted_chunk_count(), 3u);
+
+  EXPECT_TABLE_EQ(_table, _reference_table, true);
+
+  // restored chunks are evicted again without writing them again
+  buffer_manager.set_memory_budget(0);
+  EXPECT_EQ(buffer_manager.evicted_chunk_count(), 4u);
+  EXPECT_EQ(_spill_file_count(), 4u);
+  EXPECT_TABLE_EQ(_table, _reference_table, true);
+}
+
+TEST_F(StorageBufferManagerTest, BudgetKeepsRecentlyUsedChunks) {
+  auto& buffer_manager = BufferManager::get();
+  const auto memory_usage = buffer_manager.resident_memory_usage();
+  buffer_manager.set_memory_budget(memory_usage / 2);
+  EXPECT_LE(buffer_manager.resident_memory_usage(), memory_usage / 2);
+  EXPECT_GT(buffer_manager.evicted_chunk_count(), 0u);
+  EXPECT_LT(buffer_manager.evicted_chunk_count(), 4u);
+  EXPECT_TABLE_EQ(_table, _reference_table, true);
+  EXPECT_LE(buffer_manager.resident_memory_usage(), memory_usage / 2);
+}
+
+TEST_F(StorageBufferManagerTest, PinnedChunksAreNotEvicted) {
+  auto& buffer_manager = BufferManager::get();
+  const auto chunk = _table->get_chunk(ChunkID{2});
+  chunk->pin();
+  EXPECT_TRUE(chunk->is_pinned());
+  buffer_manager.set_memory_budget(0);
+  EXPECT_TRUE(chunk->is_resident());
+  EXPECT_EQ(buffer_manager.evicted_chunk_count(), 3u);
+
+  chunk->unpin();
+  EXPECT_FALSE(chunk->is_pinned());
+  buffer_manager.set_memory_budget(0);
+  EXPECT_FALSE(chunk->is_resident());
+}
+
+TEST_F(StorageBufferManagerTest, SegmentsOutliveEviction) {
+  const auto segment = _table->get_chunk(ChunkID{0})->get_segment(ColumnID{1});
+  BufferManager::get().set_memory_budget(0);
+  EXPECT_FALSE(_table->get_chunk(ChunkID{0})->is_resident());
+  EXPECT_EQ(type_cast<std::string>((*segment)[7]), "value 7");
+}
+
+TEST_F(StorageBufferManagerTest, RemovesFilesOfDestroyedChunks) {
+  BufferManager::get().set_memory_budget(0);
+  EXPECT_EQ(_spill_file_count(), 4u);
+  _table = nullptr;
+  BufferManager::get().reset();
+  EXPECT_EQ(_spill_file_count(), 0u);
+}
+
+TEST_F(StorageBufferManagerTest, ConcurrentScans) {
+  auto& buffer_manager = BufferManager::get();
+  buffer_manager.set_memory_budget(buffer_manager.resident_memory_usage() / 4);
+
+  auto expected_sum = int64_t{0};
+  for (auto row_id = 0; row_id < 400; ++row_id) {
+    expected_sum += row_id % 70;
+  }
+
+  auto threads = std::vector<std::thread>{};
+  auto sums = std::vector<int64_t>(8);
+  for (auto thread_id = size_t{0}; thread_id < sums.size(); ++thread_id) {
+    threads.emplace_back([&, thread_id]() {
+      for (auto iteration = 0; iteration < 20; ++iteration) {
+        auto sum = int64_t{0};
+        for (auto chunk_id = ChunkID{0}; chunk_id < _table->chunk_count(); ++chunk_id) {
+          const auto chunk = _table->get_chunk(chunk_id);
+          if (chunk->size() == 0) {
+            continue;
+          }
+          const auto segment = chunk->get_segment(ColumnID{0});
+          for (auto chunk_offset = ChunkOffset{0}; chunk_offset < segment->size(); ++chunk_offset) {
+            sum += type_cast<int32_t>((*segment)[chunk_offset]);
+          }
+        }
+        sums[thread_id] = sum;
+      }
+    });
+  }
+  for (auto& thread : threads) {
+    thread.join();
+  }
+
+  for (const auto sum : sums) {
+    EXPECT_EQ(sum, expected_sum);
+  }
+}
+
+}  // namespace opossum
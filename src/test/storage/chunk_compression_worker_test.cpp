@@ -0,0 +1,66 @@
+#include <atomic>
+#include <memory>
+#include <vector>
+
+#include "base_test.hpp"
+
+#include "storage/chunk.hpp"
+#include "storage/chunk_compression_worker.hpp"
+
+namespace opossum {
+
+class StorageChunkCompressionWorkerTest : public BaseTest {
+ protected:
+  void SetUp() override {
+    for (auto chunk_index = 0; chunk_index < 3; ++chunk_index) {
+      chunks.push_back(std::make_shared<Chunk>());
+    }
+  }
+
+  std::vector<std::shared_ptr<Chunk>> chunks{};
+};
+
+TEST_F(StorageChunkCompressionWorkerTest, CompressInOrder) {
+  auto compressed_chunks = std::vector<std::shared_ptr<Chunk>>{};
+  auto worker =
+      ChunkCompressionWorker{[&](const std::shared_ptr<Chunk>& chunk) { compressed_chunks.push_back(chunk); }};
+
+  worker.enqueue(chunks[2]);
+  worker.enqueue(chunks[0]);
+  worker.enqueue(chunks[1]);
+  worker.wait_until_idle();
+
+  EXPECT_EQ(compressed_chunks, std::vector<std::shared_ptr<Chunk>>({chunks[2], chunks[0], chunks[1]}));
+
+  // waiting without queued chunks returns immediately
+  worker.wait_until_idle();
+}
+
+TEST_F(StorageChunkCompressionWorkerTest, ReportFailure) {
+  auto compressed_chunks = std::vector<std::shared_ptr<Chunk>>{};
+  auto worker = ChunkCompressionWorker{[&](const std::shared_ptr<Chunk>& chunk) {
+    Assert(chunk != chunks[1], "Cannot compress chunk.");
+    compressed_chunks.push_back(chunk);
+  }};
+
+  // the failure does not stop the worker and is reported once
+  worker.enqueue(chunks[0]);
+  worker.enqueue(chunks[1]);
+  worker.enqueue(chunks[2]);
+  EXPECT_THROW(worker.wait_until_idle(), std::logic_error);
+  EXPECT_EQ(compressed_chunks, std::vector<std::shared_ptr<Chunk>>({chunks[0], chunks[2]}));
+  EXPECT_NO_THROW(worker.wait_until_idle());
+}
+
+TEST_F(StorageChunkCompressionWorkerTest, StopWithQueuedChunks) {
+  auto compressed_chunk_count = std::atomic<size_t>{0};
+  {
+    auto worker = ChunkCompressionWorker{[&](const std::shared_ptr<Chunk>&) { ++compressed_chunk_count; }};
+    for (auto chunk_index = 0; chunk_index < 100; ++chunk_index) {
+      worker.enqueue(chunks[chunk_index % 3]);
+    }
+  }
+  EXPECT_LE(compressed_chunk_count, 100u);
+}
+
+}  // namespace opossum
@@ -5,6 +5,7 @@
 
 #include "resolve_type.hpp"
 #include "storage/abstract_segment.hpp"
+#include "storage/bit_packed_integer_vector.hpp"
 #include "storage/dictionary_segment.hpp"
 
 namespace opossum {
@@ -51,6 +52,55 @@ TEST_F(StorageDictionarySegmentTest, CompressSegmentString) {
   EXPECT_EQ(dict[3], "Steve");
 }
 
+TEST_F(StorageDictionarySegmentTest, CompressStringsWithCommonPrefixes) {
+  auto paths = std::make_shared<ValueSegment<std::string>>();
+  for (auto index = 0; index < 100; ++index) {
+    paths->append("/home/opossum/projects/dyod/src/file_" + std::to_string(index) + ".cpp");
+  }
+  auto dict_segment = std::make_shared<DictionarySegment<std::string>>(paths);
+
+  EXPECT_EQ(dict_segment->value_of_value_id(ValueID{0}), "/home/opossum/projects/dyod/src/file_0.cpp");
+  EXPECT_EQ(dict_segment->get(ChunkOffset{42}), "/home/opossum/projects/dyod/src/file_42.cpp");
+  EXPECT_EQ(dict_segment->lower_bound(std::string{"/home/opossum/projects/dyod/src/file_42.cpp"}), ValueID{37});
+  EXPECT_EQ(dict_segment->upper_bound(std::string{"/home/opossum/projects/dyod/src/file_42.cpp"}), ValueID{38});
+  EXPECT_EQ(dict_segment->upper_bound(std::string{"/home/opossum/projects/dyod/src/file_99.cpp"}), INVALID_VALUE_ID);
+  EXPECT_LT(dict_segment->estimate_memory_usage(), paths->estimate_memory_usage() / 2);
+}
+
+TEST_F(StorageDictionarySegmentTest, EncodeUnsortedValues) {
+  auto dict_segment = std::make_shared<DictionarySegment<std::string>>(value_segment_str);
+
+  const auto& values = value_segment_str->values();
+  for (auto index = ChunkOffset{0}; index < values.size(); ++index) {
+    EXPECT_EQ(dict_segment->get(index), values[index]);
+  }
+  EXPECT_EQ(dict_segment->attribute_vector()->get(1), ValueID{3});
+  EXPECT_EQ(dict_segment->attribute_vector()->get(2), ValueID{0});
+}
+
+TEST_F(StorageDictionarySegmentTest, EncodeSortedValuesWithDuplicates) {
+  value_segment_int = std::make_shared<ValueSegment<int32_t>>();
+  for (const auto value : {-3, -3, 1, 1, 1, 7, 9, 9}) {
+    value_segment_int->append(value);
+  }
+  auto dict_segment = std::make_shared<DictionarySegment<int32_t>>(value_segment_int);
+
+  EXPECT_EQ(dict_segment->dictionary(), std::vector<int32_t>({-3, 1, 7, 9}));
+  const auto& values = value_segment_int->values();
+  for (auto index = ChunkOffset{0}; index < values.size(); ++index) {
+    EXPECT_EQ(dict_segment->get(index), values[index]);
+  }
+  EXPECT_EQ(dict_segment->attribute_vector()->get(4), ValueID{1});
+  EXPECT_EQ(dict_segment->attribute_vector()->get(7), ValueID{3});
+}
+
+TEST_F(StorageDictionarySegmentTest, EncodeEmptySegment) {
+  auto dict_segment = std::make_shared<DictionarySegment<int32_t>>(std::make_shared<ValueSegment<int32_t>>());
+
+  EXPECT_EQ(dict_segment->size(), 0u);
+  EXPECT_EQ(dict_segment->unique_values_count(), 0u);
+}
+
 TEST_F(StorageDictionarySegmentTest, LowerUpperBound) {
   std::shared_ptr<AbstractSegment> segment;
   resolve_data_type("int", [&](auto type) {
@@ -104,7 +154,22 @@ TEST_F(StorageDictionarySegmentTest, AttributeVectorAccess) {
   });
   auto dict_segment = std::dynamic_pointer_cast<DictionarySegment<int32_t>>(segment);
 
+  // Six dictionary entries need three bits, so bit-packing saves more than half of the memory of uint8_t.
+  const auto& attribute_vector = dynamic_cast<const BitPackedIntegerVector&>(*dict_segment->attribute_vector());
+  EXPECT_EQ(attribute_vector.bit_width(), 3u);
+  EXPECT_EQ(attribute_vector.get(2), ValueID{2});
+}
+
+TEST_F(StorageDictionarySegmentTest, ByteAlignedAttributeVectorForSmallSavings) {
+  // 100 dictionary entries need seven bits, which does not justify the overhead of bit-packing.
+  value_segment_int = std::make_shared<ValueSegment<int32_t>>();
+  for (auto value = int32_t{0}; value < 100; ++value) {
+    value_segment_int->append(value);
+  }
+  auto dict_segment = std::make_shared<DictionarySegment<int32_t>>(value_segment_int);
+
   EXPECT_NO_THROW(dynamic_cast<const FixedWidthIntegerVector<uint8_t>&>(*dict_segment->attribute_vector()));
+  EXPECT_EQ(dict_segment->get(42), 42);
 }
 
 TEST_F(StorageDictionarySegmentTest, ValueAtValueIdAccess) {
@@ -127,7 +192,8 @@ TEST_F(StorageDictionarySegmentTest, ExtimateMemoryUsage) {
   });
   auto dict_segment = std::dynamic_pointer_cast<DictionarySegment<int32_t>>(segment);
 
-  EXPECT_EQ(dict_segment->estimate_memory_usage(), 30);
+  // 6 * 4 bytes for the dictionary and a single 64-bit word for the bit-packed attribute vector
+  EXPECT_EQ(dict_segment->estimate_memory_usage(), 32);
 }
 
 TEST_F(StorageDictionarySegmentTest, SixteenBitIntegerVector) {
@@ -157,7 +223,43 @@ TEST_F(StorageDictionarySegmentTest, ThirtytwoBitIntegerVector) {
   });
   auto dict_segment = std::dynamic_pointer_cast<DictionarySegment<int32_t>>(segment);
 
-  EXPECT_EQ(dict_segment->attribute_vector()->width(), 4);
+  // 17 bits are bit-packed instead of being padded to 32 bits.
+  EXPECT_EQ(dict_segment->attribute_vector()->width(), 3);
+  EXPECT_EQ(dynamic_cast<const BitPackedIntegerVector&>(*dict_segment->attribute_vector()).bit_width(), 17u);
+  EXPECT_EQ(dict_segment->get(65537), 65537);
+}
+
+TEST_F(StorageDictionarySegmentTest, Merge) {
+  auto other_values = std::make_shared<ValueSegment<int32_t>>(std::vector<int32_t>{5, 4, 12, 4, -1});
+  const auto first_segment = std::make_shared<const DictionarySegment<int32_t>>(value_segment_int);
+  const auto second_segment = std::make_shared<const DictionarySegment<int32_t>>(other_values);
+  const auto merged_segment = DictionarySegment<int32_t>::merge({first_segment, second_segment});
+
+  EXPECT_EQ(merged_segment->dictionary(), std::vector<int32_t>({-1, 0, 2, 4, 5, 6, 8, 10, 12}));
+  EXPECT_EQ(merged_segment->size(), 11u);
+  const auto expected_values = std::vector<int32_t>{0, 2, 4, 6, 8, 10, 5, 4, 12, 4, -1};
+  for (auto chunk_offset = ChunkOffset{0}; chunk_offset < expected_values.size(); ++chunk_offset) {
+    EXPECT_EQ(merged_segment->get(chunk_offset), expected_values[chunk_offset]);
+  }
+}
+
+TEST_F(StorageDictionarySegmentTest, MergeStrings) {
+  auto other_values = std::make_shared<ValueSegment<std::string>>();
+  for (auto index = 0; index < 40; ++index) {
+    other_values->append("Steve " + std::to_string(index % 20));
+  }
+  const auto first_segment = std::make_shared<const DictionarySegment<std::string>>(value_segment_str);
+  const auto second_segment = std::make_shared<const DictionarySegment<std::string>>(other_values);
+  const auto merged_segment = DictionarySegment<std::string>::merge({first_segment, second_segment, first_segment});
+
+  // Alexander, Bill, Hasso, Steve, and the 20 distinct values of the second segment
+  EXPECT_EQ(merged_segment->unique_values_count(), 24u);
+  EXPECT_EQ(merged_segment->size(), 52u);
+  EXPECT_EQ(merged_segment->get(1), "Steve");
+  EXPECT_EQ(merged_segment->get(6), "Steve 0");
+  EXPECT_EQ(merged_segment->get(31), "Steve 5");
+  EXPECT_EQ(merged_segment->get(51), "Bill");
+  EXPECT_EQ(merged_segment->lower_bound(std::string{"Steve 19"}), ValueID{15});
 }
 
 }  // namespace opossum
@@ -0,0 +1,108 @@
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "base_test.hpp"
+
+#include "storage/encoding_advisor.hpp"
+#include "storage/value_segment.hpp"
+
+namespace opossum {
+
+class StorageEncodingAdvisorTest : public BaseTest {
+ protected:
+  std::shared_ptr<ValueSegment<int32_t>> value_segment_int = std::make_shared<ValueSegment<int32_t>>();
+  std::shared_ptr<ValueSegment<std::string>> value_segment_str = std::make_shared<ValueSegment<std::string>>();
+};
+
+TEST_F(StorageEncodingAdvisorTest, AnalyzeSmallSegment) {
+  for (const auto value : {3, 3, 3, 1, 1, 7, 3, 3}) {
+    value_segment_int->append(value);
+  }
+
+  const auto characteristics = analyze_segment("int", value_segment_int);
+  EXPECT_EQ(characteristics.row_count, 8u);
+  EXPECT_EQ(characteristics.distinct_count, 3u);
+  EXPECT_EQ(characteristics.run_count, 4u);
+  EXPECT_FALSE(characteristics.is_sorted);
+  EXPECT_EQ(characteristics.block_value_range, 6u);
+
+  EXPECT_THROW(analyze_segment("string", value_segment_int), std::logic_error);
+}
+
+TEST_F(StorageEncodingAdvisorTest, EstimateLargeSegment) {
+  for (auto value = 0; value < 100'000; ++value) {
+    value_segment_int->append(value);
+  }
+
+  // the distinct count is estimated from a sample
+  const auto characteristics = analyze_segment("int", value_segment_int);
+  EXPECT_EQ(characteristics.row_count, 100'000u);
+  EXPECT_GT(characteristics.distinct_count, 50'000u);
+  EXPECT_EQ(characteristics.run_count, characteristics.distinct_count);
+  EXPECT_TRUE(characteristics.is_sorted);
+  EXPECT_EQ(characteristics.block_value_range, 2047u);
+}
+
+TEST_F(StorageEncodingAdvisorTest, AdviseFrameOfReferenceForIncreasingKeys) {
+  for (auto value = 0; value < 10'000; ++value) {
+    value_segment_int->append(value * 100);
+  }
+
+  const auto advice = advise_encoding("int", value_segment_int);
+  EXPECT_EQ(advice.encoding_type, EncodingType::FrameOfReference);
+  EXPECT_LT(advice.estimated_memory_usage, value_segment_int->estimate_memory_usage());
+}
+
+TEST_F(StorageEncodingAdvisorTest, AdviseUnencodedForRandomValues) {
+  for (auto value = 0u; value < 10'000u; ++value) {
+    value_segment_int->append(static_cast<int32_t>(value * 2654435761u));
+  }
+
+  EXPECT_EQ(advise_encoding("int", value_segment_int).encoding_type, EncodingType::Unencoded);
+}
+
+TEST_F(StorageEncodingAdvisorTest, AdviseDictionaryForFewDistinctValues) {
+  const auto colors = std::vector<std::string>{"red", "green", "blue"};
+  for (auto index = 0; index < 1'000; ++index) {
+    value_segment_str->append(colors[index % 3]);
+  }
+
+  EXPECT_EQ(advise_encoding("string", value_segment_str).encoding_type, EncodingType::Dictionary);
+}
+
+TEST_F(StorageEncodingAdvisorTest, AdviseRunLengthForLongRuns) {
+  for (auto value = 0; value < 10'000; ++value) {
+    value_segment_int->append(value / 1'000);
+  }
+
+  EXPECT_EQ(advise_encoding("int", value_segment_int).encoding_type, EncodingType::RunLength);
+}
+
+TEST_F(StorageEncodingAdvisorTest, AdviseRunLengthForSortedValues) {
+  // Dictionary encoding is slightly smaller for both segments, but run-length encoding is preferred for sorted values.
+  auto sorted_segment = std::make_shared<ValueSegment<std::string>>();
+  for (auto index = 0; index < 4'000; ++index) {
+    sorted_segment->append("value_" + std::to_string(1'000 + index / 10));
+    value_segment_str->append("value_" + std::to_string(1'000 + index % 400));
+  }
+
+  EXPECT_EQ(advise_encoding("string", sorted_segment).encoding_type, EncodingType::RunLength);
+  EXPECT_EQ(advise_encoding("string", value_segment_str).encoding_type, EncodingType::Dictionary);
+}
+
+TEST_F(StorageEncodingAdvisorTest, EstimateEncodedMemoryUsage) {
+  auto characteristics = SegmentCharacteristics{};
+  characteristics.row_count = 100;
+  characteristics.distinct_count = 4;
+  characteristics.run_count = 10;
+  characteristics.average_string_length = 20;
+
+  EXPECT_EQ(estimate_encoded_memory_usage(EncodingType::Unencoded, "int", characteristics), 400u);
+  EXPECT_EQ(estimate_encoded_memory_usage(EncodingType::Dictionary, "int", characteristics), 16u + 25u);
+  EXPECT_EQ(estimate_encoded_memory_usage(EncodingType::RunLength, "int", characteristics), 80u);
+  EXPECT_EQ(estimate_encoded_memory_usage(EncodingType::Unencoded, "string", characteristics), 2800u);
+  EXPECT_FALSE(estimate_encoded_memory_usage(EncodingType::FrameOfReference, "string", characteristics));
+}
+
+}  // namespace opossum
@@ -1,9 +1,11 @@
 #include <memory>
 #include <string>
+#include <vector>
 
 #include "../base_test.hpp"
 
 #include "storage/fixed_width_integer_vector.hpp"
+#include "storage/resolve_attribute_vector.hpp"
 
 namespace opossum {
 
@@ -22,4 +24,38 @@ TEST_F(FixedWidthIntegerVectorTest, SetOverwriteExisting) {
   EXPECT_EQ(vec.get(1), ValueID{3});
 }
 
+TEST_F(FixedWidthIntegerVectorTest, DecodeRange) {
+  auto vec = FixedWidthIntegerVector<uint16_t>{};
+  for (auto index = uint32_t{0}; index < 10; ++index) {
+    vec.set(index, ValueID{index * 1000});
+  }
+
+  const auto& abstract_vector = static_cast<const AbstractAttributeVector&>(vec);
+  auto decoded = std::vector<ValueID>(4);
+  abstract_vector.decode(3, 7, decoded.data());
+  EXPECT_EQ(decoded, std::vector<ValueID>({ValueID{3000}, ValueID{4000}, ValueID{5000}, ValueID{6000}}));
+
+  abstract_vector.decode(10, 10, decoded.data());
+  EXPECT_THROW(abstract_vector.decode(7, 3, decoded.data()), std::logic_error);
+  EXPECT_THROW(abstract_vector.decode(8, 11, decoded.data()), std::logic_error);
+}
+
+TEST_F(FixedWidthIntegerVectorTest, ResolveAttributeVector) {
+  auto vec = FixedWidthIntegerVector<uint32_t>{};
+  vec.set(0, ValueID{70000});
+  vec.set(1, ValueID{3});
+
+  auto sum = uint64_t{0};
+  resolve_attribute_vector(static_cast<const AbstractAttributeVector&>(vec), [&](const auto& typed_vector) {
+    using VectorType = std::decay_t<decltype(typed_vector)>;
+    EXPECT_TRUE((std::is_same_v<VectorType, FixedWidthIntegerVector<uint32_t>>));
+
+    for (auto index = size_t{0}; index < typed_vector.size(); ++index) {
+      sum += typed_vector.get(index);
+    }
+  });
+  EXPECT_EQ(sum, 70003u);
+  EXPECT_EQ(vec.values(), std::vector<uint32_t>({70000, 3}));
+}
+
 }  // namespace opossum
@@ -0,0 +1,128 @@
+#include <limits>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "base_test.hpp"
+
+#include "storage/bit_packed_integer_vector.hpp"
+#include "storage/frame_of_reference_segment.hpp"
+#include "storage/validity_bitmap.hpp"
+#include "storage/value_segment.hpp"
+
+namespace opossum {
+
+class StorageFrameOfReferenceSegmentTest : public BaseTest {
+ protected:
+  void SetUp() override {
+    // two full blocks and a partial one, values increase slowly like timestamps
+    for (auto index = int64_t{0}; index < 5000; ++index) {
+      value_segment_long->append(int64_t{1'600'000'000'000} + index * 3 + (index % 7));
+    }
+  }
+
+  std::shared_ptr<ValueSegment<int64_t>> value_segment_long = std::make_shared<ValueSegment<int64_t>>();
+};
+
+TEST_F(StorageFrameOfReferenceSegmentTest, CompressSegment) {
+  auto segment = FrameOfReferenceSegment<int64_t>{value_segment_long};
+
+  EXPECT_EQ(segment.size(), 5000u);
+  EXPECT_EQ(segment.block_minima().size(), 3u);
+  EXPECT_EQ(segment.block_minima()[1], int64_t{1'600'000'000'000} + 2048 * 3 + (2048 % 7));
+
+  // the largest offset within a block is below 2048 * 3 + 7, which requires 13 bits
+  EXPECT_EQ(segment.offsets()->bit_width(), 13u);
+  EXPECT_LT(segment.estimate_memory_usage(), value_segment_long->estimate_memory_usage() / 4);
+}
+
+TEST_F(StorageFrameOfReferenceSegmentTest, ValueAccess) {
+  auto segment = FrameOfReferenceSegment<int64_t>{value_segment_long};
+
+  const auto& values = value_segment_long->values();
+  for (auto chunk_offset = ChunkOffset{0}; chunk_offset < values.size(); ++chunk_offset) {
+    EXPECT_EQ(segment.get(chunk_offset), values[chunk_offset]);
+  }
+  EXPECT_EQ(segment[4999], AllTypeVariant{values[4999]});
+  EXPECT_THROW(segment.append(int64_t{4}), std::logic_error);
+}
+
+TEST_F(StorageFrameOfReferenceSegmentTest, NegativeAndExtremeValues) {
+  auto value_segment_int = std::make_shared<ValueSegment<int32_t>>();
+  value_segment_int->append(std::numeric_limits<int32_t>::max());
+  value_segment_int->append(-5);
+  value_segment_int->append(std::numeric_limits<int32_t>::min());
+
+  auto segment = FrameOfReferenceSegment<int32_t>{value_segment_int};
+  EXPECT_EQ(segment.offsets()->bit_width(), 32u);
+  EXPECT_EQ(segment.get(0), std::numeric_limits<int32_t>::max());
+  EXPECT_EQ(segment.get(1), -5);
+  EXPECT_EQ(segment.get(2), std::numeric_limits<int32_t>::min());
+
+  auto matches = PosList{};
+  segment.scan(ScanType::OpLessThan, 0, ChunkID{0}, matches);
+  EXPECT_EQ(matches, PosList({{ChunkID{0}, 1}, {ChunkID{0}, 2}}));
+}
+
+TEST_F(StorageFrameOfReferenceSegmentTest, RangeTooLarge) {
+  auto value_segment = std::make_shared<ValueSegment<int64_t>>();
+  value_segment->append(int64_t{0});
+  value_segment->append(int64_t{1} << 40);
+
+  EXPECT_THROW(FrameOfReferenceSegment<int64_t>{value_segment}, std::logic_error);
+}
+
+TEST_F(StorageFrameOfReferenceSegmentTest, Scan) {
+  auto segment = FrameOfReferenceSegment<int64_t>{value_segment_long};
+  const auto& values = value_segment_long->values();
+
+  // search values below, within and above the values of the segment
+  for (const auto search_value : {int64_t{0}, values[10], values[2048], values[3000] + 1, values[4999],
+                                  std::numeric_limits<int64_t>::max()}) {
+    for (const auto scan_type : {ScanType::OpEquals, ScanType::OpNotEquals, ScanType::OpLessThan,
+                                 ScanType::OpLessThanEquals, ScanType::OpGreaterThan, ScanType::OpGreaterThanEquals}) {
+      auto matches = PosList{};
+      segment.scan(scan_type, search_value, ChunkID{1}, matches);
+
+      auto expected_matches = PosList{};
+      for (auto chunk_offset = ChunkOffset{0}; chunk_offset < values.size(); ++chunk_offset) {
+        const auto value = values[chunk_offset];
+        const auto is_match = (scan_type == ScanType::OpEquals && value == search_value) ||
+                              (scan_type == ScanType::OpNotEquals && value != search_value) ||
+                              (scan_type == ScanType::OpLessThan && value < search_value) ||
+                              (scan_type == ScanType::OpLessThanEquals && value <= search_value) ||
+                              (scan_type == ScanType::OpGreaterThan && value > search_value) ||
+                              (scan_type == ScanType::OpGreaterThanEquals && value >= search_value);
+        if (is_match) {
+          expected_matches.push_back(RowID{ChunkID{1}, chunk_offset});
+        }
+      }
+      EXPECT_EQ(matches, expected_matches);
+    }
+  }
+}
+
+TEST_F(StorageFrameOfReferenceSegmentTest, ScanSkipsInvalidRows) {
+  auto segment = FrameOfReferenceSegment<int64_t>{value_segment_long};
+  const auto& values = value_segment_long->values();
+  auto validity = ValidityBitmap{value_segment_long->size()};
+  for (auto chunk_offset = ChunkOffset{100}; chunk_offset < 1200; ++chunk_offset) {
+    validity.invalidate(chunk_offset);
+  }
+  for (auto chunk_offset = ChunkOffset{1200}; chunk_offset < 5000; chunk_offset += 7) {
+    validity.invalidate(chunk_offset);
+  }
+
+  // a search value within the values of the segment and one that lets all blocks match entirely
+  for (const auto search_value : {values[3000], std::numeric_limits<int64_t>::max()}) {
+    auto matches = PosList{};
+    segment.scan(ScanType::OpLessThan, search_value, ChunkID{0}, matches, &validity);
+
+    auto expected_matches = PosList{};
+    segment.scan(ScanType::OpLessThan, search_value, ChunkID{0}, expected_matches);
+    validity.remove_invalid(expected_matches);
+    EXPECT_EQ(matches, expected_matches);
+  }
+}
+
+}  // namespace opossum
@@ -0,0 +1,89 @@
+#include <string>
+#include <vector>
+
+#include "base_test.hpp"
+
+#include "storage/front_coded_dictionary.hpp"
+#include "storage/string_heap.hpp"
+
+namespace opossum {
+
+class StorageFrontCodedDictionaryTest : public BaseTest {
+ protected:
+  void SetUp() override {
+    // more than two blocks of strings with long common prefixes
+    for (auto index = 0; index < 40; ++index) {
+      strings.push_back("https://www.example.com/products/" + std::to_string(1000 + 2 * index));
+    }
+    for (const auto& string : strings) {
+      dictionary.push_back(string);
+    }
+  }
+
+  std::vector<std::string> strings;
+  FrontCodedDictionary dictionary;
+};
+
+TEST_F(StorageFrontCodedDictionaryTest, AccessStrings) {
+  EXPECT_EQ(dictionary.size(), 40u);
+  EXPECT_FALSE(dictionary.empty());
+  for (auto index = size_t{0}; index < strings.size(); ++index) {
+    EXPECT_EQ(dictionary[index], strings[index]);
+  }
+  EXPECT_EQ(dictionary.front(), strings.front());
+  EXPECT_EQ(dictionary.back(), strings.back());
+  EXPECT_THROW(dictionary.at(40), std::logic_error);
+  EXPECT_TRUE(FrontCodedDictionary{}.empty());
+}
+
+TEST_F(StorageFrontCodedDictionaryTest, Bounds) {
+  for (auto index = size_t{0}; index < strings.size(); ++index) {
+    EXPECT_EQ(dictionary.lower_bound(strings[index]), index);
+    EXPECT_EQ(dictionary.upper_bound(strings[index]), index + 1);
+  }
+
+  // values in between two strings, e.g., at the border of two blocks
+  EXPECT_EQ(dictionary.lower_bound("https://www.example.com/products/1031"), 16u);
+  EXPECT_EQ(dictionary.upper_bound("https://www.example.com/products/1031"), 16u);
+
+  EXPECT_EQ(dictionary.lower_bound(""), 0u);
+  EXPECT_EQ(dictionary.upper_bound("a"), 0u);
+  EXPECT_EQ(dictionary.lower_bound("z"), 40u);
+  EXPECT_EQ(FrontCodedDictionary{}.lower_bound("a"), 0u);
+}
+
+TEST_F(StorageFrontCodedDictionaryTest, LongCommonPrefixes) {
+  auto long_dictionary = FrontCodedDictionary{};
+  const auto prefix = std::string(300, 'a');
+  long_dictionary.push_back(prefix);
+  long_dictionary.push_back(prefix + "b");
+  long_dictionary.push_back(prefix + "c");
+
+  EXPECT_EQ(long_dictionary[1], prefix + "b");
+  EXPECT_EQ(long_dictionary[2], prefix + "c");
+  EXPECT_EQ(long_dictionary.lower_bound(prefix + "c"), 2u);
+}
+
+TEST_F(StorageFrontCodedDictionaryTest, AppendAfterShrinkToFit) {
+  dictionary.shrink_to_fit();
+  const auto next_string = strings.back() + "/details";
+  dictionary.push_back(next_string);
+
+  EXPECT_EQ(dictionary.size(), 41u);
+  EXPECT_EQ(dictionary.back(), next_string);
+  EXPECT_EQ(dictionary.prefix_lengths()[40], strings.back().size());
+}
+
+TEST_F(StorageFrontCodedDictionaryTest, MemoryUsage) {
+  dictionary.shrink_to_fit();
+
+  auto heap = StringHeap{};
+  for (const auto& string : strings) {
+    heap.push_back(string);
+  }
+  heap.shrink_to_fit();
+
+  EXPECT_LT(dictionary.estimate_memory_usage(), heap.estimate_memory_usage() / 2);
+}
+
+}  // namespace opossum
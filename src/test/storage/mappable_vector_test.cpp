@@ -0,0 +1,47 @@
+#include <memory>
+#include <vector>
+
+#include "base_test.hpp"
+
+#include "storage/mappable_vector.hpp"
+
+namespace opossum {
+
+class StorageMappableVectorTest : public BaseTest {};
+
+TEST_F(StorageMappableVectorTest, OwnValues) {
+  auto values = MappableVector<int32_t>{std::vector<int32_t>{1, 2}};
+  values.push_back(3);
+  EXPECT_FALSE(values.is_mapped());
+  EXPECT_EQ(values, std::vector<int32_t>({1, 2, 3}));
+
+  // copies do not share their elements
+  auto copy = values;
+  copy.mutable_data()[0] = 7;
+  EXPECT_EQ(values.front(), 1);
+  EXPECT_EQ(copy.front(), 7);
+
+  const auto moved = std::move(copy);
+  EXPECT_EQ(moved, std::vector<int32_t>({7, 2, 3}));
+  EXPECT_THROW(moved.at(3), std::logic_error);
+}
+
+TEST_F(StorageMappableVectorTest, ReferenceExternalMemory) {
+  const auto memory = std::make_shared<std::vector<int32_t>>(std::vector<int32_t>{4, 5, 6});
+  auto values = MappableVector<int32_t>{memory->data(), memory->size(), memory};
+  EXPECT_TRUE(values.is_mapped());
+  EXPECT_EQ(values.data(), memory->data());
+  EXPECT_EQ(values.back(), 6);
+
+  // copies reference the same memory
+  const auto copy = values;
+  EXPECT_EQ(copy.data(), memory->data());
+
+  // modifications copy the elements first
+  values.push_back(7);
+  EXPECT_FALSE(values.is_mapped());
+  EXPECT_EQ(values, std::vector<int32_t>({4, 5, 6, 7}));
+  EXPECT_EQ(*memory, std::vector<int32_t>({4, 5, 6}));
+}
+
+}  // namespace opossum
@@ -0,0 +1,100 @@
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "base_test.hpp"
+
+#include "storage/run_length_segment.hpp"
+#include "storage/validity_bitmap.hpp"
+#include "storage/value_segment.hpp"
+
+namespace opossum {
+
+class StorageRunLengthSegmentTest : public BaseTest {
+ protected:
+  void SetUp() override {
+    for (const auto value : {3, 3, 3, 1, 1, 7, 3, 3}) {
+      value_segment_int->append(value);
+    }
+
+    value_segment_str->append("Bill");
+    value_segment_str->append("Bill");
+    value_segment_str->append("Steve");
+  }
+
+  std::shared_ptr<ValueSegment<int32_t>> value_segment_int = std::make_shared<ValueSegment<int32_t>>();
+  std::shared_ptr<ValueSegment<std::string>> value_segment_str = std::make_shared<ValueSegment<std::string>>();
+};
+
+TEST_F(StorageRunLengthSegmentTest, CompressSegment) {
+  auto segment = RunLengthSegment<int32_t>{value_segment_int};
+
+  EXPECT_EQ(segment.size(), 8u);
+  EXPECT_EQ(segment.run_count(), 4u);
+  EXPECT_EQ(segment.values(), std::vector<int32_t>({3, 1, 7, 3}));
+  EXPECT_EQ(segment.end_positions(), std::vector<ChunkOffset>({2, 4, 5, 7}));
+
+  auto str_segment = RunLengthSegment<std::string>{value_segment_str};
+  EXPECT_EQ(str_segment.size(), 3u);
+  EXPECT_EQ(str_segment.run_count(), 2u);
+}
+
+TEST_F(StorageRunLengthSegmentTest, ValueAccess) {
+  auto segment = RunLengthSegment<int32_t>{value_segment_int};
+
+  const auto& values = value_segment_int->values();
+  for (auto chunk_offset = ChunkOffset{0}; chunk_offset < values.size(); ++chunk_offset) {
+    EXPECT_EQ(segment.get(chunk_offset), values[chunk_offset]);
+    EXPECT_EQ(segment[chunk_offset], AllTypeVariant{values[chunk_offset]});
+  }
+
+  EXPECT_EQ(segment.run_index(0), 0u);
+  EXPECT_EQ(segment.run_index(3), 1u);
+  EXPECT_EQ(segment.run_index(5), 2u);
+  EXPECT_THROW(segment.get(8), std::logic_error);
+}
+
+TEST_F(StorageRunLengthSegmentTest, IsImmutable) {
+  auto segment = RunLengthSegment<int32_t>{value_segment_int};
+  EXPECT_THROW(segment.append(4), std::logic_error);
+}
+
+TEST_F(StorageRunLengthSegmentTest, EmptySegment) {
+  auto segment = RunLengthSegment<int32_t>{std::make_shared<ValueSegment<int32_t>>()};
+  EXPECT_EQ(segment.size(), 0u);
+  EXPECT_EQ(segment.run_count(), 0u);
+}
+
+TEST_F(StorageRunLengthSegmentTest, MemoryUsage) {
+  auto segment = RunLengthSegment<int32_t>{value_segment_int};
+  EXPECT_EQ(segment.estimate_memory_usage(), 4 * sizeof(int32_t) + 4 * sizeof(ChunkOffset));
+}
+
+TEST_F(StorageRunLengthSegmentTest, Scan) {
+  auto segment = RunLengthSegment<int32_t>{value_segment_int};
+
+  auto matches = PosList{};
+  segment.scan(ScanType::OpEquals, 3, ChunkID{2}, matches);
+  EXPECT_EQ(matches, PosList({{ChunkID{2}, 0}, {ChunkID{2}, 1}, {ChunkID{2}, 2}, {ChunkID{2}, 6}, {ChunkID{2}, 7}}));
+
+  matches.clear();
+  segment.scan(ScanType::OpLessThan, 3, ChunkID{0}, matches);
+  EXPECT_EQ(matches, PosList({{ChunkID{0}, 3}, {ChunkID{0}, 4}}));
+
+  matches.clear();
+  segment.scan(ScanType::OpGreaterThanEquals, 8, ChunkID{0}, matches);
+  EXPECT_TRUE(matches.empty());
+}
+
+TEST_F(StorageRunLengthSegmentTest, ScanSkipsInvalidRows) {
+  auto segment = RunLengthSegment<int32_t>{value_segment_int};
+  auto validity = ValidityBitmap{value_segment_int->size()};
+  validity.invalidate(1);
+  validity.invalidate(6);
+
+  auto matches = PosList{};
+  segment.scan(ScanType::OpEquals, 3, ChunkID{2}, matches, &validity);
+  EXPECT_EQ(matches, PosList({{ChunkID{2}, 0}, {ChunkID{2}, 2}, {ChunkID{2}, 7}}));
+}
+
+}  // namespace opossum
@@ -1,4 +1,7 @@
 #include <memory>
+#include <string>
+#include <thread>
+#include <vector>
 
 #include "base_test.hpp"
 #include "gtest/gtest.h"
@@ -60,6 +63,35 @@ TEST_F(StorageStorageManagerTest, TableNames) {
   EXPECT_EQ(manager_table_names, expected_tables);
 }
 
+TEST_F(StorageStorageManagerTest, ConcurrentAccess) {
+  auto& storage_manager = StorageManager::get();
+  const auto thread_count = 8;
+  const auto tables_per_thread = 100;
+
+  // writers add and drop tables while readers look up a table that is never modified
+  auto threads = std::vector<std::thread>{};
+  for (auto thread_id = 0; thread_id < thread_count; ++thread_id) {
+    threads.emplace_back([&, thread_id]() {
+      for (auto table_id = 0; table_id < tables_per_thread; ++table_id) {
+        const auto name = "table_" + std::to_string(thread_id) + "_" + std::to_string(table_id);
+        storage_manager.add_table(name, std::make_shared<Table>());
+        EXPECT_TRUE(storage_manager.has_table(name));
+        EXPECT_NE(storage_manager.get_table("first_table"), nullptr);
+        if (table_id % 2 == 0) {
+          storage_manager.drop_table(name);
+        }
+      }
+    });
+  }
+  for (auto& thread : threads) {
+    thread.join();
+  }
+
+  EXPECT_EQ(storage_manager.table_names().size(), 2 + thread_count * tables_per_thread / 2);
+  EXPECT_FALSE(storage_manager.has_table("table_0_0"));
+  EXPECT_TRUE(storage_manager.has_table("table_7_99"));
+}
+
 TEST_F(StorageStorageManagerTest, PrintTableInfo) {
   auto& storage_manager = StorageManager::get();
   auto stream = std::stringstream{};
@@ -0,0 +1,62 @@
+#include <algorithm>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "base_test.hpp"
+
+#include "storage/string_heap.hpp"
+
+namespace opossum {
+
+class StorageStringHeapTest : public BaseTest {
+ protected:
+  void SetUp() override {
+    heap.push_back("Alexander");
+    heap.push_back("");
+    heap.push_back("Bill");
+    heap.push_back("a string that is definitely too long for the small string optimization");
+  }
+
+  StringHeap heap;
+};
+
+TEST_F(StorageStringHeapTest, AccessStrings) {
+  EXPECT_EQ(heap.size(), 4u);
+  EXPECT_FALSE(heap.empty());
+  EXPECT_EQ(heap[0], "Alexander");
+  EXPECT_EQ(heap[1], "");
+  EXPECT_EQ(heap.at(2), "Bill");
+  EXPECT_EQ(heap.front(), "Alexander");
+  EXPECT_EQ(heap.back(), "a string that is definitely too long for the small string optimization");
+  EXPECT_THROW(heap.at(4), std::logic_error);
+
+  EXPECT_TRUE(StringHeap{}.empty());
+}
+
+TEST_F(StorageStringHeapTest, Iterators) {
+  const auto strings = std::vector<std::string_view>(heap.begin(), heap.end());
+  EXPECT_EQ(strings.size(), 4u);
+  EXPECT_EQ(strings[2], "Bill");
+  EXPECT_EQ(heap.end() - heap.begin(), 4);
+
+  auto sorted_heap = StringHeap{};
+  for (const auto value : {"Alexander", "Bill", "Hasso", "Steve"}) {
+    sorted_heap.push_back(value);
+  }
+  const auto lower_bound_it = std::lower_bound(sorted_heap.cbegin(), sorted_heap.cend(), std::string{"Carl"});
+  EXPECT_EQ(lower_bound_it - sorted_heap.cbegin(), 2);
+  EXPECT_EQ(*lower_bound_it, "Hasso");
+}
+
+TEST_F(StorageStringHeapTest, MemoryUsage) {
+  heap.shrink_to_fit();
+  const auto character_count = size_t{9 + 0 + 4 + 70};
+  EXPECT_EQ(heap.estimate_memory_usage(), character_count + 5 * sizeof(size_t));
+
+  // Compared to std::vector<std::string>, the heap needs neither a std::string object nor a separate allocation for
+  // long strings.
+  EXPECT_LT(heap.estimate_memory_usage(), 4 * sizeof(std::string) + 70);
+}
+
+}  // namespace opossum
@@ -0,0 +1,129 @@
+#include <algorithm>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "base_test.hpp"
+
+#include "storage/table.hpp"
+#include "storage/table_appender.hpp"
+#include "storage/value_segment.hpp"
+#include "type_cast.hpp"
+
+namespace opossum {
+
+class StorageTableAppenderTest : public BaseTest {
+ protected:
+  void SetUp() override {
+    table->add_column("a", "int");
+    table->add_column("b", "string");
+  }
+
+  std::shared_ptr<Table> table = std::make_shared<Table>(3);
+};
+
+TEST_F(StorageTableAppenderTest, PublishFullChunks) {
+  auto appender = TableAppender{table};
+  appender.append({1, "a"});
+  appender.append({2, "b"});
+  EXPECT_EQ(table->row_count(), 0u);
+
+  appender.append({3, "c"});
+  EXPECT_EQ(table->row_count(), 3u);
+  EXPECT_EQ((*table->get_chunk(ChunkID{0})->get_segment(ColumnID{1}))[2], AllTypeVariant{"c"});
+
+  // the published chunk is sealed, so appending to the table continues in a new chunk
+  table->append({4, "d"});
+  EXPECT_EQ(table->chunk_count(), 2u);
+  EXPECT_NE(table->get_chunk(ChunkID{0})->zone_map(ColumnID{0}), nullptr);
+
+  appender.append({5, "e"});
+  appender.flush();
+  EXPECT_EQ(table->row_count(), 5u);
+  EXPECT_EQ(table->chunk_count(), 4u);
+  EXPECT_EQ((*table->get_chunk(ChunkID{2})->get_segment(ColumnID{0}))[0], AllTypeVariant{5});
+}
+
+TEST_F(StorageTableAppenderTest, AppendBatch) {
+  {
+    auto appender = TableAppender{table};
+    appender.append({0, "x"});
+
+    auto names = StringHeap{};
+    for (const auto* name : {"a", "b", "c", "d", "e"}) {
+      names.push_back(name);
+    }
+    appender.append_batch({std::make_shared<ValueSegment<int32_t>>(std::vector<int32_t>{1, 2, 3, 4, 5}),
+                           std::make_shared<ValueSegment<std::string>>(std::move(names))});
+    EXPECT_EQ(table->row_count(), 6u);
+  }
+
+  // nothing is left to be published by the destructor
+  EXPECT_EQ(table->row_count(), 6u);
+  EXPECT_EQ((*table->get_chunk(ChunkID{1})->get_segment(ColumnID{1}))[2], AllTypeVariant{"e"});
+}
+
+TEST_F(StorageTableAppenderTest, AppendBatchAfterLoweredTarget) {
+  auto large_table = std::make_shared<Table>(100'000);
+  large_table->add_column("a", "int");
+  for (auto value = 0; value < 1'000; ++value) {
+    large_table->append({value});
+  }
+  auto appender = TableAppender{large_table};
+  for (auto value = 1'000; value < 6'000; ++value) {
+    appender.append({value});
+  }
+
+  // the chunk of the appender exceeds the lowered target, so it is published before the batch is appended
+  ASSERT_LT(large_table->tune_target_chunk_size(), 5'000u);
+  appender.append_batch({std::make_shared<ValueSegment<int32_t>>(std::vector<int32_t>{6'000, 6'001})});
+  EXPECT_EQ(large_table->row_count(), 6'000u);
+  appender.flush();
+  EXPECT_EQ(large_table->chunk_count(), 4u);
+  EXPECT_EQ(large_table->get_chunk(ChunkID{1})->size(), 5'000u);
+  EXPECT_EQ((*large_table->get_chunk(ChunkID{2})->get_segment(ColumnID{0}))[1], AllTypeVariant{6'001});
+}
+
+TEST_F(StorageTableAppenderTest, IgnoreFailureOnDestruction) {
+  {
+    auto appender = TableAppender{table};
+    appender.append({1, "a"});
+
+    // the chunk of the appender no longer matches the columns of the table
+    table->add_column("c", "int");
+    EXPECT_THROW(appender.flush(), std::logic_error);
+  }
+  EXPECT_EQ(table->row_count(), 0u);
+}
+
+TEST_F(StorageTableAppenderTest, ConcurrentWriters) {
+  constexpr auto writer_count = 8;
+  constexpr auto rows_per_writer = 1'000;
+
+  auto writers = std::vector<std::thread>{};
+  for (auto writer_id = 0; writer_id < writer_count; ++writer_id) {
+    writers.emplace_back([&, writer_id]() {
+      auto appender = TableAppender{table};
+      for (auto row = 0; row < rows_per_writer; ++row) {
+        appender.append({writer_id * rows_per_writer + row, std::to_string(writer_id)});
+      }
+    });
+  }
+  for (auto& writer : writers) {
+    writer.join();
+  }
+
+  EXPECT_EQ(table->row_count(), writer_count * rows_per_writer);
+
+  auto values = std::vector<bool>(writer_count * rows_per_writer);
+  for (auto chunk_id = ChunkID{0}; chunk_id < table->chunk_count(); ++chunk_id) {
+    const auto chunk = table->get_chunk(chunk_id);
+    for (auto chunk_offset = ChunkOffset{0}; chunk_offset < chunk->size(); ++chunk_offset) {
+      values[type_cast<int32_t>((*chunk->get_segment(ColumnID{0}))[chunk_offset])] = true;
+    }
+  }
+  EXPECT_EQ(std::count(values.cbegin(), values.cend(), true), writer_count * rows_per_writer);
+}
+
+}  // namespace opossum
@@ -1,6 +1,9 @@
+#include <algorithm>
 #include <limits>
 #include <memory>
+#include <sstream>
 #include <string>
+#include <thread>
 #include <utility>
 #include <vector>
 
@@ -8,8 +11,12 @@
 #include "gtest/gtest.h"
 
 #include "../lib/resolve_type.hpp"
+#include "../lib/statistics/table_statistics.hpp"
 #include "../lib/storage/dictionary_segment.hpp"
+#include "../lib/storage/frame_of_reference_segment.hpp"
+#include "../lib/storage/run_length_segment.hpp"
 #include "../lib/storage/table.hpp"
+#include "../lib/storage/validity_bitmap.hpp"
 #include "../lib/storage/value_segment.hpp"
 
 namespace opossum {
@@ -56,6 +63,22 @@ TEST_F(StorageTableTest, ConstGetChunk) {
   EXPECT_THROW(table.get_chunk(ChunkID{7}), std::exception);
 }
 
+TEST_F(StorageTableTest, ChunksSnapshot) {
+  table.append({4, "Hello,"});
+  table.append({6, "world"});
+  const auto snapshot = table.chunks();
+  const auto uncompressed_chunk = snapshot->front();
+
+  // neither appended nor replaced chunks are visible in an older snapshot
+  table.append({3, "!"});
+  table.compress_chunk(ChunkID{0});
+  EXPECT_EQ(snapshot->size(), 1u);
+  EXPECT_EQ(snapshot->front(), uncompressed_chunk);
+  EXPECT_EQ(table.chunks()->size(), 2u);
+  EXPECT_NE(table.chunks()->front(), uncompressed_chunk);
+  EXPECT_EQ(table.row_count(), 3u);
+}
+
 TEST_F(StorageTableTest, ColumnCount) { EXPECT_EQ(table.column_count(), 2u); }
 
 TEST_F(StorageTableTest, RowCount) {
@@ -99,4 +122,543 @@ TEST_F(StorageTableTest, CompressChunk) {
   EXPECT_NO_THROW(dynamic_cast<DictionarySegment<int32_t>&>(*table.get_chunk(ChunkID{0})->get_segment(ColumnID{0})));
 }
 
+TEST_F(StorageTableTest, CompressChunkWithEncodingType) {
+  table.append({4, "Hello,"});
+  table.append({6, "world"});
+  table.append({3, "!"});
+
+  table.compress_chunk(ChunkID{0}, EncodingType::RunLength);
+  const auto chunk = table.get_chunk(ChunkID{0});
+  EXPECT_NO_THROW(dynamic_cast<RunLengthSegment<int32_t>&>(*chunk->get_segment(ColumnID{0})));
+  EXPECT_NO_THROW(dynamic_cast<RunLengthSegment<std::string>&>(*chunk->get_segment(ColumnID{1})));
+  EXPECT_EQ((*chunk->get_segment(ColumnID{1}))[1], AllTypeVariant{"world"});
+
+  // frame-of-reference encoding is not available for string columns
+  EXPECT_THROW(table.compress_chunk(ChunkID{1}, EncodingType::FrameOfReference), std::logic_error);
+
+  table.compress_chunk(ChunkID{1}, EncodingType::Unencoded);
+  EXPECT_NO_THROW(dynamic_cast<ValueSegment<int32_t>&>(*table.get_chunk(ChunkID{1})->get_segment(ColumnID{0})));
+}
+
+TEST_F(StorageTableTest, CompressChunkWithFrameOfReference) {
+  auto int_table = Table{3};
+  int_table.add_column("a", "int");
+  int_table.add_column("b", "long");
+  int_table.append({1, int64_t{100}});
+  int_table.append({5, int64_t{90}});
+
+  int_table.compress_chunk(ChunkID{0}, EncodingType::FrameOfReference);
+  const auto chunk = int_table.get_chunk(ChunkID{0});
+  EXPECT_NO_THROW(dynamic_cast<FrameOfReferenceSegment<int64_t>&>(*chunk->get_segment(ColumnID{1})));
+  EXPECT_EQ((*chunk->get_segment(ColumnID{1}))[1], AllTypeVariant{int64_t{90}});
+}
+
+TEST_F(StorageTableTest, CompressChunkAutomatically) {
+  auto mixed_table = Table{2'000};
+  mixed_table.add_column("id", "int");
+  mixed_table.add_column("color", "string");
+  for (auto index = 0; index < 2'000; ++index) {
+    mixed_table.append({index, index < 1'000 ? "red" : "blue"});
+  }
+
+  auto encoding_log = std::stringstream{};
+  mixed_table.set_encoding_log(&encoding_log);
+  mixed_table.compress_chunk(ChunkID{0}, EncodingType::Automatic);
+
+  const auto chunk = mixed_table.get_chunk(ChunkID{0});
+  EXPECT_NO_THROW(dynamic_cast<FrameOfReferenceSegment<int32_t>&>(*chunk->get_segment(ColumnID{0})));
+  EXPECT_NO_THROW(dynamic_cast<RunLengthSegment<std::string>&>(*chunk->get_segment(ColumnID{1})));
+  EXPECT_EQ((*chunk->get_segment(ColumnID{1}))[1'500], AllTypeVariant{"blue"});
+
+  const auto log = encoding_log.str();
+  EXPECT_NE(log.find("Chunk 0, column id (int): FrameOfReference, "), std::string::npos);
+  EXPECT_NE(log.find("column color (string): RunLength"), std::string::npos);
+}
+
+TEST_F(StorageTableTest, AutoCompression) {
+  auto int_table = Table{100};
+  int_table.add_column("a", "int");
+  int_table.enable_auto_compression(EncodingType::Dictionary);
+  EXPECT_THROW(int_table.enable_auto_compression(), std::logic_error);
+
+  for (auto value = 0; value < 250; ++value) {
+    int_table.append({value % 10});
+  }
+  int_table.wait_for_auto_compression();
+
+  // the two full chunks are compressed, the last one is still being filled
+  const auto segment = [&](const auto chunk_id) { return int_table.get_chunk(chunk_id)->get_segment(ColumnID{0}); };
+  EXPECT_NO_THROW(dynamic_cast<DictionarySegment<int32_t>&>(*segment(ChunkID{0})));
+  EXPECT_NO_THROW(dynamic_cast<DictionarySegment<int32_t>&>(*segment(ChunkID{1})));
+  EXPECT_NO_THROW(dynamic_cast<ValueSegment<int32_t>&>(*segment(ChunkID{2})));
+  EXPECT_EQ(int_table.row_count(), 250u);
+  EXPECT_EQ((*segment(ChunkID{1}))[15], AllTypeVariant{5});
+
+  EXPECT_TRUE(int_table.get_chunk(ChunkID{1})->can_prune(ColumnID{0}, ScanType::OpGreaterThan, 9));
+  EXPECT_EQ(int_table.table_statistics()->row_count(), 200u);
+}
+
+TEST_F(StorageTableTest, AutoCompressionFailure) {
+  // frame-of-reference encoding is not available for string columns
+  EXPECT_THROW(table.enable_auto_compression(EncodingType::FrameOfReference), std::logic_error);
+
+  auto long_table = Table{2};
+  long_table.add_column("a", "long");
+  long_table.enable_auto_compression(EncodingType::FrameOfReference);
+  EXPECT_THROW(long_table.add_column("b", "string"), std::logic_error);
+
+  // the values of the first chunk exceed the range of frame-of-reference offsets, so it remains unencoded
+  for (const auto value : {int64_t{0}, int64_t{1} << 40, int64_t{1}, int64_t{2}, int64_t{3}}) {
+    long_table.append({value});
+  }
+  EXPECT_THROW(long_table.wait_for_auto_compression(), std::logic_error);
+  EXPECT_NO_THROW(long_table.wait_for_auto_compression());
+
+  const auto segment = [&](const auto chunk_id) { return long_table.get_chunk(chunk_id)->get_segment(ColumnID{0}); };
+  EXPECT_NO_THROW(dynamic_cast<ValueSegment<int64_t>&>(*segment(ChunkID{0})));
+  EXPECT_NO_THROW(dynamic_cast<FrameOfReferenceSegment<int64_t>&>(*segment(ChunkID{1})));
+  EXPECT_EQ(long_table.row_count(), 5u);
+
+  // the chunk that failed to compress is summarized and no longer waits for its compression, so it can be compacted
+  EXPECT_EQ(long_table.table_statistics()->row_count(), 4u);
+  EXPECT_TRUE(long_table.get_chunk(ChunkID{0})->zone_map(ColumnID{0}));
+  long_table.delete_rows({{ChunkID{0}, 1}});
+  EXPECT_EQ(long_table.compact(0.5f), 1u);
+  EXPECT_EQ(long_table.get_chunk(ChunkID{0})->size(), 1u);
+  EXPECT_EQ((*segment(ChunkID{0}))[0], AllTypeVariant{int64_t{0}});
+}
+
+TEST_F(StorageTableTest, CompressAllChunks) {
+  table.append({1, "a"});
+
+  auto int_table = Table{10};
+  int_table.add_column("a", "int");
+  int_table.add_column("b", "string");
+  for (auto value = 0; value < 95; ++value) {
+    int_table.append({value, std::to_string(value % 3)});
+  }
+  int_table.compress_chunk(ChunkID{3});
+
+  int_table.compress_all_chunks();
+
+  // the last chunk was sealed and compressed as well
+  ASSERT_EQ(int_table.chunk_count(), 11u);
+  for (auto chunk_id = ChunkID{0}; chunk_id < 10; ++chunk_id) {
+    const auto chunk = int_table.get_chunk(chunk_id);
+    EXPECT_NO_THROW(dynamic_cast<DictionarySegment<int32_t>&>(*chunk->get_segment(ColumnID{0})));
+    EXPECT_NO_THROW(dynamic_cast<DictionarySegment<std::string>&>(*chunk->get_segment(ColumnID{1})));
+  }
+  EXPECT_EQ(int_table.row_count(), 95u);
+  EXPECT_EQ((*int_table.get_chunk(ChunkID{9})->get_segment(ColumnID{0}))[4], AllTypeVariant{94});
+  EXPECT_EQ(int_table.table_statistics()->row_count(), 95u);
+
+  // already compressed chunks are skipped
+  EXPECT_NO_THROW(int_table.compress_all_chunks(EncodingType::FrameOfReference));
+  EXPECT_THROW(table.compress_all_chunks(EncodingType::FrameOfReference), std::logic_error);
+
+  // rows are appended to the chunk that compress_all_chunks() started
+  int_table.append({95, "2"});
+  EXPECT_EQ(int_table.get_chunk(ChunkID{10})->size(), 1u);
+}
+
+TEST_F(StorageTableTest, AppendBatch) {
+  table.append({1, "a"});
+
+  auto names = StringHeap{};
+  for (const auto* name : {"b", "c", "d", "e"}) {
+    names.push_back(name);
+  }
+  table.append_batch({std::make_shared<ValueSegment<int32_t>>(std::vector<int32_t>{2, 3, 4, 5}),
+                      std::make_shared<ValueSegment<std::string>>(std::move(names))});
+
+  // the batch fills the first chunk and is split across two more chunks
+  EXPECT_EQ(table.row_count(), 5u);
+  EXPECT_EQ(table.chunk_count(), 3u);
+  EXPECT_EQ((*table.get_chunk(ChunkID{0})->get_segment(ColumnID{1}))[1], AllTypeVariant{"b"});
+  EXPECT_EQ((*table.get_chunk(ChunkID{2})->get_segment(ColumnID{0}))[0], AllTypeVariant{5});
+
+  table.append_batch({std::make_shared<ValueSegment<int32_t>>(), std::make_shared<ValueSegment<std::string>>()});
+  EXPECT_EQ(table.row_count(), 5u);
+
+  EXPECT_THROW(table.append_batch({std::make_shared<ValueSegment<int32_t>>()}), std::logic_error);
+  EXPECT_THROW(table.append_batch({std::make_shared<ValueSegment<int32_t>>(std::vector<int32_t>{1}),
+                                   std::make_shared<ValueSegment<std::string>>()}),
+               std::logic_error);
+  EXPECT_THROW(
+      table.append_batch({std::make_shared<ValueSegment<int64_t>>(), std::make_shared<ValueSegment<std::string>>()}),
+      std::logic_error);
+}
+
+TEST_F(StorageTableTest, AppendWhileReading) {
+  auto large_table = Table{100'000};
+  large_table.add_column("col_1", "int");
+  large_table.add_column("col_2", "string");
+
+  // rows are read from the delta while it is appended to and replaced by copies with more capacity
+  auto appender = std::thread{[&] {
+    for (auto value = int32_t{0}; value < 5'000; ++value) {
+      large_table.append({value, std::to_string(value)});
+    }
+  }};
+
+  auto read_row_count = ChunkOffset{0};
+  while (read_row_count < 5'000) {
+    const auto delta = large_table.chunks()->back();
+    const auto row_count = delta->size();
+    EXPECT_GE(row_count, read_row_count);
+    const auto& values = static_cast<const ValueSegment<int32_t>&>(*delta->get_segment(ColumnID{0})).values();
+    const auto& strings = static_cast<const ValueSegment<std::string>&>(*delta->get_segment(ColumnID{1})).values();
+    for (auto chunk_offset = ChunkOffset{0}; chunk_offset < row_count; ++chunk_offset) {
+      ASSERT_EQ(values[chunk_offset], static_cast<int32_t>(chunk_offset));
+      ASSERT_EQ(strings[chunk_offset], std::to_string(chunk_offset));
+    }
+    read_row_count = row_count;
+  }
+  appender.join();
+  EXPECT_EQ(large_table.chunk_count(), 1u);
+  EXPECT_EQ(large_table.row_count(), 5'000u);
+}
+
+TEST_F(StorageTableTest, MergeDelta) {
+  auto merge_table = Table{6};
+  merge_table.add_column("col_1", "int");
+  merge_table.add_column("col_2", "string");
+  auto reference_table = Table{6};
+  reference_table.add_column("col_1", "int");
+  reference_table.add_column("col_2", "string");
+  const auto append = [&](const int32_t value) {
+    merge_table.append({value, "value " + std::to_string(value % 3)});
+    reference_table.append({value, "value " + std::to_string(value % 3)});
+  };
+
+  // the first delta becomes a dictionary-encoded chunk of its own
+  append(5);
+  append(3);
+  merge_table.merge_delta();
+  EXPECT_EQ(merge_table.chunk_count(), 2u);
+  EXPECT_TRUE(std::dynamic_pointer_cast<DictionarySegment<int32_t>>(
+      merge_table.get_chunk(ChunkID{0})->get_segment(ColumnID{0})));
+  EXPECT_EQ(merge_table.get_chunk(ChunkID{1})->size(), 0u);
+
+  // the next deltas are merged into it while it has room
+  append(4);
+  append(9);
+  merge_table.merge_delta();
+  append(1);
+  append(3);
+  merge_table.merge_delta();
+  EXPECT_EQ(merge_table.chunk_count(), 2u);
+  const auto merged_segment = std::dynamic_pointer_cast<DictionarySegment<int32_t>>(
+      merge_table.get_chunk(ChunkID{0})->get_segment(ColumnID{0}));
+  ASSERT_TRUE(merged_segment);
+  EXPECT_EQ(merged_segment->dictionary(), std::vector<int32_t>({1, 3, 4, 5, 9}));
+  EXPECT_EQ(merged_segment->size(), 6u);
+
+  // a full main chunk is not merged into
+  append(2);
+  merge_table.merge_delta();
+  EXPECT_EQ(merge_table.chunk_count(), 3u);
+  EXPECT_EQ(merge_table.row_count(), 7u);
+  EXPECT_EQ(merge_table.table_statistics()->row_count(), 7u);
+  EXPECT_TABLE_EQ(merge_table, reference_table, true);
+
+  // rows can still be appended
+  append(7);
+  EXPECT_TABLE_EQ(merge_table, reference_table, true);
+}
+
+TEST_F(StorageTableTest, BackgroundMerge) {
+  auto merge_table = Table{100};
+  merge_table.add_column("col_1", "int");
+  merge_table.enable_background_merge(10);
+  for (auto value = 0; value < 95; ++value) {
+    merge_table.append({value});
+  }
+  merge_table.wait_for_background_merge();
+
+  EXPECT_EQ(merge_table.row_count(), 95u);
+  EXPECT_TRUE(std::dynamic_pointer_cast<DictionarySegment<int32_t>>(
+      merge_table.get_chunk(ChunkID{0})->get_segment(ColumnID{0})));
+  auto value = 0;
+  for (auto chunk_id = ChunkID{0}; chunk_id < merge_table.chunk_count(); ++chunk_id) {
+    const auto& segment = *merge_table.get_chunk(chunk_id)->get_segment(ColumnID{0});
+    for (auto chunk_offset = ChunkOffset{0}; chunk_offset < segment.size(); ++chunk_offset) {
+      EXPECT_EQ(segment[chunk_offset], AllTypeVariant{value++});
+    }
+  }
+  EXPECT_EQ(value, 95);
+  EXPECT_LT(merge_table.get_chunk(static_cast<ChunkID>(merge_table.chunk_count() - 1))->size(), 10u);
+}
+
+TEST_F(StorageTableTest, DeleteRows) {
+  table.append({4, "Hello,"});
+  table.append({6, "world"});
+  table.append({3, "!"});
+
+  EXPECT_EQ(table.delete_rows({{ChunkID{0}, 1}, {ChunkID{1}, 0}, {ChunkID{0}, 1}}), 2u);
+  EXPECT_EQ(table.delete_rows({{ChunkID{1}, 0}}), 0u);
+  EXPECT_EQ(table.row_count(), 3u);
+  EXPECT_EQ(table.approx_valid_row_count(), 1u);
+  EXPECT_FALSE(table.get_chunk(ChunkID{0})->validity()->is_valid(1));
+  EXPECT_THROW(table.delete_rows({{ChunkID{1}, 1}}), std::logic_error);
+
+  // rows appended to a chunk with deleted rows are valid
+  table.append({5, "again"});
+  EXPECT_EQ(table.approx_valid_row_count(), 2u);
+  EXPECT_TRUE(table.get_chunk(ChunkID{1})->validity()->is_valid(1));
+
+  // compression keeps the deleted rows
+  table.compress_chunk(ChunkID{0});
+  EXPECT_EQ(table.get_chunk(ChunkID{0})->invalid_row_count(), 1u);
+}
+
+TEST_F(StorageTableTest, Compact) {
+  auto compact_table = Table{4};
+  compact_table.add_column("col_1", "int");
+  compact_table.add_column("col_2", "string");
+  for (auto value = 0; value < 14; ++value) {
+    compact_table.append({value, "value " + std::to_string(value)});
+  }
+  compact_table.compress_chunk(ChunkID{0}, EncodingType::RunLength);
+  compact_table.compress_chunk(ChunkID{1});
+
+  // chunk 0 loses half of its rows, chunk 1 one row, chunk 2 all rows, and the delta is never compacted
+  compact_table.delete_rows({{ChunkID{0}, 0}, {ChunkID{0}, 2}, {ChunkID{1}, 3}, {ChunkID{2}, 0}, {ChunkID{2}, 1},
+                             {ChunkID{2}, 2}, {ChunkID{2}, 3}, {ChunkID{3}, 0}, {ChunkID{3}, 1}});
+  EXPECT_EQ(compact_table.compact(0.5f), 6u);
+  EXPECT_EQ(compact_table.row_count(), 8u);
+  EXPECT_EQ(compact_table.approx_valid_row_count(), 5u);
+  EXPECT_EQ(compact_table.chunk_count(), 4u);
+
+  const auto chunk_0 = compact_table.get_chunk(ChunkID{0});
+  EXPECT_EQ(chunk_0->size(), 2u);
+  EXPECT_EQ(chunk_0->invalid_row_count(), 0u);
+  EXPECT_TRUE(std::dynamic_pointer_cast<RunLengthSegment<int32_t>>(chunk_0->get_segment(ColumnID{0})));
+  EXPECT_EQ((*chunk_0->get_segment(ColumnID{0}))[0], AllTypeVariant{1});
+  EXPECT_EQ((*chunk_0->get_segment(ColumnID{1}))[1], AllTypeVariant{"value 3"});
+  EXPECT_TRUE(chunk_0->zone_map(ColumnID{0}));
+
+  EXPECT_EQ(compact_table.get_chunk(ChunkID{1})->size(), 4u);
+  EXPECT_EQ(compact_table.get_chunk(ChunkID{2})->size(), 0u);
+  EXPECT_EQ(compact_table.get_chunk(ChunkID{3})->size(), 2u);
+
+  // compacting the remaining chunks removes their invalid rows as well
+  EXPECT_EQ(compact_table.compact(0.1f), 1u);
+  const auto chunk_1 = compact_table.get_chunk(ChunkID{1});
+  EXPECT_TRUE(std::dynamic_pointer_cast<DictionarySegment<int32_t>>(chunk_1->get_segment(ColumnID{0})));
+  EXPECT_EQ(chunk_1->size(), 3u);
+  EXPECT_EQ((*chunk_1->get_segment(ColumnID{0}))[2], AllTypeVariant{6});
+}
+
+TEST_F(StorageTableTest, CompactWhileCoalescing) {
+  for (auto round = 0; round < 20; ++round) {
+    auto reorganized_table = Table{10};
+    reorganized_table.add_column("a", "int");
+    auto value = 0;
+    for (auto chunk_index = 0; chunk_index < 30; ++chunk_index) {
+      auto chunk = std::make_shared<Chunk>();
+      chunk->add_segment(std::make_shared<ValueSegment<int32_t>>());
+      for (auto row = 0; row < 3; ++row, ++value) {
+        chunk->append({value});
+      }
+      reorganized_table.append_chunk(chunk);
+    }
+    reorganized_table.append({value++});
+    reorganized_table.append({value++});
+
+    // the first row of each small chunk is deleted
+    auto positions = PosList{};
+    for (auto chunk_id = ChunkID{0}; chunk_id < 30; ++chunk_id) {
+      positions.push_back({chunk_id, 0});
+    }
+    reorganized_table.delete_rows(positions);
+
+    // Chunks are rewritten by one and merged by the other, which shifts the ids of later chunks.
+    auto compaction = std::thread{[&]() { reorganized_table.compact(0.3f); }};
+    reorganized_table.coalesce_chunks(5);
+    compaction.join();
+
+    auto row_count = size_t{0};
+    auto valid_values = std::vector<int32_t>{};
+    for (const auto& chunk : *reorganized_table.chunks()) {
+      row_count += chunk->size();
+      const auto& segment = *chunk->get_segment(ColumnID{0});
+      const auto validity = chunk->validity();
+      for (auto chunk_offset = ChunkOffset{0}; chunk_offset < chunk->size(); ++chunk_offset) {
+        if (!validity || validity->is_valid(chunk_offset)) {
+          valid_values.push_back(type_cast<int32_t>(segment[chunk_offset]));
+        }
+      }
+    }
+    EXPECT_EQ(reorganized_table.row_count(), row_count);
+
+    auto expected_values = std::vector<int32_t>{};
+    for (auto expected_value = 0; expected_value < value; ++expected_value) {
+      if (expected_value % 3 != 0 || expected_value >= 90) {
+        expected_values.push_back(expected_value);
+      }
+    }
+    std::sort(valid_values.begin(), valid_values.end());
+    EXPECT_EQ(valid_values, expected_values);
+  }
+}
+
+TEST_F(StorageTableTest, CoalesceChunks) {
+  auto coalesce_table = Table{10};
+  coalesce_table.add_column("col_1", "int");
+  coalesce_table.add_column("col_2", "string");
+  auto reference_table = Table{10};
+  reference_table.add_column("col_1", "int");
+  reference_table.add_column("col_2", "string");
+
+  // chunks of 3 rows, as emitted per chunk by an operator, followed by a full and a run-length encoded chunk
+  auto value = 0;
+  const auto append_chunk = [&](const ChunkOffset row_count) {
+    auto chunk = std::make_shared<Chunk>();
+    chunk->add_segment(std::make_shared<ValueSegment<int32_t>>());
+    chunk->add_segment(std::make_shared<ValueSegment<std::string>>());
+    for (auto row = ChunkOffset{0}; row < row_count; ++row, ++value) {
+      chunk->append({value % 4, "value " + std::to_string(value)});
+      reference_table.append({value % 4, "value " + std::to_string(value)});
+    }
+    coalesce_table.append_chunk(chunk);
+  };
+  for (auto chunk_index = 0; chunk_index < 5; ++chunk_index) {
+    append_chunk(3);
+  }
+  append_chunk(10);
+  for (auto chunk_index = 0; chunk_index < 3; ++chunk_index) {
+    append_chunk(3);
+  }
+  for (auto chunk_id = ChunkID{0}; chunk_id < 4; ++chunk_id) {
+    coalesce_table.compress_chunk(chunk_id);
+  }
+  coalesce_table.compress_chunk(ChunkID{6}, EncodingType::RunLength);
+  coalesce_table.delete_rows({{ChunkID{1}, 2}});
+  EXPECT_EQ(coalesce_table.chunk_count(), 10u);
+
+  // Dictionary-encoded chunks 0 to 2 are merged up to the target chunk size, while chunk 3 cannot be merged with the
+  // unencoded chunk 4. Of the chunks after the full one, the unencoded chunks 7 and 8 are merged.
+  EXPECT_EQ(coalesce_table.coalesce_chunks(5), 3u);
+  EXPECT_EQ(coalesce_table.chunk_count(), 7u);
+  EXPECT_EQ(coalesce_table.row_count(), 34u);
+  EXPECT_EQ(coalesce_table.table_statistics()->row_count(), 34u);
+  EXPECT_TABLE_EQ(coalesce_table, reference_table, true);
+
+  const auto coalesced_chunk = coalesce_table.get_chunk(ChunkID{0});
+  EXPECT_EQ(coalesced_chunk->size(), 9u);
+  EXPECT_FALSE(coalesced_chunk->validity()->is_valid(5));
+  EXPECT_TRUE(coalesced_chunk->zone_map(ColumnID{0}));
+  const auto coalesced_segment =
+      std::dynamic_pointer_cast<DictionarySegment<std::string>>(coalesced_chunk->get_segment(ColumnID{1}));
+  ASSERT_TRUE(coalesced_segment);
+  EXPECT_EQ(coalesced_segment->unique_values_count(), 9u);
+  EXPECT_EQ(coalesce_table.get_chunk(ChunkID{1})->size(), 3u);
+  EXPECT_EQ(coalesce_table.get_chunk(ChunkID{3})->size(), 10u);
+  EXPECT_EQ(coalesce_table.get_chunk(ChunkID{5})->size(), 6u);
+
+  // the chunk sealed after coalescing is counted as well
+  coalesce_table.append({1, "last"});
+  reference_table.append({1, "last"});
+  coalesce_table.create_new_chunk();
+  EXPECT_EQ(coalesce_table.table_statistics()->row_count(), 35u);
+  EXPECT_TABLE_EQ(coalesce_table, reference_table, true);
+}
+
+TEST_F(StorageTableTest, CoalesceChunksConcurrently) {
+  for (auto round = 0; round < 20; ++round) {
+    auto coalesce_table = Table{10};
+    coalesce_table.add_column("a", "int");
+    auto value = 0;
+    for (auto chunk_index = 0; chunk_index < 30; ++chunk_index) {
+      auto chunk = std::make_shared<Chunk>();
+      chunk->add_segment(std::make_shared<ValueSegment<int32_t>>());
+      for (auto row = 0; row < 3; ++row, ++value) {
+        chunk->append({value});
+      }
+      coalesce_table.append_chunk(chunk);
+    }
+
+    // Both calls form the same runs, and each run is merged by only one of them, while the other finds it replaced.
+    auto removed_chunk_count = ChunkID{0};
+    auto coalescing = std::thread{[&]() { removed_chunk_count = coalesce_table.coalesce_chunks(5); }};
+    const auto other_removed_chunk_count = coalesce_table.coalesce_chunks(5);
+    coalescing.join();
+
+    EXPECT_EQ(removed_chunk_count + other_removed_chunk_count, 20u);
+    ASSERT_EQ(coalesce_table.chunk_count(), 11u);
+    EXPECT_EQ(coalesce_table.row_count(), 90u);
+    auto expected_value = 0;
+    for (const auto& chunk : *coalesce_table.chunks()) {
+      const auto& segment = *chunk->get_segment(ColumnID{0});
+      for (auto chunk_offset = ChunkOffset{0}; chunk_offset < chunk->size(); ++chunk_offset, ++expected_value) {
+        EXPECT_EQ(segment[chunk_offset], AllTypeVariant{expected_value});
+      }
+    }
+    EXPECT_EQ(expected_value, 90);
+  }
+}
+
+TEST_F(StorageTableTest, CoalesceChunksWithAutoCompression) {
+  auto coalesce_table = Table{10};
+  coalesce_table.add_column("a", "int");
+  coalesce_table.enable_auto_compression(EncodingType::Dictionary);
+
+  // the chunks are compressed before they are coalesced
+  auto value = 0;
+  const auto append_chunk = [&]() {
+    auto chunk = std::make_shared<Chunk>();
+    chunk->add_segment(std::make_shared<ValueSegment<int32_t>>());
+    for (auto row = 0; row < 3; ++row, ++value) {
+      chunk->append({value});
+    }
+    coalesce_table.append_chunk(chunk);
+  };
+  for (auto chunk_index = 0; chunk_index < 4; ++chunk_index) {
+    append_chunk();
+  }
+  EXPECT_EQ(coalesce_table.coalesce_chunks(5), 2u);
+
+  // Chunks that are sealed later are compressed and counted by the statistics once, although their ids shifted.
+  for (auto chunk_index = 0; chunk_index < 3; ++chunk_index) {
+    append_chunk();
+  }
+  coalesce_table.wait_for_auto_compression();
+  ASSERT_EQ(coalesce_table.chunk_count(), 6u);
+  for (auto chunk_id = ChunkID{0}; chunk_id < 5; ++chunk_id) {
+    EXPECT_NO_THROW(
+        dynamic_cast<DictionarySegment<int32_t>&>(*coalesce_table.get_chunk(chunk_id)->get_segment(ColumnID{0})));
+  }
+  EXPECT_EQ(coalesce_table.table_statistics()->row_count(), 21u);
+  EXPECT_EQ((*coalesce_table.get_chunk(ChunkID{4})->get_segment(ColumnID{0}))[2], AllTypeVariant{20});
+}
+
+TEST_F(StorageTableTest, RecommendTargetChunkSize) {
+  // the widest column fits into the cache
+  EXPECT_EQ(Table::recommend_target_chunk_size(0, 4, 1 << 20, 8), 262'144u);
+  EXPECT_EQ(Table::recommend_target_chunk_size(100'000'000, 8, 1 << 20, 8), 131'072u);
+
+  // the rows are split into four chunks per core
+  EXPECT_EQ(Table::recommend_target_chunk_size(1'000'000, 4, 1 << 20, 8), 31'232u);
+
+  // chunks do not become tiny
+  EXPECT_EQ(Table::recommend_target_chunk_size(1'000, 4, 1 << 20, 64), 4'096u);
+}
+
+TEST_F(StorageTableTest, TuneTargetChunkSize) {
+  for (auto value = 0; value < 100; ++value) {
+    table.append({value, "value"});
+  }
+  const auto target_chunk_size = table.tune_target_chunk_size();
+  EXPECT_EQ(table.target_chunk_size(), target_chunk_size);
+  EXPECT_EQ(target_chunk_size % 64, 0u);
+
+  // the last chunk is filled up to the new size
+  const auto chunk_count = table.chunk_count();
+  table.append({100, "value"});
+  table.append({101, "value"});
+  EXPECT_EQ(table.chunk_count(), chunk_count);
+  EXPECT_EQ(table.get_chunk(static_cast<ChunkID>(chunk_count - 1))->size(), 4u);
+}
+
 }  // namespace opossum
@@ -0,0 +1,89 @@
+#include <memory>
+#include <vector>
+
+#include "base_test.hpp"
+
+#include "storage/validity_bitmap.hpp"
+
+namespace opossum {
+
+class StorageValidityBitmapTest : public BaseTest {
+ protected:
+  std::vector<ChunkOffset> _valid_offsets(const ValidityBitmap& validity, const ChunkOffset begin_offset,
+                                          const ChunkOffset end_offset) {
+    auto valid_offsets = std::vector<ChunkOffset>{};
+    validity.for_each_valid(begin_offset, end_offset,
+                            [&](const ChunkOffset chunk_offset) { valid_offsets.push_back(chunk_offset); });
+    return valid_offsets;
+  }
+};
+
+TEST_F(StorageValidityBitmapTest, Invalidate) {
+  auto validity = ValidityBitmap{100};
+  EXPECT_EQ(validity.size(), 100u);
+  EXPECT_EQ(validity.invalid_count(), 0u);
+
+  EXPECT_TRUE(validity.invalidate(3));
+  EXPECT_TRUE(validity.invalidate(64));
+  EXPECT_FALSE(validity.invalidate(3));
+  EXPECT_EQ(validity.invalid_count(), 2u);
+  EXPECT_FALSE(validity.is_valid(3));
+  EXPECT_FALSE(validity.is_valid(64));
+  EXPECT_TRUE(validity.is_valid(4));
+
+  // rows beyond the bitmap are valid, but cannot be invalidated
+  EXPECT_TRUE(validity.is_valid(100));
+  EXPECT_THROW(validity.invalidate(100), std::logic_error);
+}
+
+TEST_F(StorageValidityBitmapTest, Extend) {
+  auto validity = ValidityBitmap{10};
+  validity.invalidate(9);
+
+  auto extended_validity = ValidityBitmap{validity, 200};
+  EXPECT_EQ(extended_validity.size(), 200u);
+  EXPECT_EQ(extended_validity.invalid_count(), 1u);
+  EXPECT_FALSE(extended_validity.is_valid(9));
+  EXPECT_TRUE(extended_validity.invalidate(150));
+  EXPECT_TRUE(validity.is_valid(150));
+  EXPECT_THROW((ValidityBitmap{validity, 5}), std::logic_error);
+}
+
+TEST_F(StorageValidityBitmapTest, ForEachValid) {
+  auto validity = ValidityBitmap{200};
+  // invalidate a whole word and single rows of others
+  for (auto chunk_offset = ChunkOffset{64}; chunk_offset < 128; ++chunk_offset) {
+    validity.invalidate(chunk_offset);
+  }
+  validity.invalidate(1);
+  validity.invalidate(130);
+  validity.invalidate(199);
+
+  auto expected_offsets = std::vector<ChunkOffset>{};
+  for (auto chunk_offset = ChunkOffset{0}; chunk_offset < 250; ++chunk_offset) {
+    if (validity.is_valid(chunk_offset)) {
+      expected_offsets.push_back(chunk_offset);
+    }
+  }
+  EXPECT_EQ(_valid_offsets(validity, 0, 250), expected_offsets);
+
+  // ranges that start and end within words
+  EXPECT_EQ(_valid_offsets(validity, 0, 3), std::vector<ChunkOffset>({0, 2}));
+  EXPECT_EQ(_valid_offsets(validity, 60, 131), std::vector<ChunkOffset>({60, 61, 62, 63, 128, 129}));
+  EXPECT_EQ(_valid_offsets(validity, 70, 120), std::vector<ChunkOffset>{});
+  EXPECT_EQ(_valid_offsets(validity, 198, 202), std::vector<ChunkOffset>({198, 200, 201}));
+  EXPECT_EQ(_valid_offsets(validity, 220, 222), std::vector<ChunkOffset>({220, 221}));
+}
+
+TEST_F(StorageValidityBitmapTest, RemoveInvalid) {
+  auto validity = ValidityBitmap{100};
+  validity.invalidate(2);
+  validity.invalidate(70);
+
+  auto matches = PosList{{ChunkID{0}, 5}, {ChunkID{1}, 1}, {ChunkID{1}, 2}, {ChunkID{1}, 3},
+                         {ChunkID{1}, 70}, {ChunkID{1}, 99}, {ChunkID{1}, 120}};
+  validity.remove_invalid(matches, 1);
+  EXPECT_EQ(matches, PosList({{ChunkID{0}, 5}, {ChunkID{1}, 1}, {ChunkID{1}, 3}, {ChunkID{1}, 99}, {ChunkID{1}, 120}}));
+}
+
+}  // namespace opossum
@@ -54,6 +54,34 @@ TEST_F(StorageValueSegmentTest, MemoryUsage) {
   EXPECT_EQ(int_value_segment.estimate_memory_usage(), size_t{8});
 }
 
+TEST_F(StorageValueSegmentTest, StringValues) {
+  string_value_segment.append("Hello");
+  string_value_segment.append("World");
+
+  EXPECT_EQ(string_value_segment.values()[1], "World");
+  EXPECT_EQ(string_value_segment[0], AllTypeVariant{"Hello"});
+}
+
+TEST_F(StorageValueSegmentTest, AppendValues) {
+  const auto source = ValueSegment<int32_t>{std::vector<int32_t>{1, 2, 3, 4}};
+  int_value_segment.append(0);
+  int_value_segment.append_values(source, 1, 3);
+  EXPECT_EQ(int_value_segment.values(), std::vector<int32_t>({0, 2, 3}));
+
+  auto strings = StringHeap{};
+  strings.push_back("a");
+  strings.push_back("bc");
+  strings.push_back("");
+  strings.push_back("def");
+  const auto string_source = ValueSegment<std::string>{std::move(strings)};
+  string_value_segment.append("x");
+  string_value_segment.append_values(string_source, 1, 4);
+  EXPECT_EQ(string_value_segment.size(), 4u);
+  EXPECT_EQ(string_value_segment.get(1), "bc");
+  EXPECT_EQ(string_value_segment.get(2), "");
+  EXPECT_EQ(string_value_segment.get(3), "def");
+}
+
 TEST_F(StorageValueSegmentTest, GetValues) {
   int_value_segment.append(1);
   int_value_segment.append(2);
@@ -0,0 +1,203 @@
+#include <sys/resource.h>
+
+#include <algorithm>
+#include <csignal>
+#include <filesystem>
+#include <fstream>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "base_test.hpp"
+
+#include "import_export/binary_writer.hpp"
+#include "storage/table.hpp"
+#include "storage/value_segment.hpp"
+#include "storage/write_ahead_log.hpp"
+
+namespace opossum {
+
+class StorageWriteAheadLogTest : public BaseTest {
+ protected:
+  void SetUp() override {
+    _directory = std::filesystem::temp_directory_path() / "opossum_write_ahead_log_test";
+    std::filesystem::remove_all(_directory);
+    std::filesystem::create_directories(_directory);
+    _log_file_name = (_directory / "table.wal").string();
+    _checkpoint_file_name = (_directory / "table.bin").string();
+
+    _reference_table = std::make_shared<Table>(3);
+    _reference_table->add_column("a", "int");
+    _reference_table->add_column("b", "string");
+  }
+
+  void TearDown() override { std::filesystem::remove_all(_directory); }
+
+  // Appends the same rows to the table and the reference table.
+  void _append(Table& table, const int first_value, const int row_count) {
+    for (auto value = first_value; value < first_value + row_count; ++value) {
+      table.append({value, "row " + std::to_string(value)});
+      _reference_table->append({value, "row " + std::to_string(value)});
+    }
+  }
+
+  std::shared_ptr<Table> _create_logged_table() {
+    auto table = std::make_shared<Table>(3);
+    table->enable_write_ahead_log(_log_file_name);
+    table->add_column("a", "int");
+    table->add_column("b", "string");
+    return table;
+  }
+
+  std::filesystem::path _directory;
+  std::string _log_file_name;
+  std::string _checkpoint_file_name;
+  std::shared_ptr<Table> _reference_table;
+};
+
+TEST_F(StorageWriteAheadLogTest, RecoverWithoutCheckpoint) {
+  auto table = _create_logged_table();
+  _append(*table, 0, 5);
+
+  auto batch_a = std::make_shared<ValueSegment<int32_t>>(std::vector<int32_t>{10, 11, 12, 13});
+  auto batch_b = std::make_shared<ValueSegment<std::string>>();
+  for (const auto* value : {"x", "y", "z", "w"}) {
+    batch_b->append(value);
+  }
+  table->append_batch({batch_a, batch_b});
+  _reference_table->append_batch({batch_a, batch_b});
+  table = nullptr;
+
+  const auto recovered_table = Table::recover(_checkpoint_file_name, _log_file_name);
+  EXPECT_EQ(recovered_table->target_chunk_size(), 3u);
+  EXPECT_EQ(recovered_table->column_names(), _reference_table->column_names());
+  EXPECT_TABLE_EQ(recovered_table, _reference_table, true);
+
+  // the recovered table continues to log
+  _append(*recovered_table, 20, 2);
+  EXPECT_TABLE_EQ(Table::recover(_checkpoint_file_name, _log_file_name), _reference_table, true);
+}
+
+TEST_F(StorageWriteAheadLogTest, RecoverOnTopOfCheckpoint) {
+  auto table = _create_logged_table();
+  _append(*table, 0, 7);
+  table->checkpoint(_checkpoint_file_name);
+  const auto log_size_after_checkpoint = std::filesystem::file_size(_log_file_name);
+  _append(*table, 7, 4);
+  EXPECT_GT(std::filesystem::file_size(_log_file_name), log_size_after_checkpoint);
+  table = nullptr;
+
+  EXPECT_TABLE_EQ(Table::recover(_checkpoint_file_name, _log_file_name), _reference_table, true);
+}
+
+TEST_F(StorageWriteAheadLogTest, SkipRowsOfCheckpoint) {
+  // A crash after the checkpoint was written, but before the log was truncated, leaves rows in both.
+  auto table = _create_logged_table();
+  _append(*table, 0, 5);
+  BinaryWriter::write(*table, _checkpoint_file_name);
+  _append(*table, 5, 3);
+  table = nullptr;
+
+  const auto recovered_table = Table::recover(_checkpoint_file_name, _log_file_name);
+  EXPECT_EQ(recovered_table->row_count(), 8u);
+  EXPECT_TABLE_EQ(recovered_table, _reference_table, true);
+}
+
+TEST_F(StorageWriteAheadLogTest, IgnoreIncompleteRecord) {
+  auto table = _create_logged_table();
+  _append(*table, 0, 4);
+  table = nullptr;
+
+  // simulate a crash while a record was written
+  {
+    auto log_file = std::ofstream{_log_file_name, std::ios::binary | std::ios::app};
+    log_file << '\x02' << "partial";
+  }
+
+  auto recovered_table = Table::recover(_checkpoint_file_name, _log_file_name);
+  EXPECT_TABLE_EQ(recovered_table, _reference_table, true);
+
+  // the incomplete record was removed, so new records are not lost behind it
+  _append(*recovered_table, 4, 2);
+  recovered_table = nullptr;
+  EXPECT_TABLE_EQ(Table::recover(_checkpoint_file_name, _log_file_name), _reference_table, true);
+}
+
+TEST_F(StorageWriteAheadLogTest, FailPermanentlyAfterWriteError) {
+  auto log = WriteAheadLog{_log_file_name, 3};
+  const auto durable_sequence_number = log.log_column(ColumnID{0}, "a", "int");
+  log.wait_until_durable(durable_sequence_number);
+
+  // Writes beyond the file size limit fail with EFBIG instead of raising SIGXFSZ, which is ignored.
+  auto previous_limit = rlimit{};
+  ASSERT_EQ(getrlimit(RLIMIT_FSIZE, &previous_limit), 0);
+  const auto previous_handler = std::signal(SIGXFSZ, SIG_IGN);
+  auto limit = previous_limit;
+  limit.rlim_cur = std::filesystem::file_size(_log_file_name);
+  ASSERT_EQ(setrlimit(RLIMIT_FSIZE, &limit), 0);
+  const auto failed_sequence_number = log.log_column(ColumnID{1}, "b", "string");
+  EXPECT_THROW(log.wait_until_durable(failed_sequence_number), std::logic_error);
+  ASSERT_EQ(setrlimit(RLIMIT_FSIZE, &previous_limit), 0);
+  std::signal(SIGXFSZ, previous_handler);
+
+  // Although writes succeed again, no later record is reported as durable.
+  const auto later_sequence_number = log.log_column(ColumnID{1}, "b", "string");
+  EXPECT_THROW(log.wait_until_durable(later_sequence_number), std::logic_error);
+  EXPECT_THROW(log.wait_until_durable(failed_sequence_number), std::logic_error);
+  EXPECT_THROW(log.truncate(), std::logic_error);
+  EXPECT_NO_THROW(log.wait_until_durable(durable_sequence_number));
+}
+
+TEST_F(StorageWriteAheadLogTest, KeepRowsAppliedAfterWriteError) {
+  auto table = _create_logged_table();
+  table->append({1, "row 1"});
+
+  auto previous_limit = rlimit{};
+  ASSERT_EQ(getrlimit(RLIMIT_FSIZE, &previous_limit), 0);
+  const auto previous_handler = std::signal(SIGXFSZ, SIG_IGN);
+  auto limit = previous_limit;
+  limit.rlim_cur = std::filesystem::file_size(_log_file_name);
+  ASSERT_EQ(setrlimit(RLIMIT_FSIZE, &limit), 0);
+  EXPECT_THROW(table->append({2, "row 2"}), std::logic_error);
+  ASSERT_EQ(setrlimit(RLIMIT_FSIZE, &previous_limit), 0);
+  std::signal(SIGXFSZ, previous_handler);
+
+  // The row that could not be logged is visible anyway, and the table does not accept logged changes anymore.
+  EXPECT_EQ(table->row_count(), 2);
+  EXPECT_EQ(table->get_chunk(ChunkID{0})->get_segment(ColumnID{0})->operator[](ChunkOffset{1}), AllTypeVariant{2});
+  EXPECT_THROW(table->append({3, "row 3"}), std::logic_error);
+  EXPECT_EQ(table->row_count(), 3);
+}
+
+TEST_F(StorageWriteAheadLogTest, ConcurrentAppends) {
+  auto table = _create_logged_table();
+  constexpr auto THREAD_COUNT = 8;
+  constexpr auto ROWS_PER_THREAD = 100;
+
+  auto threads = std::vector<std::thread>{};
+  for (auto thread_id = 0; thread_id < THREAD_COUNT; ++thread_id) {
+    threads.emplace_back([&, thread_id]() {
+      for (auto row_id = 0; row_id < ROWS_PER_THREAD; ++row_id) {
+        table->append({thread_id * ROWS_PER_THREAD + row_id, "row"});
+      }
+    });
+  }
+  for (auto& thread : threads) {
+    thread.join();
+  }
+  table = nullptr;
+
+  const auto recovered_table = Table::recover(_checkpoint_file_name, _log_file_name);
+  EXPECT_EQ(recovered_table->row_count(), THREAD_COUNT * ROWS_PER_THREAD);
+  auto seen_values = std::vector<bool>(THREAD_COUNT * ROWS_PER_THREAD);
+  for (auto chunk_id = ChunkID{0}; chunk_id < recovered_table->chunk_count(); ++chunk_id) {
+    const auto& segment = *recovered_table->get_chunk(chunk_id)->get_segment(ColumnID{0});
+    for (auto chunk_offset = ChunkOffset{0}; chunk_offset < segment.size(); ++chunk_offset) {
+      seen_values[type_cast<int32_t>(segment[chunk_offset])] = true;
+    }
+  }
+  EXPECT_EQ(std::count(seen_values.cbegin(), seen_values.cend(), false), 0);
+}
+
+}  // namespace opossum
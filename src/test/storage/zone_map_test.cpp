@@ -0,0 +1,108 @@
+#include <memory>
+#include <string>
+
+#include "base_test.hpp"
+
+#include "storage/dictionary_segment.hpp"
+#include "storage/frame_of_reference_segment.hpp"
+#include "storage/run_length_segment.hpp"
+#include "storage/table.hpp"
+#include "storage/value_segment.hpp"
+#include "storage/zone_map.hpp"
+
+namespace opossum {
+
+class StorageZoneMapTest : public BaseTest {
+ protected:
+  void SetUp() override {
+    for (const auto value : {20, 10, 10, 30, 15}) {
+      value_segment_int->append(value);
+    }
+    value_segment_str->append("Hasso");
+    value_segment_str->append("Alexander");
+    value_segment_str->append("Steve");
+  }
+
+  std::shared_ptr<ValueSegment<int32_t>> value_segment_int = std::make_shared<ValueSegment<int32_t>>();
+  std::shared_ptr<ValueSegment<std::string>> value_segment_str = std::make_shared<ValueSegment<std::string>>();
+};
+
+TEST_F(StorageZoneMapTest, CanPrune) {
+  const auto zone_map = ZoneMap<int32_t>{10, 30};
+
+  EXPECT_TRUE(zone_map.can_prune(ScanType::OpEquals, 5));
+  EXPECT_TRUE(zone_map.can_prune(ScanType::OpEquals, 31));
+  EXPECT_FALSE(zone_map.can_prune(ScanType::OpEquals, 12));
+  EXPECT_FALSE(zone_map.can_prune(ScanType::OpNotEquals, 10));
+  EXPECT_TRUE(zone_map.can_prune(ScanType::OpLessThan, 10));
+  EXPECT_FALSE(zone_map.can_prune(ScanType::OpLessThan, 11));
+  EXPECT_TRUE(zone_map.can_prune(ScanType::OpLessThanEquals, 9));
+  EXPECT_FALSE(zone_map.can_prune(ScanType::OpLessThanEquals, 10));
+  EXPECT_TRUE(zone_map.can_prune(ScanType::OpGreaterThan, 30));
+  EXPECT_FALSE(zone_map.can_prune(ScanType::OpGreaterThan, 29));
+  EXPECT_TRUE(zone_map.can_prune(ScanType::OpGreaterThanEquals, 31));
+  EXPECT_FALSE(zone_map.can_prune(ScanType::OpGreaterThanEquals, 30));
+
+  EXPECT_TRUE(ZoneMap<int32_t>(7, 7).can_prune(ScanType::OpNotEquals, 7));
+  EXPECT_TRUE(ZoneMap<std::string>("b", "d").can_prune(ScanType::OpGreaterThan, "e"));
+}
+
+TEST_F(StorageZoneMapTest, CreateForSegments) {
+  const auto value_zone_map = create_zone_map("int", value_segment_int);
+  EXPECT_EQ(value_zone_map->min(), AllTypeVariant{10});
+  EXPECT_EQ(value_zone_map->max(), AllTypeVariant{30});
+  EXPECT_FALSE(value_zone_map->distinct_count());
+
+  const auto dictionary_zone_map =
+      create_zone_map("string", std::make_shared<DictionarySegment<std::string>>(value_segment_str));
+  EXPECT_EQ(dictionary_zone_map->min(), AllTypeVariant{"Alexander"});
+  EXPECT_EQ(dictionary_zone_map->max(), AllTypeVariant{"Steve"});
+  EXPECT_EQ(dictionary_zone_map->distinct_count(), 3u);
+
+  const auto run_length_zone_map =
+      create_zone_map("int", std::make_shared<RunLengthSegment<int32_t>>(value_segment_int));
+  EXPECT_EQ(run_length_zone_map->min(), AllTypeVariant{10});
+  EXPECT_EQ(run_length_zone_map->max(), AllTypeVariant{30});
+
+  const auto frame_of_reference_zone_map =
+      create_zone_map("int", std::make_shared<FrameOfReferenceSegment<int32_t>>(value_segment_int));
+  EXPECT_EQ(frame_of_reference_zone_map->min(), AllTypeVariant{10});
+  EXPECT_EQ(frame_of_reference_zone_map->max(), AllTypeVariant{30});
+
+  EXPECT_EQ(create_zone_map("int", std::make_shared<ValueSegment<int32_t>>()), nullptr);
+}
+
+TEST_F(StorageZoneMapTest, CreateForFrameOfReferenceBlocks) {
+  // The extremes lie in different blocks, and the maximum is not the minimum of its block.
+  auto values = std::make_shared<ValueSegment<int64_t>>();
+  for (auto index = int64_t{0}; index < 5'000; ++index) {
+    values->append(index < 2'048 ? index : -index);
+  }
+
+  const auto zone_map = create_zone_map("long", std::make_shared<FrameOfReferenceSegment<int64_t>>(values));
+  EXPECT_EQ(zone_map->min(), AllTypeVariant{int64_t{-4'999}});
+  EXPECT_EQ(zone_map->max(), AllTypeVariant{int64_t{2'047}});
+}
+
+TEST_F(StorageZoneMapTest, CreateForSealedAndCompressedChunks) {
+  auto table = Table{2};
+  table.add_column("a", "int");
+  table.append({1});
+  table.append({2});
+  EXPECT_EQ(table.get_chunk(ChunkID{0})->zone_map(ColumnID{0}), nullptr);
+  EXPECT_FALSE(table.get_chunk(ChunkID{0})->can_prune(ColumnID{0}, ScanType::OpGreaterThan, 5));
+
+  // appending to a new chunk seals the first one
+  table.append({7});
+  EXPECT_TRUE(table.get_chunk(ChunkID{0})->can_prune(ColumnID{0}, ScanType::OpGreaterThan, 5));
+  EXPECT_FALSE(table.get_chunk(ChunkID{0})->can_prune(ColumnID{0}, ScanType::OpEquals, 2));
+  EXPECT_EQ(table.get_chunk(ChunkID{1})->zone_map(ColumnID{0}), nullptr);
+
+  table.compress_chunk(ChunkID{0});
+  const auto zone_map = table.get_chunk(ChunkID{0})->zone_map(ColumnID{0});
+  ASSERT_NE(zone_map, nullptr);
+  EXPECT_EQ(zone_map->max(), AllTypeVariant{2});
+  EXPECT_EQ(zone_map->distinct_count(), 2u);
+}
+
+}  // namespace opossum
@@ -0,0 +1,83 @@
+#include <filesystem>
+#include <fstream>
+#include <memory>
+#include <sstream>
+#include <string>
+
+#include "base_test.hpp"
+
+#include "storage/dictionary_segment.hpp"
+#include "storage/table.hpp"
+#include "storage/value_segment.hpp"
+#include "utils/load_table.hpp"
+
+namespace opossum {
+
+class UtilsLoadTableTest : public BaseTest {
+ protected:
+  void TearDown() override { std::filesystem::remove(_file_name); }
+
+  const std::string _file_name = (std::filesystem::temp_directory_path() / "load_table_test.tbl").string();
+};
+
+TEST_F(UtilsLoadTableTest, LoadTable) {
+  const auto table = load_table("src/test/tables/int_float.tbl", 2);
+  EXPECT_EQ(table->column_names(), std::vector<std::string>({"a", "b"}));
+  EXPECT_EQ(table->column_type(ColumnID{1}), "float");
+  EXPECT_EQ(table->row_count(), 3u);
+  EXPECT_EQ(table->get_chunk(ChunkID{0})->size(), 2u);
+  EXPECT_EQ((*table->get_chunk(ChunkID{0})->get_segment(ColumnID{0}))[1], AllTypeVariant{123});
+  EXPECT_EQ((*table->get_chunk(ChunkID{1})->get_segment(ColumnID{1}))[0], AllTypeVariant{457.7f});
+
+  EXPECT_THROW(load_table("src/test/tables/does_not_exist.tbl", 2), std::logic_error);
+}
+
+TEST_F(UtilsLoadTableTest, LoadLargeTableInParallel) {
+  // The file is large enough to be split into several ranges, whose boundaries do not coincide with chunk boundaries.
+  const auto row_count = 200'000;
+  {
+    auto file = std::ofstream{_file_name};
+    file << "id|name|value\r\nlong|string|double\r\n";
+    for (auto row_id = 0; row_id < row_count; ++row_id) {
+      file << row_id << "|name_" << row_id % 100 << "|" << row_id * 0.5 << "\n";
+    }
+  }
+
+  auto log = std::stringstream{};
+  const auto table = load_table(_file_name, 30'000, EncodingType::Dictionary, &log);
+  EXPECT_EQ(table->row_count(), row_count);
+  EXPECT_EQ(table->get_chunk(ChunkID{6})->size(), 20'000u);
+  EXPECT_EQ(log.str().find("Loaded 200000 rows"), 0u);
+
+  auto expected_row_id = int64_t{0};
+  for (auto chunk_id = ChunkID{0}; chunk_id < table->chunk_count(); ++chunk_id) {
+    const auto chunk = table->get_chunk(chunk_id);
+    if (chunk->size() == 0) {
+      continue;
+    }
+    const auto ids = std::dynamic_pointer_cast<DictionarySegment<int64_t>>(chunk->get_segment(ColumnID{0}));
+    ASSERT_TRUE(ids);
+    for (auto chunk_offset = ChunkOffset{0}; chunk_offset < chunk->size(); ++chunk_offset) {
+      ASSERT_EQ(ids->get(chunk_offset), expected_row_id++);
+    }
+    EXPECT_EQ((*chunk->get_segment(ColumnID{1}))[1], AllTypeVariant{"name_1"});
+    EXPECT_EQ((*chunk->get_segment(ColumnID{2}))[0], AllTypeVariant{chunk_id * 15'000.0});
+  }
+  EXPECT_EQ(expected_row_id, row_count);
+}
+
+TEST_F(UtilsLoadTableTest, MalformedRows) {
+  {
+    auto file = std::ofstream{_file_name};
+    file << "a|b\nint|int\n1|2\n3\n";
+  }
+  EXPECT_THROW(load_table(_file_name, 2), std::logic_error);
+
+  {
+    auto file = std::ofstream{_file_name};
+    file << "a|b\nint|int\n1|2\n3|four\n";
+  }
+  EXPECT_THROW(load_table(_file_name, 2), std::logic_error);
+}
+
+}  // namespace opossum
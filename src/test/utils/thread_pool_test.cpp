@@ -0,0 +1,78 @@
+#include <atomic>
+#include <chrono>
+#include <future>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+#include "base_test.hpp"
+
+#include "utils/thread_pool.hpp"
+
+namespace opossum {
+
+class UtilsThreadPoolTest : public BaseTest {};
+
+TEST_F(UtilsThreadPoolTest, ExecuteTasks) {
+  auto thread_pool = ThreadPool{4};
+  EXPECT_EQ(thread_pool.worker_count(), 4u);
+
+  auto results = std::vector<std::future<int>>{};
+  for (auto value = 0; value < 100; ++value) {
+    results.push_back(thread_pool.submit([value]() { return value * 2; }));
+  }
+  for (auto value = 0; value < 100; ++value) {
+    EXPECT_EQ(results[value].get(), value * 2);
+  }
+
+  EXPECT_GT(ThreadPool::get().worker_count(), 0u);
+}
+
+TEST_F(UtilsThreadPoolTest, PropagateExceptions) {
+  auto thread_pool = ThreadPool{2};
+  auto result = thread_pool.submit([]() { throw std::logic_error("failed"); });
+  thread_pool.wait(result);
+  EXPECT_THROW(result.get(), std::logic_error);
+}
+
+TEST_F(UtilsThreadPoolTest, NestedTasksDoNotExhaustWorkers) {
+  // Each outer task waits for inner tasks. With a single worker, this only finishes if waiting threads execute
+  // pending tasks.
+  auto thread_pool = ThreadPool{1};
+  auto counter = std::atomic<int>{0};
+
+  auto outer_tasks = std::vector<std::future<void>>{};
+  for (auto outer_index = 0; outer_index < 4; ++outer_index) {
+    outer_tasks.push_back(thread_pool.submit([&]() {
+      auto inner_tasks = std::vector<std::future<void>>{};
+      for (auto inner_index = 0; inner_index < 8; ++inner_index) {
+        inner_tasks.push_back(thread_pool.submit([&]() { ++counter; }));
+      }
+      for (const auto& inner_task : inner_tasks) {
+        thread_pool.wait(inner_task);
+      }
+    }));
+  }
+
+  for (const auto& outer_task : outer_tasks) {
+    thread_pool.wait(outer_task);
+  }
+  EXPECT_EQ(counter, 32);
+}
+
+TEST_F(UtilsThreadPoolTest, WaitForTasksSubmittedLater) {
+  // The blocking task occupies a thread until a task submitted later releases it. The other thread either sleeps in
+  // wait() or is the worker, and must pick up the later task.
+  auto thread_pool = ThreadPool{1};
+  auto release = std::promise<void>{};
+  auto blocking_task = thread_pool.submit([released = release.get_future()]() { released.wait(); });
+  auto submitter = std::thread{[&]() {
+    std::this_thread::sleep_for(std::chrono::milliseconds{20});
+    thread_pool.submit([&]() { release.set_value(); });
+  }};
+  thread_pool.wait(blocking_task);
+  submitter.join();
+  EXPECT_NO_THROW(blocking_task.get());
+}
+
+}  // namespace opossum